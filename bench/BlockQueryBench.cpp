@@ -0,0 +1,290 @@
+// Microbenchmark of ChunkManager block queries against a loaded world.
+//
+// Usage: block_query_bench [--render-distance N] [--queries N] [--runs N]
+//
+// Replays the query patterns the client issues every frame (scattered
+// lookups, raycasts stepping through the world, player collision boxes)
+// through three paths and reports queries per second, best of --runs:
+//   locked-heap  the previous getBlockAt: mutex + hash lookup + new Block
+//   getBlockAt   value-returning, lock-free, last-chunk cache
+//   region       getBlocksInRegion over the same boxes (collision only)
+// Every path counts the solid blocks it saw; the counts must match.
+
+#include "ChunkManager.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct BenchOptions {
+        int renderDistance = 6;
+        int queries = 2000000;
+        int runs = 3;
+    };
+
+    struct Query {
+        int x, y, z;
+    };
+
+    struct Box {
+        int minX, minY, minZ, maxX, maxY, maxZ;
+    };
+
+    long long makeKey(int x, int z) {
+        return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+    }
+
+    // The lookup getBlockAt used to do, kept here as the baseline
+    class LockedHeapLookup {
+    public:
+        explicit LockedHeapLookup(const std::vector<Chunk*>& loaded) {
+            for (Chunk* chunk : loaded) chunks[makeKey(chunk->chunkX, chunk->chunkZ)] = chunk;
+        }
+
+        Block* getBlockAt(int worldX, int worldY, int worldZ) {
+            int cx = worldX / CHUNK_SIZE_X;
+            if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) cx--;
+            int cz = worldZ / CHUNK_SIZE_Z;
+            if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) cz--;
+
+            int lx = worldX - cx * CHUNK_SIZE_X;
+            int lz = worldZ - cz * CHUNK_SIZE_Z;
+
+            std::lock_guard<std::mutex> lock(chunksMutex);
+            auto it = chunks.find(makeKey(cx, cz));
+            if (it == chunks.end()) return nullptr;
+
+            return new Block(it->second->getBlock(lx, worldY, lz));
+        }
+
+    private:
+        std::unordered_map<long long, Chunk*> chunks;
+        std::mutex chunksMutex;
+    };
+
+    struct PathResult {
+        const char* name;
+        size_t queries = 0;
+        size_t solid = 0;
+        double bestSeconds = 0.0;
+
+        double queriesPerSecond() const { return bestSeconds > 0.0 ? queries / bestSeconds : 0.0; }
+    };
+
+    template <typename Fn>
+    void measure(PathResult& result, int runs, size_t queries, Fn&& fn) {
+        for (int run = 0; run < runs; run++) {
+            auto start = std::chrono::steady_clock::now();
+            size_t solid = fn();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (result.queries == 0 || seconds < result.bestSeconds) result.bestSeconds = seconds;
+            result.queries = queries;
+            result.solid = solid;
+        }
+    }
+
+    bool parseArguments(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--render-distance" && hasValue) options.renderDistance = std::atoi(argv[++i]);
+            else if (arg == "--queries" && hasValue) options.queries = std::atoi(argv[++i]);
+            else if (arg == "--runs" && hasValue) options.runs = std::atoi(argv[++i]);
+            else return false;
+        }
+        return options.renderDistance >= 2 && options.queries >= 1000 && options.runs >= 1;
+    }
+
+    // Drives update() at the origin until every requested chunk is in
+    bool loadWorld(ChunkManager& chunkManager) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+        size_t lastLoaded = 0;
+        int stableFrames = 0;
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            chunkManager.update(0.0f, 0.0f);
+            std::vector<ChunkMeshUpdate> discarded;
+            chunkManager.takeMeshUpdates(discarded);
+
+            const GenerationStats& stats = chunkManager.getGenerationStats();
+            size_t loaded = chunkManager.getLoadedChunks().size();
+            bool settled = loaded > 0 && loaded == lastLoaded && stats.completed + stats.cancelled >= stats.requested;
+            stableFrames = settled ? stableFrames + 1 : 0;
+            if (stableFrames >= 10) return true;
+
+            lastLoaded = loaded;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: block_query_bench [--render-distance N] [--queries N] [--runs N]\n";
+        return 1;
+    }
+
+    ChunkManager chunkManager(options.renderDistance, "block_query_bench");
+    if (!loadWorld(chunkManager)) {
+        std::cerr << "World did not finish loading\n";
+        return 1;
+    }
+
+    std::vector<Chunk*> loaded = chunkManager.getLoadedChunks();
+    LockedHeapLookup lockedHeap(loaded);
+
+    // Stay inside the render distance so nearly every query hits a chunk
+    const int extent = (options.renderDistance - 1) * CHUNK_SIZE_X;
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<int> horizontal(-extent, extent - 1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // Scattered: independent points anywhere in the loaded area
+    std::vector<Query> scattered(options.queries);
+    for (Query& query : scattered) {
+        query = { horizontal(random), static_cast<int>(random() % CHUNK_SIZE_Y), horizontal(random) };
+    }
+
+    // Raycasts: 100 steps of 0.1 blocks, like BlockOutline and BlockInteraction
+    std::vector<Query> rays;
+    rays.reserve(options.queries);
+    while (static_cast<int>(rays.size()) + 100 <= options.queries) {
+        float x = static_cast<float>(horizontal(random));
+        float y = 60.0f + 40.0f * (unit(random) + 1.0f);
+        float z = static_cast<float>(horizontal(random));
+        float dx = unit(random), dy = unit(random), dz = unit(random);
+        float length = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), 0.001f);
+        for (int step = 0; step < 100; step++) {
+            float t = step * 0.1f / length;
+            rays.push_back({ static_cast<int>(std::round(x + dx * t)), static_cast<int>(std::floor(y + dy * t)),
+                static_cast<int>(std::round(z + dz * t)) });
+        }
+    }
+
+    // Collision: the player's 2x2x2..2x3x2 block box near the ground
+    std::vector<Box> boxes(options.queries / 12);
+    for (Box& box : boxes) {
+        int x = horizontal(random);
+        int y = 60 + static_cast<int>(random() % 60);
+        int z = horizontal(random);
+        box = { x, y, z, x + 1, y + 1 + static_cast<int>(random() % 2), z + 1 };
+    }
+    size_t boxBlocks = 0;
+    for (const Box& box : boxes) {
+        boxBlocks += static_cast<size_t>(box.maxX - box.minX + 1) * (box.maxY - box.minY + 1) * (box.maxZ - box.minZ + 1);
+    }
+
+    auto runLockedHeap = [&](const std::vector<Query>& queries) {
+        size_t solid = 0;
+        for (const Query& query : queries) {
+            Block* block = lockedHeap.getBlockAt(query.x, query.y, query.z);
+            if (block) {
+                if (!block->isAir()) solid++;
+                delete block;
+            }
+        }
+        return solid;
+    };
+
+    auto runValue = [&](const std::vector<Query>& queries) {
+        size_t solid = 0;
+        for (const Query& query : queries) {
+            std::optional<Block> block = chunkManager.getBlockAt(query.x, query.y, query.z);
+            if (block && !block->isAir()) solid++;
+        }
+        return solid;
+    };
+
+    auto runBoxesLockedHeap = [&]() {
+        size_t solid = 0;
+        for (const Box& box : boxes) {
+            for (int x = box.minX; x <= box.maxX; x++)
+                for (int y = box.minY; y <= box.maxY; y++)
+                    for (int z = box.minZ; z <= box.maxZ; z++) {
+                        Block* block = lockedHeap.getBlockAt(x, y, z);
+                        if (block) {
+                            if (!block->isAir()) solid++;
+                            delete block;
+                        }
+                    }
+        }
+        return solid;
+    };
+
+    auto runBoxesValue = [&]() {
+        size_t solid = 0;
+        for (const Box& box : boxes) {
+            for (int x = box.minX; x <= box.maxX; x++)
+                for (int y = box.minY; y <= box.maxY; y++)
+                    for (int z = box.minZ; z <= box.maxZ; z++) {
+                        std::optional<Block> block = chunkManager.getBlockAt(x, y, z);
+                        if (block && !block->isAir()) solid++;
+                    }
+        }
+        return solid;
+    };
+
+    BlockRegion region;
+    auto runBoxesRegion = [&]() {
+        size_t solid = 0;
+        for (const Box& box : boxes) {
+            chunkManager.getBlocksInRegion(box.minX, box.minY, box.minZ, box.maxX, box.maxY, box.maxZ, region);
+            for (const Block& block : region.blocks) {
+                if (!block.isAir()) solid++;
+            }
+        }
+        return solid;
+    };
+
+    struct Workload {
+        const char* name;
+        std::vector<PathResult> paths;
+    };
+    std::vector<Workload> workloads;
+
+    workloads.push_back({ "scattered", { { "locked-heap" }, { "getBlockAt" } } });
+    measure(workloads.back().paths[0], options.runs, scattered.size(), [&] { return runLockedHeap(scattered); });
+    measure(workloads.back().paths[1], options.runs, scattered.size(), [&] { return runValue(scattered); });
+
+    workloads.push_back({ "raycast", { { "locked-heap" }, { "getBlockAt" } } });
+    measure(workloads.back().paths[0], options.runs, rays.size(), [&] { return runLockedHeap(rays); });
+    measure(workloads.back().paths[1], options.runs, rays.size(), [&] { return runValue(rays); });
+
+    workloads.push_back({ "collision", { { "locked-heap" }, { "getBlockAt" }, { "region" } } });
+    measure(workloads.back().paths[0], options.runs, boxBlocks, runBoxesLockedHeap);
+    measure(workloads.back().paths[1], options.runs, boxBlocks, runBoxesValue);
+    measure(workloads.back().paths[2], options.runs, boxBlocks, runBoxesRegion);
+
+    std::cout << "block_query_bench: render distance " << options.renderDistance << " ("
+        << loaded.size() << " chunks), best of " << options.runs << " runs\n";
+
+    bool consistent = true;
+    for (const Workload& workload : workloads) {
+        double baseline = workload.paths[0].queriesPerSecond();
+        for (const PathResult& path : workload.paths) {
+            std::cout << "  " << std::left << std::setw(10) << workload.name << std::setw(12) << path.name << std::right
+                << std::setw(9) << path.queries << " queries "
+                << std::fixed << std::setprecision(1) << std::setw(8) << path.queriesPerSecond() / 1e6 << " M/s"
+                << std::setprecision(2) << std::setw(7) << (baseline > 0.0 ? path.queriesPerSecond() / baseline : 0.0) << "x\n";
+            if (path.solid != workload.paths[0].solid) consistent = false;
+        }
+    }
+
+    if (!consistent) {
+        std::cerr << "Query paths disagree on the number of solid blocks\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,246 @@
+// Entity physics throughput against a loaded world.
+//
+// Usage: entity_bench [--render-distance N] [--entities N] [--ticks N]
+//
+// Spawns --entities wandering entities on the terrain surface and runs
+// EntityPhysics at the client's 60 Hz tick. Each tick entities steer
+// randomly and jump when they walk into a wall, and 1% of them are
+// destroyed and respawned so index reuse and the dense arrays' swap
+// removal are part of the measurement. Meanwhile the viewer walks out
+// past the render distance and back, so EntityStorage stores the
+// entities of chunks that unload and restores them as they reload.
+// Reports time per tick, entity updates per second and storage traffic.
+
+#include "ChunkManager.h"
+#include "Entity/EntityPhysics.h"
+#include "Entity/EntityStorage.h"
+#include "Entity/EntityWorld.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct BenchOptions {
+        int renderDistance = 6;
+        int entities = 10000;
+        int ticks = 600;
+    };
+
+    const char* WORLD_NAME = "entity_bench";
+    const float TICK_SECONDS = 1.0f / 60.0f;
+    const float WANDER_SPEED = 4.3f;
+    const float JUMP_STRENGTH = 8.5f;
+
+    bool parseArguments(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--render-distance" && hasValue) options.renderDistance = std::atoi(argv[++i]);
+            else if (arg == "--entities" && hasValue) options.entities = std::atoi(argv[++i]);
+            else if (arg == "--ticks" && hasValue) options.ticks = std::atoi(argv[++i]);
+            else return false;
+        }
+        return options.renderDistance >= 2 && options.entities >= 1 && options.ticks >= 1;
+    }
+
+    // Drives update() at the origin until every requested chunk is in
+    bool loadWorld(ChunkManager& chunkManager) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+        size_t lastLoaded = 0;
+        int stableFrames = 0;
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            chunkManager.update(0.0f, 0.0f);
+            std::vector<ChunkMeshUpdate> discarded;
+            chunkManager.takeMeshUpdates(discarded);
+
+            const GenerationStats& stats = chunkManager.getGenerationStats();
+            size_t loaded = chunkManager.getLoadedChunks().size();
+            bool settled = loaded > 0 && loaded == lastLoaded && stats.completed + stats.cancelled >= stats.requested;
+            stableFrames = settled ? stableFrames + 1 : 0;
+            if (stableFrames >= 10) return true;
+
+            lastLoaded = loaded;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    // Render-space y of the first air block above the highest solid one
+    float surfaceHeight(const ChunkManager& chunkManager, int worldX, int worldZ) {
+        for (int y = CHUNK_SIZE_Y - 1; y >= 0; y--) {
+            std::optional<Block> block = chunkManager.getBlockAt(worldX, y, worldZ);
+            if (block && block->isSolid()) return static_cast<float>(y + 1);
+        }
+        return static_cast<float>(CHUNK_SIZE_Y);
+    }
+
+    int floorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    class Spawner {
+    public:
+        Spawner(const ChunkManager& chunkManager, int extent)
+            : chunkManager(chunkManager), horizontal(-extent, extent - 1), heading(0.0f, 6.2831853f) {}
+
+        // Somewhere in a loaded chunk, so respawns don't go straight to storage
+        EntityHandle spawn(EntityWorld& world) {
+            int worldX, worldZ;
+            do {
+                worldX = horizontal(random);
+                worldZ = horizontal(random);
+            } while (!chunkManager.isChunkLoaded(floorDiv(worldX, CHUNK_SIZE_X), floorDiv(worldZ, CHUNK_SIZE_Z)));
+            float angle = heading(random);
+
+            EntityHandle entity = world.create();
+            Transform transform;
+            transform.x = transform.previousX = static_cast<float>(worldX);
+            transform.y = transform.previousY = surfaceHeight(chunkManager, worldX, worldZ);
+            transform.z = transform.previousZ = -static_cast<float>(worldZ);
+            world.transforms.add(entity.index, transform);
+            world.velocities.add(entity.index, { std::cos(angle) * WANDER_SPEED, 0.0f, std::sin(angle) * WANDER_SPEED });
+            world.bodies.add(entity.index, PhysicsBody());
+            world.spatial.update(entity.index, transform.x, transform.y, transform.z);
+            return entity;
+        }
+
+        std::mt19937 random{ 12345 };
+
+    private:
+        const ChunkManager& chunkManager;
+        std::uniform_int_distribution<int> horizontal;
+        std::uniform_real_distribution<float> heading;
+    };
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: entity_bench [--render-distance N] [--entities N] [--ticks N]\n";
+        return 1;
+    }
+
+    // The previous run's stored entities would be restored into this one
+    std::filesystem::remove_all(std::string("SavedData/") + WORLD_NAME);
+
+    int exitCode = 0;
+    {
+        ChunkManager chunkManager(options.renderDistance, WORLD_NAME);
+        if (!loadWorld(chunkManager)) {
+            std::cerr << "World did not finish loading\n";
+            return 1;
+        }
+
+        EntityWorld world;
+        EntityPhysics physics;
+        EntityStorage storage(WORLD_NAME);
+        Spawner spawner(chunkManager, (options.renderDistance - 1) * CHUNK_SIZE_X);
+
+        for (int i = 0; i < options.entities; i++) spawner.spawn(world);
+
+        std::uniform_real_distribution<float> steer(-0.3f, 0.3f);
+        const size_t churnPerTick = std::max<size_t>(1, options.entities / 100);
+
+        // Far enough out that the spawn area's near half unloads
+        const float walkDistance = static_cast<float>((options.renderDistance + 3) * CHUNK_SIZE_X);
+
+        std::vector<double> tickMs;
+        std::vector<double> storageMs;
+        tickMs.reserve(options.ticks);
+        storageMs.reserve(options.ticks);
+        size_t simulated = 0;
+        size_t frozen = 0;
+        size_t staleHandles = 0;
+        size_t peakStored = 0;
+
+        for (int tick = 0; tick < options.ticks; tick++) {
+            float viewerX = walkDistance * std::sin(3.14159265f * tick / options.ticks);
+            chunkManager.update(viewerX, 0.0f);
+            std::vector<ChunkMeshUpdate> discarded;
+            chunkManager.takeMeshUpdates(discarded);
+
+            auto storageStart = std::chrono::steady_clock::now();
+            storage.update(world, chunkManager);
+            storageMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - storageStart).count());
+            peakStored = std::max(peakStored, storage.getStoredEntityCount());
+
+            // Game logic: jump at walls, drift the heading (kept out of the timing)
+            for (size_t i = 0; i < world.bodies.size(); i++) {
+                const PhysicsBody& body = world.bodies.at(i);
+                Velocity* velocity = world.velocities.get(world.bodies.entityAt(i));
+                if (body.blockedHorizontally && body.onGround) velocity->y = JUMP_STRENGTH;
+
+                float angle = std::atan2(velocity->z, velocity->x) + steer(spawner.random);
+                velocity->x = std::cos(angle) * WANDER_SPEED;
+                velocity->z = std::sin(angle) * WANDER_SPEED;
+            }
+
+            // Churn live entities only; stored ones have no handle to destroy
+            for (size_t i = 0; i < churnPerTick && world.transforms.size() > 0; i++) {
+                std::uniform_int_distribution<size_t> pick(0, world.transforms.size() - 1);
+                EntityHandle old = world.handleOf(world.transforms.entityAt(pick(spawner.random)));
+                world.destroy(old);
+                spawner.spawn(world);
+                if (world.isAlive(old)) staleHandles++;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            physics.update(world, chunkManager, TICK_SECONDS);
+            tickMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+            simulated += physics.getSimulatedCount();
+            frozen += physics.getFrozenCount();
+        }
+
+        // Back at the origin: everything stored comes back once its chunk is in
+        if (!loadWorld(chunkManager)) {
+            std::cerr << "World did not finish reloading\n";
+            return 1;
+        }
+        storage.update(world, chunkManager);
+
+        double totalMs = 0.0;
+        for (double ms : tickMs) totalMs += ms;
+        std::vector<double> sorted = tickMs;
+        std::sort(sorted.begin(), sorted.end());
+        double p99 = sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+
+        double totalStorageMs = 0.0;
+        for (double ms : storageMs) totalStorageMs += ms;
+        std::sort(storageMs.begin(), storageMs.end());
+
+        std::cout << "entity_bench: " << world.getAliveCount() << " entities, " << options.ticks << " ticks, render distance "
+            << options.renderDistance << " (" << chunkManager.getLoadedChunks().size() << " chunks)\n"
+            << std::fixed << std::setprecision(3)
+            << "  tick avg " << totalMs / tickMs.size() << " ms, p99 " << p99 << " ms, max " << sorted.back() << " ms\n"
+            << std::setprecision(1)
+            << "  " << (simulated + frozen) / (totalMs / 1000.0) / 1e6 << " M entity updates/s ("
+            << simulated << " simulated, " << frozen << " frozen at unloaded chunks)\n"
+            << "  storage " << storage.getTotalStored() << " stored, " << storage.getTotalRestored() << " restored, peak "
+            << peakStored << " held, " << storage.getStoredEntityCount() << " still stored after returning\n"
+            << std::setprecision(3)
+            << "  storage update avg " << totalStorageMs / storageMs.size() << " ms, max " << storageMs.back() << " ms\n";
+
+        if (staleHandles > 0) {
+            std::cerr << "Destroyed entity handles still resolve\n";
+            exitCode = 1;
+        }
+        if (world.getAliveCount() + storage.getStoredEntityCount() != static_cast<size_t>(options.entities)) {
+            std::cerr << "Entities lost between storage and the world\n";
+            exitCode = 1;
+        }
+    }
+
+    std::filesystem::remove_all(std::string("SavedData/") + WORLD_NAME);
+    return exitCode;
+}
@@ -0,0 +1,297 @@
+// Fluid simulation throughput: floods a stone basin built on real terrain.
+//
+// Usage: fluid_bench [--render-distance N] [--size N] [--depth N]
+//                    [--spacing N] [--ticks N] [--threads N]
+//                    [--remesh-budget MS]
+//
+// Builds a --size x --size basin, --depth blocks deep, on top of the
+// highest terrain around the origin, puts a water source every --spacing
+// blocks along its rim level and runs FluidSimulation at the client's
+// 60 Hz tick until no block ticks are pending (or --ticks). Reports
+// simulation time per tick, the remeshing it queues (flushed after every
+// tick with the client's per-frame budget; 0 = no budget), block ticks
+// per second, and a checksum of the basin that must be the same for
+// every --threads value. Every fluid step is a saved block change, so it
+// also reports the save's size and how long a chunk takes to fetch its
+// changes (WorldSave::loadChunkModifications, run by every generation).
+
+#include "ChunkManager.h"
+#include "FluidSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct BenchOptions {
+        int renderDistance = 6;
+        int size = 64;
+        int depth = 12;
+        int spacing = 4;
+        int ticks = 20000;
+        unsigned int threads = 0;
+        float remeshBudgetMs = 4.0f;  // MESH_REBUILD_BUDGET_MS in main.cpp
+    };
+
+    const char* WORLD_NAME = "fluid_bench";
+
+    bool parseArguments(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--render-distance" && hasValue) options.renderDistance = std::atoi(argv[++i]);
+            else if (arg == "--size" && hasValue) options.size = std::atoi(argv[++i]);
+            else if (arg == "--depth" && hasValue) options.depth = std::atoi(argv[++i]);
+            else if (arg == "--spacing" && hasValue) options.spacing = std::atoi(argv[++i]);
+            else if (arg == "--ticks" && hasValue) options.ticks = std::atoi(argv[++i]);
+            else if (arg == "--threads" && hasValue) options.threads = static_cast<unsigned int>(std::atoi(argv[++i]));
+            else if (arg == "--remesh-budget" && hasValue) options.remeshBudgetMs = static_cast<float>(std::atof(argv[++i]));
+            else return false;
+        }
+
+        // The basin and its walls must stay inside the chunks that get meshed
+        int loadedHalfWidth = (options.renderDistance - 1) * CHUNK_SIZE_X;
+        return options.renderDistance >= 2 && options.size >= 2 && options.size / 2 + 1 < loadedHalfWidth
+            && options.depth >= 1 && options.spacing >= 1 && options.ticks >= 1 && options.remeshBudgetMs >= 0.0f;
+    }
+
+    // Drives update() at the origin until every requested chunk is in
+    bool loadWorld(ChunkManager& chunkManager) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+        size_t lastLoaded = 0;
+        int stableFrames = 0;
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            chunkManager.update(0.0f, 0.0f);
+            std::vector<ChunkMeshUpdate> discarded;
+            chunkManager.takeMeshUpdates(discarded);
+
+            const GenerationStats& stats = chunkManager.getGenerationStats();
+            size_t loaded = chunkManager.getLoadedChunks().size();
+            bool settled = loaded > 0 && loaded == lastLoaded && stats.completed + stats.cancelled >= stats.requested;
+            stableFrames = settled ? stableFrames + 1 : 0;
+            if (stableFrames >= 10) return true;
+
+            lastLoaded = loaded;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    // Blocks [min, max] on both axes; the walls sit one block outside
+    struct Basin {
+        int min = 0;
+        int max = 0;
+        int floorY = 0;
+        int rimY = 0;  // Top layer of the inside, where the sources go
+    };
+
+    bool buildBasin(ChunkManager& chunkManager, const BenchOptions& options, Basin& basin) {
+        basin.min = -options.size / 2;
+        basin.max = basin.min + options.size - 1;
+
+        int highest = 0;
+        for (int x = basin.min - 1; x <= basin.max + 1; x++) {
+            for (int z = basin.min - 1; z <= basin.max + 1; z++) {
+                for (int y = CHUNK_SIZE_Y - 1; y > highest; y--) {
+                    std::optional<Block> block = chunkManager.getBlockAt(x, y, z);
+                    if (block && !block->isAir()) { highest = y; break; }
+                }
+            }
+        }
+
+        basin.floorY = highest + 1;
+        basin.rimY = basin.floorY + options.depth;
+        if (basin.rimY >= CHUNK_SIZE_Y) return false;
+
+        for (int x = basin.min - 1; x <= basin.max + 1; x++) {
+            for (int z = basin.min - 1; z <= basin.max + 1; z++) {
+                chunkManager.setBlockAt(x, basin.floorY, z, BlockType::STONE);
+
+                bool wall = x < basin.min || x > basin.max || z < basin.min || z > basin.max;
+                for (int y = basin.floorY + 1; wall && y <= basin.rimY; y++) {
+                    chunkManager.setBlockAt(x, y, z, BlockType::STONE);
+                }
+            }
+        }
+        chunkManager.flushMeshRebuilds();
+        return true;
+    }
+
+    // FNV-1a over the inside of the basin (type and fluid level)
+    uint64_t basinChecksum(const ChunkManager& chunkManager, const Basin& basin, size_t& waterBlocks) {
+        uint64_t hash = 14695981039346656037ull;
+        waterBlocks = 0;
+
+        for (int x = basin.min; x <= basin.max; x++) {
+            for (int y = basin.floorY + 1; y <= basin.rimY; y++) {
+                for (int z = basin.min; z <= basin.max; z++) {
+                    std::optional<Block> block = chunkManager.getBlockAt(x, y, z);
+                    if (!block) continue;
+                    if (block->type == BlockType::WATER) waterBlocks++;
+
+                    unsigned char bytes[2] = { static_cast<unsigned char>(block->type), block->fluidLevel };
+                    for (unsigned char byte : bytes) {
+                        hash ^= byte;
+                        hash *= 1099511628211ull;
+                    }
+                }
+            }
+        }
+        return hash;
+    }
+
+    double percentile(std::vector<double> values, int percent) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size() - 1, values.size() * percent / 100)];
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: fluid_bench [--render-distance N] [--size N] [--depth N] [--spacing N] [--ticks N] [--threads N]"
+            " [--remesh-budget MS]\n";
+        return 1;
+    }
+
+    // Start from unmodified terrain: the previous run's flood is saved
+    std::filesystem::remove_all(std::string("SavedData/") + WORLD_NAME);
+
+    int exitCode = 0;
+    {
+        ChunkManager chunkManager(options.renderDistance, WORLD_NAME);
+        if (!loadWorld(chunkManager)) {
+            std::cerr << "World did not finish loading\n";
+            return 1;
+        }
+
+        Basin basin;
+        if (!buildBasin(chunkManager, options, basin)) {
+            std::cerr << "Basin does not fit under the top of the world\n";
+            return 1;
+        }
+
+        FluidSimulation simulation(options.threads);
+
+        int sources = 0;
+        for (int x = basin.min; x <= basin.max; x += options.spacing) {
+            for (int z = basin.min; z <= basin.max; z += options.spacing) {
+                if (chunkManager.setBlockAt(x, basin.rimY, z, BlockType::WATER)) sources++;
+            }
+        }
+        chunkManager.flushMeshRebuilds();
+
+        using Clock = std::chrono::steady_clock;
+        std::vector<double> tickMs;
+        std::vector<double> remeshMs;
+        double simulatedMs = 0.0;
+        double totalRemeshMs = 0.0;
+        int gameTicks = 0;
+        bool settled = false;
+
+        auto flushRemeshing = [&] {
+            if (options.remeshBudgetMs > 0.0f) chunkManager.flushMeshRebuilds(options.remeshBudgetMs);
+            else chunkManager.flushMeshRebuilds();
+        };
+
+        while (gameTicks < options.ticks) {
+            Clock::time_point start = Clock::now();
+            simulation.update(chunkManager);
+            Clock::time_point simulated = Clock::now();
+            flushRemeshing();
+            Clock::time_point remeshed = Clock::now();
+            gameTicks++;
+
+            double ms = std::chrono::duration<double, std::milli>(simulated - start).count();
+            double meshMs = std::chrono::duration<double, std::milli>(remeshed - simulated).count();
+            simulatedMs += ms;
+            totalRemeshMs += meshMs;
+            if (simulation.getLastTickCount() > 0) tickMs.push_back(ms);
+            if (meshMs > 0.0 && (simulation.getLastTickCount() > 0 || chunkManager.getQueuedMeshRebuildCount() > 0)) {
+                remeshMs.push_back(meshMs);
+            }
+
+            if (chunkManager.getBlockTicks().getPendingCount() == 0) {
+                settled = true;
+                break;
+            }
+        }
+
+        // Meshes still queued when the flood settled catch up on the
+        // following ticks
+        int catchUpTicks = 0;
+        while (chunkManager.getQueuedMeshRebuildCount() > 0) {
+            Clock::time_point start = Clock::now();
+            flushRemeshing();
+            double meshMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            totalRemeshMs += meshMs;
+            remeshMs.push_back(meshMs);
+            catchUpTicks++;
+        }
+
+        size_t waterBlocks = 0;
+        uint64_t checksum = basinChecksum(chunkManager, basin, waterBlocks);
+
+        WorldSave& worldSave = chunkManager.getWorldSave();
+        worldSave.flush();
+        std::error_code sizeError;
+        uintmax_t saveBytes = std::filesystem::file_size(std::string("SavedData/") + WORLD_NAME + "/world_blocks.dat", sizeError);
+        if (sizeError) saveBytes = 0;
+
+        std::vector<double> chunkLoadUs;
+        size_t replayedChanges = 0;
+        std::vector<ModifiedBlock> modifications;
+        for (Chunk* chunk : chunkManager.getLoadedChunks()) {
+            modifications.clear();
+            Clock::time_point start = Clock::now();
+            worldSave.loadChunkModifications(chunk->chunkX, chunk->chunkZ, modifications);
+            chunkLoadUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            replayedChanges += modifications.size();
+        }
+        double totalChunkLoadUs = 0.0;
+        for (double us : chunkLoadUs) totalChunkLoadUs += us;
+
+        double averageMs = tickMs.empty() ? 0.0 : simulatedMs / tickMs.size();
+        double averageRemeshMs = remeshMs.empty() ? 0.0 : totalRemeshMs / remeshMs.size();
+        std::string budget = options.remeshBudgetMs > 0.0f
+            ? std::to_string(static_cast<int>(options.remeshBudgetMs)) + " ms budget" : "no budget";
+
+        std::cout << "fluid_bench: " << options.size << "x" << options.size << " basin, " << options.depth
+            << " deep, " << sources << " sources, " << simulation.getThreadCount() << " threads\n"
+            << "  " << (settled ? "settled after " : "stopped at ") << gameTicks << " game ticks ("
+            << std::fixed << std::setprecision(1) << gameTicks / 60.0f << " s of game time), "
+            << tickMs.size() << " with block ticks due\n"
+            << std::setprecision(3)
+            << "  simulate avg " << averageMs << " ms, p99 " << percentile(tickMs, 99) << " ms, max "
+            << percentile(tickMs, 100) << " ms per busy tick\n"
+            << "  remesh   avg " << averageRemeshMs << " ms, p99 " << percentile(remeshMs, 99) << " ms over "
+            << remeshMs.size() << " ticks (" << budget << ", " << catchUpTicks << " after settling), "
+            << chunkManager.getMeshStats().rebuilds << " chunk rebuilds\n"
+            << std::setprecision(1)
+            << "  " << simulation.getTotalTicks() << " block ticks, " << simulation.getTotalChanges() << " blocks changed, "
+            << waterBlocks << " water blocks in the basin\n"
+            << "  " << (simulatedMs > 0.0 ? simulation.getTotalTicks() / (simulatedMs / 1000.0) / 1e6 : 0.0)
+            << " M block ticks/s, " << (simulatedMs > 0.0 ? gameTicks / (simulatedMs / 1000.0) : 0.0)
+            << " game ticks/s (simulation only)\n"
+            << "  save " << worldSave.getModificationCount() << " block changes, " << saveBytes / 1024 << " KB; per-chunk load avg "
+            << std::setprecision(2) << (chunkLoadUs.empty() ? 0.0 : totalChunkLoadUs / chunkLoadUs.size()) << " us, max "
+            << percentile(chunkLoadUs, 100) << " us over " << chunkLoadUs.size() << " chunks (" << replayedChanges
+            << " changes)\n"
+            << "  basin checksum " << std::hex << checksum << std::dec << "\n";
+
+        if (!settled) exitCode = 1;
+    }
+
+    std::filesystem::remove_all(std::string("SavedData/") + WORLD_NAME);
+    return exitCode;
+}
@@ -0,0 +1,173 @@
+// Broad-phase throughput of SpatialHash against a linear scan.
+//
+// Usage: spatial_hash_bench [--points N] [--queries N] [--ticks N]
+//
+// Scatters --points entities over a 512 x 512 block area near the
+// surface, then measures:
+//   insert   registering every point
+//   move     --ticks rounds of moving every point a walking step
+//   radius   8-block radius queries (what mob AI and item pickup ask)
+//   box      player-sized boxes (entity-vs-entity collision)
+// Queries also run as a scan over every point, the O(n) per query
+// (O(n^2) per tick) cost without a spatial structure. That the two
+// agree is checked by the SpatialHash tests.
+
+#include "Entity/SpatialHash.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct BenchOptions {
+        int points = 50000;
+        int queries = 5000;
+        int ticks = 60;
+    };
+
+    struct Position {
+        float x, y, z;
+    };
+
+    const float AREA = 512.0f;
+    const float QUERY_RADIUS = 8.0f;
+    const float STEP = 4.3f / 60.0f;  // Walking speed, one 60 Hz tick
+
+    bool parseArguments(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--points" && hasValue) options.points = std::atoi(argv[++i]);
+            else if (arg == "--queries" && hasValue) options.queries = std::atoi(argv[++i]);
+            else if (arg == "--ticks" && hasValue) options.ticks = std::atoi(argv[++i]);
+            else return false;
+        }
+        return options.points >= 1 && options.queries >= 1 && options.ticks >= 1;
+    }
+
+    template <typename Fn>
+    double seconds(Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void printRate(const char* name, double count, double elapsed, const char* unit) {
+        std::cout << "  " << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << count / elapsed / 1e3 << " k " << unit << "/s  ("
+            << std::setprecision(3) << elapsed * 1000.0 << " ms)\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: spatial_hash_bench [--points N] [--queries N] [--ticks N]\n";
+        return 1;
+    }
+
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<float> horizontal(-AREA / 2.0f, AREA / 2.0f);
+    std::uniform_real_distribution<float> height(60.0f, 100.0f);
+    std::uniform_real_distribution<float> step(-STEP, STEP);
+
+    std::vector<Position> positions(options.points);
+    for (Position& position : positions) {
+        position = { horizontal(random), height(random), horizontal(random) };
+    }
+
+    SpatialHash hash;
+    std::cout << "spatial_hash_bench: " << options.points << " points, " << SpatialHash::CELL_SIZE << "-block cells\n";
+
+    double insertSeconds = seconds([&] {
+        for (size_t i = 0; i < positions.size(); i++) {
+            hash.update(static_cast<uint32_t>(i), positions[i].x, positions[i].y, positions[i].z);
+        }
+    });
+    printRate("insert", static_cast<double>(positions.size()), insertSeconds, "points");
+
+    double moveSeconds = 0.0;
+    for (int tick = 0; tick < options.ticks; tick++) {
+        for (Position& position : positions) {
+            position.x += step(random);
+            position.z += step(random);
+        }
+        moveSeconds += seconds([&] {
+            for (size_t i = 0; i < positions.size(); i++) {
+                hash.update(static_cast<uint32_t>(i), positions[i].x, positions[i].y, positions[i].z);
+            }
+        });
+    }
+    printRate("move", static_cast<double>(positions.size()) * options.ticks, moveSeconds, "points");
+
+    // Queries centered on random entities, like every entity asking about its neighbours
+    std::uniform_int_distribution<size_t> pick(0, positions.size() - 1);
+    std::vector<Position> centers(options.queries);
+    for (Position& center : centers) center = positions[pick(random)];
+
+    std::vector<uint32_t> found;
+    std::vector<uint32_t> scanned;
+    size_t hashHits = 0;
+
+    auto scanRadius = [&](const Position& center, std::vector<uint32_t>& out) {
+        out.clear();
+        float radiusSquared = QUERY_RADIUS * QUERY_RADIUS;
+        for (size_t i = 0; i < positions.size(); i++) {
+            float dx = positions[i].x - center.x;
+            float dy = positions[i].y - center.y;
+            float dz = positions[i].z - center.z;
+            if (dx * dx + dy * dy + dz * dz <= radiusSquared) out.push_back(static_cast<uint32_t>(i));
+        }
+    };
+
+    auto playerBox = [](const Position& center) {
+        return CollisionBox{ center.x - 0.3f, center.y, center.z - 0.3f, center.x + 0.3f, center.y + 1.8f, center.z + 0.3f };
+    };
+
+    auto scanBox = [&](const CollisionBox& box, std::vector<uint32_t>& out) {
+        out.clear();
+        for (size_t i = 0; i < positions.size(); i++) {
+            const Position& p = positions[i];
+            if (p.x >= box.minX && p.x <= box.maxX && p.y >= box.minY && p.y <= box.maxY
+                && p.z >= box.minZ && p.z <= box.maxZ) {
+                out.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    };
+
+    double radiusSeconds = seconds([&] {
+        for (const Position& center : centers) {
+            hash.queryRadius(center.x, center.y, center.z, QUERY_RADIUS, found);
+            hashHits += found.size();
+        }
+    });
+    double radiusScanSeconds = seconds([&] {
+        for (const Position& center : centers) {
+            scanRadius(center, scanned);
+        }
+    });
+    printRate("radius hash", options.queries, radiusSeconds, "queries");
+    printRate("radius scan", options.queries, radiusScanSeconds, "queries");
+    std::cout << "  " << std::setprecision(1) << static_cast<double>(hashHits) / options.queries
+        << " neighbours per query, " << radiusScanSeconds / radiusSeconds << "x faster than the scan\n";
+
+    double boxSeconds = seconds([&] {
+        for (const Position& center : centers) {
+            hash.queryBox(playerBox(center), found);
+        }
+    });
+    double boxScanSeconds = seconds([&] {
+        for (const Position& center : centers) {
+            scanBox(playerBox(center), scanned);
+        }
+    });
+    printRate("box hash", options.queries, boxSeconds, "queries");
+    printRate("box scan", options.queries, boxScanSeconds, "queries");
+    std::cout << "  " << std::setprecision(1) << boxScanSeconds / boxSeconds << "x faster than the scan\n";
+
+    return 0;
+}
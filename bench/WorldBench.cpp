@@ -0,0 +1,274 @@
+// Headless benchmark of the world pipeline: terrain generation, lighting,
+// CPU meshing and chunk serialization over a fixed seed and radius.
+// No window or GL context is created, so it runs on any build machine.
+//
+// Usage: world_bench [--radius N] [--runs N] [--json path]
+//
+// Each stage is timed over every chunk in the square of the given
+// radius, single-threaded, and the fastest of --runs repetitions is
+// reported. Checksums of the lit blocks and of the mesh change whenever
+// a stage's output changes, so a regression diff can tell "faster" from
+// "different".
+
+#include "Chunk.h"
+#include "ChunkCache.h"
+#include "LightEngine.h"
+#include "TerrainGenerator.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    struct StageResult {
+        const char* name;
+        size_t chunks = 0;
+        double bestSeconds = 0.0;
+
+        double chunksPerSecond() const { return bestSeconds > 0.0 ? chunks / bestSeconds : 0.0; }
+    };
+
+    struct BenchOptions {
+        int radius = 8;
+        int runs = 3;
+        std::string jsonPath;
+    };
+
+    // FNV-1a, enough to notice any change in output
+    uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t HASH_SEED = 14695981039346656037ull;
+
+    class BenchWorld {
+    public:
+        explicit BenchWorld(int radius)
+            : radius(radius),
+            lightEngine([this](int cx, int cz) { return findChunk(cx, cz); })
+        {
+        }
+
+        ~BenchWorld() { clear(); }
+
+        void clear() {
+            for (auto& [_, chunk] : chunks) delete chunk;
+            chunks.clear();
+            order.clear();
+        }
+
+        // Stage 1: terrain only
+        void generate() {
+            for (int cx = -radius; cx <= radius; cx++) {
+                for (int cz = -radius; cz <= radius; cz++) {
+                    Chunk* chunk = new Chunk(cx, cz);
+                    TerrainGenerator::generateFlatTerrain(*chunk);
+                    chunks[makeKey(cx, cz)] = chunk;
+                    order.push_back(chunk);
+                }
+            }
+        }
+
+        // Stage 2: what the workers do per chunk, then what the main
+        // thread does once neighbors are linked
+        void light() {
+            for (Chunk* chunk : order) {
+                chunk->calculateSkyLight(15);
+                chunk->calculateBlockLight();
+            }
+
+            for (Chunk* chunk : order) {
+                for (int i = 0; i < NEIGHBOR_COUNT; i++) {
+                    chunk->setNeighbor(i, findChunk(chunk->chunkX + NEIGHBOR_DX[i], chunk->chunkZ + NEIGHBOR_DZ[i]));
+                }
+            }
+
+            std::unordered_set<Chunk*> relit;
+            for (Chunk* chunk : order) {
+                lightEngine.propagateChunkBorders(chunk, relit);
+            }
+        }
+
+        // Stage 3: CPU meshing of every chunk with a complete neighborhood
+        size_t mesh(uint64_t& checksum, size_t& triangles) {
+            std::map<BlockType, ChunkMeshBuffers> buffers;
+            size_t meshed = 0;
+            checksum = HASH_SEED;
+            triangles = 0;
+
+            for (Chunk* chunk : order) {
+                if (!chunk->hasAllNeighbors()) continue;
+                chunk->buildMeshData(buffers);
+                meshed++;
+
+                for (auto& [type, mesh] : buffers) {
+                    uint32_t typeId = static_cast<uint32_t>(type);
+                    checksum = hashBytes(checksum, &typeId, sizeof(typeId));
+                    checksum = hashBytes(checksum, mesh.vertices.data(), mesh.vertices.size() * sizeof(float));
+                    checksum = hashBytes(checksum, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+                    triangles += mesh.indices.size() / 3;
+                }
+            }
+            return meshed;
+        }
+
+        // Stage 4: run-length encoding, as done for every unloaded chunk
+        size_t save(ChunkCache& cache) {
+            for (Chunk* chunk : order) {
+                cache.store(*chunk);
+            }
+            return cache.getStats().bytesUsed;
+        }
+
+        uint64_t blockChecksum() const {
+            uint64_t checksum = HASH_SEED;
+            for (const Chunk* chunk : order) {
+                // Field by field, with the type widened to the 4 bytes it
+                // used to take so checksums stay comparable across versions
+                for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                    for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+                        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                            const Block& block = chunk->blocks[x][y][z];
+                            uint32_t type = static_cast<uint32_t>(block.type);
+                            unsigned char skyLight = block.skyLight;
+                            checksum = hashBytes(checksum, &type, sizeof(type));
+                            checksum = hashBytes(checksum, &skyLight, sizeof(skyLight));
+                            checksum = hashBytes(checksum, &block.blockLight, sizeof(block.blockLight));
+                        }
+                    }
+                }
+            }
+            return checksum;
+        }
+
+        size_t chunkCount() const { return order.size(); }
+
+    private:
+        long long makeKey(int x, int z) const {
+            return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+        }
+
+        Chunk* findChunk(int cx, int cz) const {
+            auto it = chunks.find(makeKey(cx, cz));
+            return it != chunks.end() ? it->second : nullptr;
+        }
+
+        int radius;
+        std::unordered_map<long long, Chunk*> chunks;
+        std::vector<Chunk*> order;
+        LightEngine lightEngine;
+    };
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void keepBest(StageResult& result, size_t chunks, double seconds) {
+        if (result.chunks == 0 || seconds < result.bestSeconds) result.bestSeconds = seconds;
+        result.chunks = chunks;
+    }
+
+    bool parseArguments(int argc, char** argv, BenchOptions& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--radius" && hasValue) options.radius = std::atoi(argv[++i]);
+            else if (arg == "--runs" && hasValue) options.runs = std::atoi(argv[++i]);
+            else if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+            else return false;
+        }
+        return options.radius >= 1 && options.runs >= 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: world_bench [--radius N] [--runs N] [--json path]\n";
+        return 1;
+    }
+
+    StageResult stages[4] = { { "generation" }, { "lighting" }, { "meshing" }, { "saving" } };
+    uint64_t blockChecksum = 0;
+    uint64_t meshChecksum = 0;
+    size_t triangles = 0;
+    size_t savedBytes = 0;
+
+    BenchWorld world(options.radius);
+    for (int run = 0; run < options.runs; run++) {
+        world.clear();
+
+        auto start = std::chrono::steady_clock::now();
+        world.generate();
+        keepBest(stages[0], world.chunkCount(), secondsSince(start));
+
+        start = std::chrono::steady_clock::now();
+        world.light();
+        keepBest(stages[1], world.chunkCount(), secondsSince(start));
+
+        start = std::chrono::steady_clock::now();
+        size_t meshed = world.mesh(meshChecksum, triangles);
+        keepBest(stages[2], meshed, secondsSince(start));
+
+        ChunkCache cache(world.chunkCount() * sizeof(Chunk));
+        start = std::chrono::steady_clock::now();
+        savedBytes = world.save(cache);
+        keepBest(stages[3], world.chunkCount(), secondsSince(start));
+
+        blockChecksum = world.blockChecksum();
+    }
+
+    std::cout << "world_bench: seed " << TerrainGenerator::SEED << ", radius " << options.radius
+        << " (" << world.chunkCount() << " chunks), best of " << options.runs << " runs\n";
+    for (const StageResult& stage : stages) {
+        std::cout << "  " << std::left << std::setw(12) << stage.name << std::right
+            << std::setw(6) << stage.chunks << " chunks  "
+            << std::fixed << std::setprecision(1) << std::setw(9) << stage.bestSeconds * 1000.0 << " ms  "
+            << std::setw(9) << stage.chunksPerSecond() << " chunks/s\n";
+    }
+    std::cout << "  " << triangles << " triangles, " << savedBytes / 1024 << " KB saved\n";
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream json(options.jsonPath);
+        if (!json.is_open()) {
+            std::cerr << "Failed to write " << options.jsonPath << "\n";
+            return 1;
+        }
+
+        json << std::fixed << std::setprecision(3);
+        json << "{\n";
+        json << "  \"seed\": " << TerrainGenerator::SEED << ",\n";
+        json << "  \"radius\": " << options.radius << ",\n";
+        json << "  \"chunks\": " << world.chunkCount() << ",\n";
+        json << "  \"runs\": " << options.runs << ",\n";
+        json << "  \"stages\": {\n";
+        for (int i = 0; i < 4; i++) {
+            const StageResult& stage = stages[i];
+            json << "    \"" << stage.name << "\": { \"chunks\": " << stage.chunks
+                << ", \"ms\": " << stage.bestSeconds * 1000.0
+                << ", \"chunks_per_sec\": " << stage.chunksPerSecond() << " }"
+                << (i < 3 ? ",\n" : "\n");
+        }
+        json << "  },\n";
+        json << "  \"triangles\": " << triangles << ",\n";
+        json << "  \"saved_bytes\": " << savedBytes << ",\n";
+        json << "  \"block_checksum\": \"" << std::hex << blockChecksum << "\",\n";
+        json << "  \"mesh_checksum\": \"" << meshChecksum << std::dec << "\"\n";
+        json << "}\n";
+    }
+
+    return 0;
+}
@@ -1,7 +1,10 @@
 #ifndef BLOCK_H
 #define BLOCK_H
 
-enum class BlockType {
+#include <cstdint>
+
+// One byte: stored in every Block, in saves and on the wire
+enum class BlockType : uint8_t {
     AIR = 0,
     GRASS = 1,
     DIRT = 2,
@@ -10,23 +13,176 @@ enum class BlockType {
     BLOCKOFPUREWHITELIGHT = 5,
     BLOCKOFPUREREDLIGHT = 6,
     BLOCKOFPUREGREENLIGHT = 7,
-    BLOCKOFPUREBLUELIGHT = 8
+    BLOCKOFPUREBLUELIGHT = 8,
+    GLASS = 9,
+    WATER = 10,
+    TALL_GRASS = 11,
+    LAVA = 12
+};
+
+// Block light is stored as three 4-bit channels packed 0x0RGB
+constexpr int BLOCK_LIGHT_RED_SHIFT = 8;
+constexpr int BLOCK_LIGHT_GREEN_SHIFT = 4;
+constexpr int BLOCK_LIGHT_BLUE_SHIFT = 0;
+
+constexpr unsigned short packBlockLight(unsigned char r, unsigned char g, unsigned char b) {
+    return static_cast<unsigned short>((r << BLOCK_LIGHT_RED_SHIFT) | (g << BLOCK_LIGHT_GREEN_SHIFT) | (b << BLOCK_LIGHT_BLUE_SHIFT));
+}
+
+constexpr unsigned char blockLightChannel(unsigned short light, int shift) {
+    return static_cast<unsigned char>((light >> shift) & 0xF);
+}
+
+// Each channel one step dimmer (channels already at 0 stay at 0)
+constexpr unsigned short decayBlockLight(unsigned short light) {
+    unsigned short result = 0;
+    for (int shift = 0; shift <= BLOCK_LIGHT_RED_SHIFT; shift += 4) {
+        unsigned char channel = blockLightChannel(light, shift);
+        if (channel > 0) result |= static_cast<unsigned short>((channel - 1) << shift);
+    }
+    return result;
+}
+
+// Per-channel maximum of two packed values
+constexpr unsigned short maxBlockLight(unsigned short a, unsigned short b) {
+    unsigned short result = 0;
+    for (int shift = 0; shift <= BLOCK_LIGHT_RED_SHIFT; shift += 4) {
+        unsigned char ca = blockLightChannel(a, shift);
+        unsigned char cb = blockLightChannel(b, shift);
+        result |= static_cast<unsigned short>((ca > cb ? ca : cb) << shift);
+    }
+    return result;
+}
+
+constexpr int BLOCK_TYPE_COUNT = static_cast<int>(BlockType::LAVA) + 1;
+
+// Which pass draws a type: opaque geometry first, then alpha-tested
+// cutouts (fully clear or fully solid texels), then blended translucent
+// faces sorted back to front
+enum class RenderLayer : uint8_t {
+    OPAQUE,
+    CUTOUT,
+    TRANSLUCENT
+};
+
+enum class BlockShape : uint8_t {
+    CUBE,
+    CROSS  // Two crossed diagonal quads (plants)
+};
+
+// =============================
+// Block property table
+// =============================
+// Everything meshing, lighting and collision need to know about a type,
+// looked up by index instead of switching on it. 4 bytes per type, so the
+// whole table is a single cache line.
+struct BlockProperties {
+    bool solid : 1;            // Collides with players and entities
+    bool opaque : 1;           // Hides faces behind it, stops light, darkens AO
+    bool hidesSameType : 1;    // No faces between two of these (glass, water)
+    RenderLayer layer : 2;
+    BlockShape shape : 1;
+    bool replaceable : 1;      // Flowing fluids wash it away (air, plants)
+    bool targetable : 1;       // Rays stop on it to break or place against (not air or fluids)
+    unsigned char tickDelay;   // Game ticks from a change nearby to its scheduled tick; 0 = never ticked
+    unsigned short emission;   // Packed RGB light given off (see packBlockLight)
+};
+
+// Rarely used per-type data, kept out of the hot table
+struct BlockInfo {
+    const char* name;
+    const char* texture;  // nullptr: never rendered
 };
 
+// Both tables are indexed by BlockType and must list every type in order
+constexpr BlockProperties BLOCK_PROPERTIES[BLOCK_TYPE_COUNT] = {
+    // solid  opaque  same   layer                     shape               repl   target tick  emission
+    { false,  false,  false, RenderLayer::OPAQUE,      BlockShape::CUBE,   true,  false, 0,    0 },                           // AIR
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    0 },                           // GRASS
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    0 },                           // DIRT
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    0 },                           // STONE
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    0 },                           // SAND
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    packBlockLight(15, 15, 15) },  // BLOCKOFPUREWHITELIGHT
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    packBlockLight(15, 0, 0) },    // BLOCKOFPUREREDLIGHT
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    packBlockLight(0, 15, 0) },    // BLOCKOFPUREGREENLIGHT
+    { true,   true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, true,  0,    packBlockLight(0, 0, 15) },    // BLOCKOFPUREBLUELIGHT
+    { true,   false,  true,  RenderLayer::CUTOUT,      BlockShape::CUBE,   false, true,  0,    0 },                           // GLASS
+    { false,  false,  true,  RenderLayer::TRANSLUCENT, BlockShape::CUBE,   false, false, 15,   0 },                           // WATER
+    { false,  false,  false, RenderLayer::CUTOUT,      BlockShape::CROSS,  true,  true,  0,    0 },                           // TALL_GRASS
+    { false,  true,   false, RenderLayer::OPAQUE,      BlockShape::CUBE,   false, false, 90,   packBlockLight(15, 9, 3) },    // LAVA
+};
+
+constexpr BlockInfo BLOCK_INFO[BLOCK_TYPE_COUNT] = {
+    { "Air", nullptr },
+    { "Grass", "assets/textures/blocks/GrassBlock.png" },
+    { "Dirt", "assets/textures/blocks/DirtBlock.png" },
+    { "Stone", "assets/textures/blocks/StoneBlock.png" },
+    { "Sand", "assets/textures/blocks/SandBlock.png" },
+    { "Block of Pure White Light", "assets/textures/blocks/BlockOfPureWhiteLight.png" },
+    { "Block of Pure Red Light", "assets/textures/blocks/BlockOfPureRedLight.png" },
+    { "Block of Pure Green Light", "assets/textures/blocks/BlockOfPureGreenLight.png" },
+    { "Block of Pure Blue Light", "assets/textures/blocks/BlockOfPureBlueLight.png" },
+    { "Glass", "assets/textures/blocks/GlassBlock.png" },
+    { "Water", "assets/textures/blocks/WaterBlock.png" },
+    { "Tall Grass", "assets/textures/blocks/TallGrass.png" },
+    { "Lava", "assets/textures/blocks/LavaBlock.png" },
+};
+
+static_assert(sizeof(BlockProperties) == 4, "Keep the property table compact");
+static_assert(sizeof(BLOCK_PROPERTIES) <= 64, "The property table should fit one cache line");
+
+constexpr const BlockProperties& getBlockProperties(BlockType type) {
+    return BLOCK_PROPERTIES[static_cast<int>(type)];
+}
+
+constexpr const BlockInfo& getBlockInfo(BlockType type) {
+    return BLOCK_INFO[static_cast<int>(type)];
+}
+
+// Light emitted by a block type (0 for non-emitters)
+constexpr unsigned short getLightEmission(BlockType type) {
+    return getBlockProperties(type).emission;
+}
+
+// Fluid blocks: 0 is a source, 1..FLUID_MAX_LEVEL the distance flowed
+// from one; FLUID_FALLING marks fluid fed from above (see FluidSimulation)
+constexpr unsigned char FLUID_SOURCE = 0;
+constexpr unsigned char FLUID_MAX_LEVEL = 7;
+constexpr unsigned char FLUID_FALLING = 8;
+
+// 4 bytes, no padding: a chunk's blocks are 256 KB
 struct Block {
     BlockType type;
-    unsigned char skyLight;  // 0-15 sky light level
+    unsigned char skyLight : 4;    // 0-15 sky light level
+    unsigned char fluidLevel : 4;  // Fluid types only (FLUID_SOURCE etc.)
+    unsigned short blockLight;     // Packed RGB block light (see packBlockLight)
 
-    Block() : type(BlockType::AIR), skyLight(0) {}
-    Block(BlockType t) : type(t), skyLight(0) {}
+    Block() : type(BlockType::AIR), skyLight(0), fluidLevel(0), blockLight(0) {}
+    Block(BlockType t) : type(t), skyLight(0), fluidLevel(0), blockLight(0) {}
 
     bool isAir() const {
         return type == BlockType::AIR;
     }
 
+    bool isSolid() const {
+        return getBlockProperties(type).solid;
+    }
+
+    // Light passes and neighbors' faces show through
     bool isTransparent() const {
-        return type == BlockType::AIR;
+        return !getBlockProperties(type).opaque;
+    }
+
+    // Something a ray can select; fluids and air are looked through
+    bool isTargetable() const {
+        return getBlockProperties(type).targetable;
+    }
+
+    bool isEmissive() const {
+        return getBlockProperties(type).emission != 0;
     }
 };
 
+static_assert(sizeof(Block) == 4, "Block is stored per voxel; keep it packed");
+
 #endif
\ No newline at end of file
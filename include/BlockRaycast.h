@@ -0,0 +1,23 @@
+#ifndef BLOCK_RAYCAST_H
+#define BLOCK_RAYCAST_H
+
+class ChunkManager;
+
+// First targetable block along a ray (air and fluids are looked
+// through), in block coordinates (z = -render z, like getBlockAt)
+struct BlockRaycastHit {
+    int blockX = 0, blockY = 0, blockZ = 0;
+    int faceX = 0, faceY = 0, faceZ = 0;  // Outward normal of the face the ray entered through
+    float distance = 0.0f;                // From the origin to that face (0 if it starts inside)
+};
+
+// Amanatides-Woo voxel traversal: visits every block the ray passes
+// through exactly once, in order, so corner-clipped blocks are never
+// skipped. Origin and direction are in render space (Camera coordinates;
+// blocks are centered on integers). Unloaded chunks count as air.
+bool raycastBlocks(const ChunkManager& chunkManager,
+    float originX, float originY, float originZ,
+    float dirX, float dirY, float dirZ,
+    float maxDistance, BlockRaycastHit& hit);
+
+#endif
@@ -1,11 +1,11 @@
 #ifndef BLOCK_REGISTRY_H
 #define BLOCK_REGISTRY_H
 
-#include <glad/glad.h>
-#include <map>
 #include "Block.h"
-#include "Texture.h"
+#include "Rendering/Texture.h"
 
+// Block textures, loaded from the paths in BLOCK_INFO and indexed by
+// BlockType. Needs a GL context.
 class BlockRegistry {
 public:
     static BlockRegistry& getInstance() {
@@ -14,11 +14,11 @@ public:
     }
 
     void loadTextures();
-    void bindTexture(BlockType type);
+    bool bindTexture(BlockType type);  // False for types without a texture
 
 private:
     BlockRegistry() {}
-    std::map<BlockType, Texture*> textures;
+    Texture* textures[BLOCK_TYPE_COUNT] = {};
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,79 @@
+#ifndef BLOCK_TICKS_H
+#define BLOCK_TICKS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// A position whose scheduled tick is due (world block coordinates)
+struct BlockTick {
+    int x, y, z;
+};
+
+// Ticks due this game tick in one chunk, in the order they were due
+// (then scheduled)
+struct ChunkTicks {
+    int chunkX = 0;
+    int chunkZ = 0;
+    std::vector<BlockTick> ticks;
+};
+
+// Scheduled block updates: schedule() asks for a position to be ticked
+// delay game ticks from now (once; a position already waiting keeps its
+// earlier slot). Ticks are queued per chunk, and a time wheel of
+// WHEEL_SLOTS slots records which chunks have something due at each
+// tick number modulo WHEEL_SLOTS, so advancing touches only those chunks
+// instead of every loaded one. A chunk due more than a full turn ahead
+// is simply passed over until its turn comes round. Main thread only.
+class BlockTickScheduler {
+public:
+    void schedule(int x, int y, int z, unsigned int delay);
+
+    // Moves to the next game tick and returns every tick now due, one
+    // entry per chunk, sorted by chunk (x, then z) so callers see the
+    // same order however the queues were filled. due is reused.
+    void advance(std::vector<ChunkTicks>& due);
+
+    // Unloaded chunk: its pending ticks are dropped
+    void dropChunk(int chunkX, int chunkZ);
+
+    uint64_t getCurrentTick() const { return currentTick; }
+    size_t getPendingCount() const { return pendingCount; }
+    size_t getChunkCount() const { return queues.size(); }
+
+private:
+    static constexpr int WHEEL_SLOTS = 64;
+
+    struct Entry {
+        uint64_t dueTick;
+        uint64_t sequence;   // Scheduling order, breaks ties between equal due ticks
+        uint16_t localIndex;  // See localIndex()
+    };
+
+    struct ChunkQueue {
+        std::vector<Entry> heap;                 // Min-heap on (dueTick, sequence)
+        std::unordered_set<uint16_t> scheduled;  // Local indices in heap
+        uint64_t wheelTick = 0;                  // Tick the chunk is registered on the wheel for; 0 = none
+    };
+
+    struct WheelEntry {
+        long long key;
+        uint64_t dueTick;
+    };
+
+    long long makeKey(int x, int z) const;
+    static uint16_t localIndex(int localX, int y, int localZ);
+    void registerOnWheel(long long key, ChunkQueue& queue, uint64_t dueTick);
+
+    std::unordered_map<long long, ChunkQueue> queues;
+    std::vector<WheelEntry> wheel[WHEEL_SLOTS];
+    std::vector<WheelEntry> turning;  // Scratch: the slot being advanced
+
+    uint64_t currentTick = 0;
+    uint64_t nextSequence = 0;
+    size_t pendingCount = 0;
+};
+
+#endif
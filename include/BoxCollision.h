@@ -0,0 +1,29 @@
+#ifndef BOX_COLLISION_H
+#define BOX_COLLISION_H
+
+class ChunkManager;
+
+// Axis-aligned box in render space (Player coordinates). For collision a
+// block (bx, by, bz) fills x in [bx - 0.5, bx + 0.5], y in [by, by + 1]
+// and render z in [-bz - 0.5, -bz + 0.5].
+struct CollisionBox {
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+};
+
+struct BoxSweepResult {
+    float moveX = 0.0f, moveY = 0.0f, moveZ = 0.0f;  // Movement actually made
+    bool blockedX = false, blockedY = false, blockedZ = false;
+    bool touchedUnloaded = false;  // Some block the sweep read is in a chunk that isn't loaded
+};
+
+// Moves box by (moveX, moveY, moveZ) one axis at a time (Y, then X, then
+// Z), stopping each axis exactly at contact with the first solid block in
+// its path. Only blocks the swept box overlaps are read, so any distance
+// can be covered in one call without tunneling. Blocks the box already
+// overlaps are ignored rather than pushed out of. Unloaded chunks are
+// air; touchedUnloaded says the result may be wrong because of one.
+BoxSweepResult sweepBox(const ChunkManager& chunkManager, const CollisionBox& box,
+    float moveX, float moveY, float moveZ);
+
+#endif
@@ -2,7 +2,8 @@
 #define CHUNK_H
 
 #include "Block.h"
-#include <glad/glad.h>
+#include "RingQueue.h"
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -12,56 +13,91 @@ constexpr int CHUNK_SIZE_Y = 256;
 constexpr int CHUNK_SIZE_Z = 16;
 constexpr int MAX_HEIGHT = 256;
 
+// Neighbor directions: 0=North (+z), 1=South, 2=East (+x), 3=West,
+// 4=NorthEast, 5=NorthWest, 6=SouthEast, 7=SouthWest
+constexpr int NEIGHBOR_COUNT = 8;
+constexpr int NEIGHBOR_DX[NEIGHBOR_COUNT] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+constexpr int NEIGHBOR_DZ[NEIGHBOR_COUNT] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+
+constexpr int oppositeNeighbor(int direction) {
+    return direction < 4 ? direction ^ 1 : 11 - direction;
+}
+
+// Lifecycle of a chunk from generation to a renderable mesh
+enum class ChunkState {
+    Generated,       // Terrain and saved modifications in place (worker)
+    Lit,             // Intra-chunk sky and block light computed (worker)
+    NeighborsReady,  // All eight neighbors loaded, border light exchanged (main thread)
+    Meshed           // Mesh built from the complete 3x3 neighborhood (main thread)
+};
+
+// CPU half of a chunk mesh (one per block type): interleaved vertices of
+// CHUNK_VERTEX_FLOATS floats each (position, uv, normal, sky light,
+// RGB block light, AO) and triangle indices
+constexpr int CHUNK_VERTEX_FLOATS = 13;
+
+struct ChunkMeshBuffers {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    unsigned int vertexCount = 0;
+};
+
 class Chunk {
 public:
     int chunkX, chunkZ;
 
     Chunk(int chunkX, int chunkZ);
-    ~Chunk();
 
     // Block access
     Block getBlock(int x, int y, int z) const;
     Block getBlockWorld(int worldX, int worldY, int worldZ) const;
-    void setBlock(int x, int y, int z, BlockType type);
+    void setBlock(int x, int y, int z, BlockType type, unsigned char fluidLevel = FLUID_SOURCE);
 
     // Neighbor management
     void setNeighbor(int direction, Chunk* neighbor);
     Chunk* getNeighbor(int direction) const;
+    bool hasAllNeighbors() const;  // All eight, diagonals included
 
-    // Rendering
-    void buildMesh();
-    void render();
-    void renderType(BlockType type);
+    // Meshing (CPU only; ChunkRenderer uploads the result)
+    void buildMeshData(std::map<BlockType, ChunkMeshBuffers>& buffers) const;
 
     // Lighting functions
-    void calculateSkyLight(unsigned char maxSkyLight = 15);
-    void propagateSkyLight();  // Internal propagation (LOCAL coords, handles Y-axis)
-    void propagateSkyLightFloodFill();  // Cross-chunk propagation (WORLD coords, X/Z only)
-    void setBlockWorldLight(int worldX, int worldY, int worldZ, unsigned char lightLevel);
+    void calculateSkyLight(unsigned char maxSkyLight = 15);  // LOCAL coords; borders are handled by LightEngine
+    void calculateBlockLight();  // RGB emitters, LOCAL coords
     void updateSkyLightLevel(unsigned char newMaxSkyLight);
     unsigned char getSkyLight(int x, int y, int z) const;
 
-    // GPU 3D texture for skylight (optional, may not be used)
-    GLuint lightTexture = 0;
-    void initializeLightTexture();
-
     // Public access to blocks for direct neighbor updates
     Block blocks[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
 
-private:
-    Chunk* neighbors[4];  // 0=North, 1=South, 2=East, 3=West
+    // Per column: y of the highest opaque block + 1 (0 = no opaque block).
+    // Maintained by setBlock; call recalculateHeightMap after writing
+    // blocks directly.
+    short heightMap[CHUNK_SIZE_X][CHUNK_SIZE_Z];
+    void recalculateHeightMap();
+    int getHeight(int x, int z) const { return heightMap[x][z]; }
 
-    struct MeshData {
-        unsigned int VAO = 0;
-        unsigned int VBO = 0;
-        unsigned int EBO = 0;
-        unsigned int indexCount = 0;
-    };
+    // Local indices (packed xxxx yyyyyyyy zzzz) of the blocks that take
+    // block ticks, collected by the worker so the owner thread can
+    // schedule them when the chunk links without scanning every block.
+    // Not maintained by setBlock: only valid until the chunk is linked.
+    std::vector<uint16_t> tickingBlocks;
+    void collectTickingBlocks();
 
-    std::map<BlockType, MeshData> meshes;
+    // Set when restored from ChunkCache: blocks already include saved
+    // modifications, so workers only relight it
+    bool restoredFromCache = false;
+
+    ChunkState state = ChunkState::Generated;
+
+private:
+    Chunk* neighbors[NEIGHBOR_COUNT];  // See NEIGHBOR_DX / NEIGHBOR_DZ
 
-    void setupMesh(MeshData& mesh, const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
-    void buildMeshForType(BlockType type);
+    void propagateSkyLight(RingQueue<uint16_t>& lightQueue);
+    void spreadSkyLight(RingQueue<uint16_t>& lightQueue, int x, int y, int z, unsigned char level);
+    void spreadBlockLight(RingQueue<uint16_t>& lightQueue, int x, int y, int z, unsigned short light);
+    const Chunk* neighborAt(int dx, int dz) const;  // dx, dz in -1..1 (0, 0 = this chunk)
+    void gatherNeighborhood(std::vector<Block>& padded) const;
 };
 
 #endif
\ No newline at end of file
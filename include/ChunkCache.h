@@ -0,0 +1,66 @@
+#ifndef CHUNK_CACHE_H
+#define CHUNK_CACHE_H
+
+#include "Chunk.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Bounded (by bytes) LRU cache of recently unloaded chunks.
+// Chunks are stored run-length encoded (block type and fluid level) so
+// that walking back and forth across the unload boundary restores them
+// instead of regenerating them and replaying their saved edits. Light is
+// not kept: part of it came in across borders from neighbors that may
+// have changed or unloaded since, so restored chunks are relit.
+class ChunkCache {
+public:
+    struct Stats {
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        unsigned long long evictions = 0;
+        size_t bytesUsed = 0;
+        size_t entryCount = 0;
+
+        float hitRate() const {
+            unsigned long long lookups = hits + misses;
+            return lookups ? static_cast<float>(hits) / static_cast<float>(lookups) : 0.0f;
+        }
+    };
+
+    explicit ChunkCache(size_t maxBytes);
+
+    // Compress and store a copy of the chunk (replaces any older entry)
+    void store(const Chunk& chunk);
+
+    // Remove the entry and decompress it into a new Chunk (caller owns it)
+    // with its height map rebuilt but no light. Returns nullptr on a miss.
+    Chunk* take(int chunkX, int chunkZ);
+
+    void clear();
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Run {
+        uint8_t type;
+        uint8_t fluidLevel;
+        uint16_t length;
+    };
+
+    struct Entry {
+        long long key;
+        std::vector<Run> runs;
+        size_t bytes() const { return sizeof(Entry) + runs.capacity() * sizeof(Run); }
+    };
+
+    long long makeKey(int x, int z) const;
+    void evictUntilFits(size_t incoming);
+
+    size_t maxBytes;
+    std::list<Entry> lru;  // Front = most recently stored
+    std::unordered_map<long long, std::list<Entry>::iterator> index;
+    Stats stats;
+};
+
+#endif
@@ -1,28 +1,72 @@
 #pragma once
 #include "Chunk.h"
-#include "TerrainGenerator.h"
-#include "WorldSave.h"
+#include "ChunkPipeline.h"
+#include "IntegrationProfile.h"
+#include "BlockTicks.h"
 #include <unordered_map>
 #include <unordered_set>
-#include <queue>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
+#include <chrono>
 #include <climits>
 #include <cmath>
+#include <map>
+#include <optional>
+#include <utility>
 #include <vector>
 
-// Hash for std::pair<int,int> to use in unordered_set/map
-struct pair_hash {
-    std::size_t operator()(const std::pair<int, int>& p) const noexcept {
-        return std::hash<int>()(p.first) ^ (std::hash<int>()(p.second) << 1);
+// "Time until visible hole-free view": how long the chunks inside the
+// view frustum stay incomplete after the player moves or turns
+struct ViewCompletionStats {
+    int missingVisible = 0;     // Visible chunks in range that are not meshed yet
+    float lastMs = 0.0f;
+    float worstMs = 0.0f;
+    float totalMs = 0.0f;
+    unsigned int completions = 0;
+
+    float averageMs() const { return completions ? totalMs / completions : 0.0f; }
+};
+
+// CPU mesh data waiting to be uploaded by the renderer (latest per chunk)
+struct ChunkMeshUpdate {
+    int chunkX = 0;
+    int chunkZ = 0;
+    bool removed = false;  // Chunk was unloaded: drop its mesh
+    std::map<BlockType, ChunkMeshBuffers> buffers;
+};
+
+// Mesh builds per integrated chunk: 1.0 means every chunk was meshed
+// exactly once; rebuilds come from late light and block edits
+struct MeshStats {
+    unsigned long long chunksLoaded = 0;
+    unsigned long long initialBuilds = 0;
+    unsigned long long rebuilds = 0;
+
+    float buildsPerLoad() const {
+        return chunksLoaded ? static_cast<float>(initialBuilds + rebuilds) / chunksLoaded : 0.0f;
     }
 };
 
-struct ChunkDistanceEntry {
-    int x;
-    int z;
-    int distSq;
+// Box of blocks copied out by ChunkManager::getBlocksInRegion, laid out
+// like Chunk::blocks ([x][y][z], z fastest). Blocks in unloaded chunks or
+// outside 0..CHUNK_SIZE_Y-1 read as AIR; missingChunks tells the former
+// apart from real air.
+struct BlockRegion {
+    int minX = 0, minY = 0, minZ = 0;
+    int sizeX = 0, sizeY = 0, sizeZ = 0;
+    std::vector<Block> blocks;
+    bool missingChunks = false;  // Part of the box is in a chunk that isn't loaded
+
+    bool contains(int worldX, int worldY, int worldZ) const {
+        return worldX >= minX && worldX < minX + sizeX
+            && worldY >= minY && worldY < minY + sizeY
+            && worldZ >= minZ && worldZ < minZ + sizeZ;
+    }
+
+    size_t indexOf(int worldX, int worldY, int worldZ) const {
+        return (static_cast<size_t>(worldX - minX) * sizeY + (worldY - minY)) * sizeZ + (worldZ - minZ);
+    }
+
+    // worldX/Y/Z must be inside the region
+    const Block& at(int worldX, int worldY, int worldZ) const { return blocks[indexOf(worldX, worldY, worldZ)]; }
 };
 
 class ChunkManager {
@@ -30,16 +74,38 @@ public:
     ChunkManager(int renderDistance, const std::string& worldName = "world1");
     ~ChunkManager();
 
-    void update(float playerX, float playerZ);
-    void render();
-    void renderType(BlockType type);
-    Block* getBlockAt(int worldX, int worldY, int worldZ);
+    // viewDirX/viewDirZ: camera front vector (render space), used to
+    // generate chunks in front of the player first
+    void update(float playerX, float playerZ, float viewDirX = 0.0f, float viewDirZ = 0.0f);
+
+    // Block queries. Main thread only and lock-free: the workers never
+    // touch loaded chunks. getBlockAt is empty when the chunk isn't loaded;
+    // getBlocksInRegion copies the inclusive box [min, max] in one pass.
+    std::optional<Block> getBlockAt(int worldX, int worldY, int worldZ) const;
+    void getBlocksInRegion(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockRegion& region) const;
     std::pair<int, int> worldToChunkCoords(float x, float z);
+    bool isChunkLoaded(int cx, int cz) const;
+    const Chunk* getChunk(int cx, int cz) const { return findChunk(cx, cz); }  // nullptr when not loaded
 
-    // Block modification methods
-    bool setBlockAt(int worldX, int worldY, int worldZ, BlockType type);
+    // Block modification methods. setBlockAt also schedules a block tick
+    // for the edited block and its six neighbors wherever their type has
+    // a tick delay (fluids), so they react to the change.
+    bool setBlockAt(int worldX, int worldY, int worldZ, BlockType type, unsigned char fluidLevel = FLUID_SOURCE);
     void rebuildChunkMeshAt(int worldX, int worldY, int worldZ);
 
+    // rebuildChunkMeshAt for many edits: queue every edited block, then
+    // flush once to remesh each affected chunk a single time. With a
+    // budget, chunks nearest the player go first until budgetMs is spent
+    // (at least one is remeshed); the rest stay queued for the next flush.
+    void queueMeshRebuildAt(int worldX, int worldZ);  // Remeshes whole columns, so no y
+    void flushMeshRebuilds();
+    void flushMeshRebuilds(float budgetMs);
+    size_t getQueuedMeshRebuildCount() const { return pendingMeshRebuilds.size(); }
+
+    // Scheduled block ticks. Pending ticks of unloaded chunks are dropped;
+    // integrating a chunk schedules its unsettled fluid again.
+    BlockTickScheduler& getBlockTicks() { return blockTicks; }
+
 	// Skylight level management
     void setGlobalSkyLightLevel(unsigned char level) { globalSkyLightLevel = level; }
 
@@ -48,11 +114,34 @@ public:
 
     unsigned char getGlobalSkyLightLevel() const { return globalSkyLightLevel; }
 
+    // Unloaded-chunk cache statistics (hit rate, bytes used)
+    const ChunkCache::Stats& getChunkCacheStats() const { return pipeline.getCacheStats(); }
+
+    // Generation queue counters (requested / completed / cancelled / wasted)
+    const GenerationStats& getGenerationStats() const { return pipeline.getStats(); }
+
+    // Player block changes, replayed into chunks as they generate
+    WorldSave& getWorldSave() { return pipeline.getWorldSave(); }
+
+    // Horizontal half field of view (radians) used to prioritize visible chunks
+    void setViewFrustum(float horizontalHalfFov) { viewHalfFov = horizontalHalfFov; }
+    const ViewCompletionStats& getViewCompletionStats() const { return viewCompletion; }
+
+    // Meshes built or dropped since the last call, for ChunkRenderer.
+    // Main thread only; leaves the internal list empty.
+    void takeMeshUpdates(std::vector<ChunkMeshUpdate>& updates);
+
+    // Mesh builds per chunk load
+    const MeshStats& getMeshStats() const { return meshStats; }
+
+    // Chunk integration budget and per-stage cost histogram
+    const IntegrationProfile& getIntegrationProfile() const { return integrationProfile; }
+    bool exportIntegrationProfile(const std::string& path) const;
+
 private:
     // =============================
-    // Threaded generation
+    // Integration (generation runs in ChunkPipeline)
     // =============================
-    void generationWorker();
     void processReadyChunks();
 
     // =============================
@@ -60,14 +149,22 @@ private:
     // =============================
     void updateDesiredChunks(int pcx, int pcz);
     void unloadDistantChunks(int pcx, int pcz);
-    void linkChunkNeighbors(Chunk* chunk);
-    bool isChunkLoaded(int cx, int cz);
-    void loadChunk(int cx, int cz);
+    void meshChunk(Chunk* chunk);  // Main thread; call once the chunk is NeighborsReady
+    bool isInLoadRange(int dx, int dz) const;  // Offset from the player's chunk
     void unloadChunk(int cx, int cz);
+    Chunk* findChunk(int cx, int cz) const;
+    Chunk* findChunkCached(int cx, int cz) const;  // findChunk with a one-entry cache
 
-    long long makeKey(int x, int z) const;
+    // =============================
+    // Generation priority
+    // =============================
+    float generationPriority(int cx, int cz) const;
+    void submitGenerationRequests();  // Re-keys the queue for the current position and view
+    bool isInViewFrustum(int dx, int dz) const;  // Offset from the player's chunk
+    void updatePlayerMotion(float playerX, float playerZ);
+    void updateViewCompletion();
 
-    std::unique_ptr<WorldSave> worldSave;
+    long long makeKey(int x, int z) const;
 
     int renderDistance;
     int renderDistanceSquared;
@@ -75,18 +172,54 @@ private:
     int lastPlayerChunkX;
     int lastPlayerChunkZ;
 
-    std::unordered_map<long long, Chunk*> chunks;           // Loaded chunks
-    std::mutex chunksMutex;
-
-    std::unordered_set<std::pair<int, int>, pair_hash> chunksBeingGenerated; // Prevent double queue
-    std::unordered_set<long long> queuedChunks;           // keys of queued chunks
-
-    std::queue<std::pair<int, int>> generationQueue;
-    std::queue<Chunk*> readyChunks;
-    std::mutex mutex;
-    std::condition_variable queueCV;
-    std::thread generationThread;
-    bool shouldStop;
+    // Generation, light and loaded chunks (main thread is the owner).
+    // Recently unloaded chunks are cached and consulted before generating.
+    static constexpr size_t CHUNK_CACHE_BYTES = 32 * 1024 * 1024;
+    ChunkPipeline pipeline;
+    mutable Chunk* lastQueriedChunk = nullptr;  // See findChunkCached
+
+    // Chunks touched by edits and relighting, waiting to be remeshed
+    std::unordered_set<Chunk*> pendingMeshRebuilds;  // From block edits, flushed by rebuildChunkMeshAt
+    std::unordered_set<Chunk*> relitChunks;          // Scratch for processReadyChunks
+    std::vector<Chunk*> readyToMesh;                 // Scratch: reached NeighborsReady this chunk
+    std::vector<Chunk*> meshRebuildOrder;            // Scratch for flushMeshRebuilds
+    float averageRebuildMs = 0.0f;                   // Smoothed cost of one rebuild, to stop before the budget runs out
+    std::unordered_map<long long, ChunkMeshUpdate> meshUpdates;  // Main thread; drained by takeMeshUpdates
+
+    BlockTickScheduler blockTicks;  // Main thread only
+    void scheduleTicksAround(int worldX, int worldY, int worldZ);
+    void scheduleFluidTicks(Chunk* chunk);  // Newly linked chunk and the neighbor edges facing it
+    void scheduleIfUnsettled(int worldX, int worldY, int worldZ, const Block& block);
+
+    MeshStats meshStats;  // Main thread only
+
+    // Time-budgeted integration
+    IntegrationProfile integrationProfile;
+    std::chrono::steady_clock::time_point lastIntegrationFrame;
+    bool hasIntegrationFrame = false;
+
+    // View direction in chunk space (+Z = north), normalized on XZ
+    float viewDirX = 0.0f;
+    float viewDirZ = 0.0f;
+    float prioritizedDirX = 0.0f;  // Direction the queue was last sorted for
+    float prioritizedDirZ = 0.0f;
+    float viewHalfFov = 0.9f;
+
+    // Smoothed player velocity in chunks/second (chunk space)
+    float velocityX = 0.0f;
+    float velocityZ = 0.0f;
+    float lastPlayerX = 0.0f;
+    float lastPlayerZ = 0.0f;
+    std::chrono::steady_clock::time_point lastUpdateTime;
+    bool hasLastUpdate = false;
+
+    ViewCompletionStats viewCompletion;
+    std::chrono::steady_clock::time_point viewIncompleteSince;
+    bool viewIncomplete = false;
+
+    static constexpr float OUTSIDE_FRUSTUM_WEIGHT = 1.5f;   // Chunks directly behind cost 4x their distance
+    static constexpr float REPRIORITIZE_VIEW_COS = 0.87f;   // Re-sort after turning ~30 degrees
+    static constexpr float PREDICTION_SECONDS = 1.5f;       // How far ahead to aim loading
 
     // Skylight level management
     unsigned char globalSkyLightLevel = 15;
@@ -0,0 +1,149 @@
+#ifndef CHUNK_PIPELINE_H
+#define CHUNK_PIPELINE_H
+
+#include "Chunk.h"
+#include "ChunkCache.h"
+#include "LightEngine.h"
+#include "MPSCQueue.h"
+#include "WorldSave.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct GenerationRequest {
+    int x;
+    int z;
+    float priority;             // Lower = generated sooner
+    Chunk* restored = nullptr;  // Taken from the cache: only needs relighting
+};
+
+// Max-heap comparator that keeps the lowest priority value on top
+struct GenerationRequestCompare {
+    bool operator()(const GenerationRequest& a, const GenerationRequest& b) const {
+        return a.priority > b.priority;
+    }
+};
+
+struct GenerationStats {
+    unsigned long long requested = 0;
+    unsigned long long completed = 0;
+    unsigned long long cancelled = 0;  // Dropped from the queue after leaving render distance
+    unsigned long long wasted = 0;     // Generated, but out of range by the time it was integrated
+    unsigned long long restored = 0;   // Taken from the unloaded-chunk cache instead
+    unsigned long long unloaded = 0;
+};
+
+// Chunk streaming shared by ChunkManager (client) and ServerWorld
+// (dedicated server). Workers generate a chunk and replay its saved edits
+// (or take it as restored from the cache) and light it on its own (Lit); the owner thread pops it, links it to its
+// loaded neighbors and, once a chunk's whole 3x3 neighborhood is linked,
+// exchanges border light with it exactly once (NeighborsReady). What
+// happens after that (meshing, serving) is up to the owner.
+//
+// Loaded chunks are only ever touched by the owner thread; workers see
+// nothing but their own new chunk, so block queries need no locking.
+class ChunkPipeline {
+public:
+    // Generation priority for a queued chunk (lower = sooner); negative
+    // means nobody wants it any more
+    using PriorityFunction = std::function<float(int chunkX, int chunkZ)>;
+
+    ChunkPipeline(const std::string& worldName, size_t cacheBytes, unsigned int workerCount);
+    ~ChunkPipeline();
+
+    ChunkPipeline(const ChunkPipeline&) = delete;
+    ChunkPipeline& operator=(const ChunkPipeline&) = delete;
+
+    // =============================
+    // Requests (owner thread)
+    // =============================
+    // Adds the chunk to the next submitRequests, restored from the cache
+    // when it is there. False when it is already loaded or on its way.
+    bool request(int chunkX, int chunkZ);
+
+    // Re-keys every queued request with priority, cancels the unwanted
+    // ones, queues the requests made since the last call and wakes the
+    // workers
+    void submitRequests(const PriorityFunction& priority);
+
+    // =============================
+    // Integration (owner thread)
+    // =============================
+    // Next Lit chunk from a worker, or nullptr. It is not in the world
+    // yet: pass it to insert or discard.
+    Chunk* popReady();
+    void discard(Chunk* chunk);  // No longer wanted; cached chunks go back to the cache
+
+    // Adds the chunk to the world and links it with its loaded neighbors
+    void insert(Chunk* chunk);
+
+    // Lit -> NeighborsReady for the chunk and every neighbor whose 3x3
+    // neighborhood it completed. Those are appended to becameReady;
+    // chunks whose stored light changed go into relit.
+    void exchangeBorderLight(Chunk* chunk, std::unordered_set<Chunk*>& relit, std::vector<Chunk*>& becameReady);
+
+    // Unlinks the chunk, stores it in the cache and deletes it
+    void unload(Chunk* chunk);
+
+    // Edits a loaded block, relights incrementally (chunks whose light
+    // changed go into relit) and records the edit in the save. Returns
+    // the replaced block, or nothing when the chunk isn't loaded.
+    std::optional<Block> setBlock(int worldX, int worldY, int worldZ, BlockType type, unsigned char fluidLevel,
+        std::unordered_set<Chunk*>& relit);
+
+    // =============================
+    // Queries (owner thread)
+    // =============================
+    Chunk* findChunk(int chunkX, int chunkZ) const;
+    std::optional<Block> getBlock(int worldX, int worldY, int worldZ) const;
+    const std::unordered_map<long long, Chunk*>& getChunks() const { return chunks; }
+    size_t getQueuedCount() const { return queuedChunks.size(); }  // Queued, generating or waiting in popReady
+
+    WorldSave& getWorldSave() { return *worldSave; }
+    const ChunkCache::Stats& getCacheStats() const { return chunkCache.getStats(); }
+    const GenerationStats& getStats() const { return stats; }
+
+    // Render distance plus a one-chunk ring: every chunk inside the
+    // render distance needs its eight neighbors loaded before it is ready
+    static bool isInLoadRange(int dx, int dz, int renderDistance);
+    static long long makeKey(int x, int z);
+
+private:
+    void generationWorker();
+    void cancel(const GenerationRequest& request);  // Under generationMutex
+    void updateReadiness(Chunk* chunk, std::unordered_set<Chunk*>& relit, std::vector<Chunk*>& becameReady);
+
+    std::unique_ptr<WorldSave> worldSave;
+    ChunkCache chunkCache;
+    LightEngine lightEngine;
+
+    std::unordered_map<long long, Chunk*> chunks;  // Loaded chunks; owner thread only
+    std::unordered_set<long long> queuedChunks;    // Owner thread: requested, not popped yet
+    std::vector<GenerationRequest> newRequests;    // Owner thread: for the next submitRequests
+
+    // Work queue: workers contend only with each other here; the owner
+    // touches it only in submitRequests
+    std::vector<GenerationRequest> generationQueue;  // Heap ordered by GenerationRequestCompare
+    std::mutex generationMutex;
+    std::condition_variable queueCV;
+    std::vector<std::thread> workers;
+    std::atomic<bool> shouldStop{ false };  // Set under generationMutex
+
+    // Completed chunks, handed from workers to the owner without locking.
+    // Bounded: when the owner falls this far behind, workers wait rather
+    // than pile up more finished chunks.
+    static constexpr size_t READY_CAPACITY = 256;
+    MPSCQueue<Chunk*> readyChunks{ READY_CAPACITY };
+
+    GenerationStats stats;  // Owner thread only
+};
+
+#endif
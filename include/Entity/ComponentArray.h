@@ -0,0 +1,65 @@
+#ifndef COMPONENT_ARRAY_H
+#define COMPONENT_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sparse set of components of one type, keyed by entity index.
+// Components live packed in one dense array (no per-entity allocation),
+// so systems iterate them linearly; sparse maps an entity index to its
+// slot. Removal swaps the last component into the hole, which keeps the
+// array dense but changes the order.
+template <typename T>
+class ComponentArray {
+public:
+    // Adds or replaces
+    T& add(uint32_t entity, const T& value) {
+        if (has(entity)) {
+            return dense[sparse[entity]] = value;
+        }
+
+        if (entity >= sparse.size()) sparse.resize(entity + 1, INVALID);
+        sparse[entity] = static_cast<uint32_t>(dense.size());
+        denseEntities.push_back(entity);
+        dense.push_back(value);
+        return dense.back();
+    }
+
+    void remove(uint32_t entity) {
+        if (!has(entity)) return;
+
+        uint32_t slot = sparse[entity];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (slot != last) {
+            dense[slot] = dense[last];
+            denseEntities[slot] = denseEntities[last];
+            sparse[denseEntities[slot]] = slot;
+        }
+        dense.pop_back();
+        denseEntities.pop_back();
+        sparse[entity] = INVALID;
+    }
+
+    bool has(uint32_t entity) const {
+        return entity < sparse.size() && sparse[entity] != INVALID;
+    }
+
+    T* get(uint32_t entity) { return has(entity) ? &dense[sparse[entity]] : nullptr; }
+    const T* get(uint32_t entity) const { return has(entity) ? &dense[sparse[entity]] : nullptr; }
+
+    // Dense access: component i belongs to entity entityAt(i)
+    size_t size() const { return dense.size(); }
+    T& at(size_t i) { return dense[i]; }
+    const T& at(size_t i) const { return dense[i]; }
+    uint32_t entityAt(size_t i) const { return denseEntities[i]; }
+
+private:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    std::vector<uint32_t> sparse;         // Entity index -> slot in dense, or INVALID
+    std::vector<uint32_t> denseEntities;  // Slot -> entity index
+    std::vector<T> dense;
+};
+
+#endif
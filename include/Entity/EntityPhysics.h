@@ -0,0 +1,48 @@
+#ifndef ENTITY_PHYSICS_H
+#define ENTITY_PHYSICS_H
+
+#include "Entity/EntityWorld.h"
+#include <utility>
+#include <vector>
+
+class ChunkManager;
+
+// Gravity and swept box collision (sweepBox, same as Player) for every
+// entity with a Transform, Velocity and PhysicsBody that is registered in
+// EntityWorld::spatial. Entities are simulated a chunk at a time, as the
+// spatial hash groups them, so block lookups stay in one chunk. Entities
+// in a chunk that isn't loaded, or whose move would read blocks from
+// one, are frozen rather than falling into the missing terrain. Moved
+// entities are updated in the hash.
+class EntityPhysics {
+public:
+    // One fixed tick (see FixedTimestep)
+    void update(EntityWorld& world, const ChunkManager& chunkManager, float tickSeconds);
+
+    size_t getSimulatedCount() const { return simulatedCount; }
+    size_t getFrozenCount() const { return frozenCount; }
+
+private:
+    // One occupied chunk's entities in chunkOrder, before anything moved
+    struct ChunkSpan {
+        int chunkX, chunkZ;
+        size_t begin, end;
+    };
+
+    void collectChunks(const EntityWorld& world);
+
+    // Scratch, kept across ticks for its capacity
+    std::vector<std::pair<int, int>> occupiedChunks;
+    std::vector<ChunkSpan> chunkSpans;
+    std::vector<uint32_t> chunkOrder;
+    std::vector<uint32_t> chunkEntities;
+
+    size_t simulatedCount = 0;
+    size_t frozenCount = 0;
+
+    static constexpr float GRAVITY = -32.0f;
+    static constexpr float MAX_FALL_SPEED = -78.4f;
+    static constexpr float DRAG = 0.91f;  // Horizontal, per tick
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef ENTITY_STORAGE_H
+#define ENTITY_STORAGE_H
+
+#include "Entity/EntityWorld.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ChunkManager;
+
+// Entities whose chunk is not loaded, serialized out of EntityWorld and
+// recreated when the chunk loads again. Stored chunks are saved to
+// SavedData/<world>/entities.dat alongside WorldSave's block changes.
+// Restored entities get new handles; handles to the stored ones go stale.
+class EntityStorage {
+public:
+    explicit EntityStorage(const std::string& worldName);
+    ~EntityStorage();
+
+    // Once per tick, after ChunkManager::update. Uses EntityWorld::spatial
+    // to find the chunks that hold entities.
+    void update(EntityWorld& world, const ChunkManager& chunkManager);
+
+    // Serializes every entity (before exit, so flush saves them too)
+    void storeAll(EntityWorld& world);
+
+    size_t getStoredChunkCount() const { return storedChunks.size(); }
+    size_t getStoredEntityCount() const { return storedEntities; }
+
+    // Entities stored and restored since construction
+    size_t getTotalStored() const { return totalStored; }
+    size_t getTotalRestored() const { return totalRestored; }
+
+    void flush();
+
+private:
+    // One entity: its components, flagged by presence
+    struct StoredEntity {
+        static constexpr unsigned char HAS_VELOCITY = 1;
+        static constexpr unsigned char HAS_BODY = 2;
+
+        unsigned char components = 0;
+        Transform transform;
+        Velocity velocity;
+        PhysicsBody body;
+    };
+
+    void storeChunk(EntityWorld& world, int chunkX, int chunkZ);
+    void restoreChunk(EntityWorld& world, const std::vector<StoredEntity>& entities);
+
+    long long makeKey(int x, int z) const;
+    std::string getSaveFilePath();
+    void loadFromDisk();
+    void saveToDisk();
+
+    std::string worldName;
+    std::unordered_map<long long, std::vector<StoredEntity>> storedChunks;
+    size_t storedEntities = 0;
+    size_t totalStored = 0;
+    size_t totalRestored = 0;
+    bool isDirty = false;
+
+    // Scratch
+    std::vector<std::pair<int, int>> occupiedChunks;
+    std::vector<uint32_t> chunkEntities;
+    std::vector<long long> restoredKeys;
+
+    static constexpr int FILE_VERSION = 1;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef ENTITY_WORLD_H
+#define ENTITY_WORLD_H
+
+#include "Entity/ComponentArray.h"
+#include "Entity/SpatialHash.h"
+#include <cstdint>
+#include <vector>
+
+// Refers to an entity without owning it. The generation changes every
+// time an index is reused, so a handle to a destroyed entity stays
+// invalid instead of silently pointing at whatever took its slot.
+struct EntityHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// =============================
+// Components
+// =============================
+// Render space, like Player (y at the feet)
+struct Transform {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    float previousX = 0.0f, previousY = 0.0f, previousZ = 0.0f;  // Last tick, for interpolation
+};
+
+struct Velocity {
+    float x = 0.0f, y = 0.0f, z = 0.0f;  // Blocks per second
+};
+
+// Box collider simulated by EntityPhysics
+struct PhysicsBody {
+    float halfWidth = 0.3f;
+    float height = 1.8f;
+    bool onGround = false;
+    bool blockedHorizontally = false;  // Ran into a wall last tick
+};
+
+// Entity store: allocates generational handles and owns one dense
+// ComponentArray per component type, plus the spatial hash of entity
+// positions (kept current by EntityPhysics; whoever places an entity
+// registers it). Main thread only.
+class EntityWorld {
+public:
+    EntityHandle create();
+    void destroy(EntityHandle entity);  // Removes every component
+    bool isAlive(EntityHandle entity) const;
+
+    // Handle for a live index taken from a component array
+    EntityHandle handleOf(uint32_t index) const { return { index, generations[index] }; }
+
+    size_t getAliveCount() const { return aliveCount; }
+
+    ComponentArray<Transform> transforms;
+    ComponentArray<Velocity> velocities;
+    ComponentArray<PhysicsBody> bodies;
+
+    SpatialHash spatial;
+
+private:
+    std::vector<uint32_t> generations;   // Per index; odd = alive
+    std::vector<uint32_t> freeIndices;
+    size_t aliveCount = 0;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "BoxCollision.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Broad phase for entity-vs-entity queries: a uniform grid of
+// CELL_SIZE x CELL_SIZE block columns hashed by cell coordinates.
+// Cells tile chunks exactly, so a chunk is CELLS_PER_CHUNK^2 cells and
+// the hash also answers "which entities are in this chunk". Each cell
+// keeps its entities' positions inline, so a query never touches the
+// component arrays. Columns span the whole world height; y is tested per
+// entity. Positions are render space, like Transform.
+class SpatialHash {
+public:
+    static constexpr int CELL_SIZE = 4;  // Blocks; divides the chunk size
+    static constexpr int CELLS_PER_CHUNK = 16 / CELL_SIZE;
+
+    // Registers the entity or moves it to a new position. Cheap when it
+    // stays in its cell; call after every move.
+    void update(uint32_t entity, float x, float y, float z);
+    void remove(uint32_t entity);
+    bool contains(uint32_t entity) const;
+
+    // Queries replace the contents of out with entity indices, in no
+    // particular order. Boundaries are inclusive.
+    void queryRadius(float x, float y, float z, float radius, std::vector<uint32_t>& out) const;
+    void queryBox(const CollisionBox& box, std::vector<uint32_t>& out) const;
+    void queryChunk(int chunkX, int chunkZ, std::vector<uint32_t>& out) const;
+
+    // Chunks with at least one registered entity
+    void getOccupiedChunks(std::vector<std::pair<int, int>>& out) const;
+
+    size_t size() const { return count; }
+    size_t getCellCount() const { return cells.size(); }
+
+private:
+    struct Point {
+        uint32_t entity;
+        float x, y, z;
+    };
+
+    struct Location {
+        long long cell = 0;
+        uint32_t slot = INVALID;  // Index in the cell's points, or INVALID
+    };
+
+    template <typename Fn>
+    void forEachPointInBox(const CollisionBox& box, Fn&& fn) const;
+
+    void removeFromCell(const Location& location);
+
+    static int cellCoord(float blockSpace);
+    static int floorDiv(int value, int divisor);
+    static long long makeKey(int x, int z);
+
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    std::unordered_map<long long, std::vector<Point>> cells;
+    std::vector<Location> locations;                  // Per entity index
+    std::unordered_map<long long, uint32_t> chunkCounts;  // Entities per occupied chunk
+    size_t count = 0;
+};
+
+#endif
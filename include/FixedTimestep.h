@@ -0,0 +1,31 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+// Fixed-rate simulation clock. Each frame adds its real duration; the
+// clock says how many whole ticks to run, and the leftover fraction of a
+// tick is the factor for interpolating what is drawn between the last two
+// ticks. Simulation results therefore don't depend on the frame rate.
+class FixedTimestep {
+public:
+    // maxTicksPerFrame bounds the catch-up work after a long frame; time
+    // beyond it is dropped (the game slows down instead of stalling)
+    FixedTimestep(int ticksPerSecond, int maxTicksPerFrame);
+
+    // Returns the number of ticks to run for a frame of frameSeconds
+    int advance(float frameSeconds);
+
+    float getTickSeconds() const { return tickSeconds; }
+    float getAlpha() const { return accumulator / tickSeconds; }  // 0..1 since the last tick
+    unsigned long long getTickCount() const { return tickCount; }
+    float getDroppedSeconds() const { return droppedSeconds; }
+
+private:
+    float tickSeconds;
+    int maxTicksPerFrame;
+
+    float accumulator = 0.0f;
+    unsigned long long tickCount = 0;
+    float droppedSeconds = 0.0f;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef FLUID_SIMULATION_H
+#define FLUID_SIMULATION_H
+
+#include "Block.h"
+#include "BlockTicks.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Chunk;
+class ChunkManager;
+
+// Water and lava flow, run on the scheduled block ticks of ChunkManager
+// (fluid types have a tickDelay, so any change next to a fluid wakes it).
+//
+// Each game tick is computed in two phases:
+//   1. Every due tick reads the world as it was at the start of the tick
+//      and proposes block changes. Due chunks are grouped into regions of
+//      REGION_SIZE x REGION_SIZE chunks, and regions are shared out to
+//      worker threads (the world is not written during this phase).
+//   2. On the main thread, proposals for the same block are resolved by a
+//      fixed rule (see strongerChange) and applied through setBlockAt,
+//      which relights, saves and schedules the next ticks.
+// The result never depends on the thread count or on which worker took
+// which region.
+class FluidSimulation {
+public:
+    // threadCount includes the calling thread; 0 = same as chunk generation
+    explicit FluidSimulation(unsigned int threadCount = 0);
+    ~FluidSimulation();
+
+    FluidSimulation(const FluidSimulation&) = delete;
+    FluidSimulation& operator=(const FluidSimulation&) = delete;
+
+    // One game tick (see FixedTimestep). Main thread. Changed blocks are
+    // queued for remeshing; the caller flushes (ChunkManager::
+    // flushMeshRebuilds) once per frame rather than once per tick.
+    void update(ChunkManager& chunkManager);
+
+    size_t getLastTickCount() const { return lastTickCount; }      // Block ticks run in the last update
+    size_t getLastChangeCount() const { return lastChangeCount; }  // Blocks changed by the last update
+    unsigned long long getTotalTicks() const { return totalTicks; }
+    unsigned long long getTotalChanges() const { return totalChanges; }
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+private:
+    struct BlockChange {
+        int x, y, z;
+        BlockType type;
+        unsigned char fluidLevel;
+    };
+
+    struct RegionJob {
+        std::vector<size_t> chunks;  // Indices into due / dueChunks
+        std::vector<BlockChange> changes;
+    };
+
+    static constexpr int REGION_SIZE = 2;  // Chunks per side
+
+    static void tickBlock(const Chunk& chunk, const BlockTick& tick, std::vector<BlockChange>& changes);
+    static bool strongerChange(const BlockChange& a, const BlockChange& b);
+
+    void buildJobs();
+    void simulateRegion(RegionJob& job);
+    void runJobs();
+    void runQueuedJobs();
+    void workerLoop();
+
+    // Scratch, reused every update
+    std::vector<ChunkTicks> due;
+    std::vector<const Chunk*> dueChunks;  // Parallel to due
+    std::vector<RegionJob> jobs;
+    size_t jobCount = 0;
+    std::vector<BlockChange> merged;
+
+    // Fork-join pool: update() hands out jobs and works alongside
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    uint64_t jobBatch = 0;        // Bumped for every run of jobs
+    unsigned int busyWorkers = 0;
+    bool shouldStop = false;
+    std::atomic<size_t> nextJob{ 0 };
+
+    size_t lastTickCount = 0;
+    size_t lastChangeCount = 0;
+    unsigned long long totalTicks = 0;
+    unsigned long long totalChanges = 0;
+};
+
+#endif
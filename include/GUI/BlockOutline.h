@@ -4,6 +4,7 @@
 
 class Camera;
 class ChunkManager;
+struct BlockRaycastHit;
 
 class BlockOutline {
 public:
@@ -12,9 +13,11 @@ public:
 
     void initialize();
 
+    // target: this frame's BlockInteraction target; nothing is drawn if null
     void render(
         Camera& camera,
         ChunkManager* chunkManager,
+        const BlockRaycastHit* target,
         float* viewMatrix,
         float* projectionMatrix
     );
@@ -24,15 +27,6 @@ private:
     unsigned int VBO;
     unsigned int shaderProgram;
 
-    int selectedBlockX;
-    int selectedBlockY;
-    int selectedBlockZ;
-
-    int hitFace;
-    bool hasSelection;
-
     void setupMesh();
     unsigned int createShader();
-
-    bool raycastBlock(Camera& camera, ChunkManager* chunkManager);
 };
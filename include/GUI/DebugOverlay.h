@@ -3,6 +3,7 @@
 
 // Forward declaration
 class ChunkManager;
+struct BlockRaycastHit;
 
 struct CharInfo {
     float x0, y0, x1, y1;
@@ -19,7 +20,8 @@ public:
     void render(int windowWidth, int windowHeight,
         float posX, float posY, float posZ,
         float yaw, float fps, float timeOfDay,
-        ChunkManager* chunkManager);  // ADDED chunkManager parameter
+        ChunkManager* chunkManager,  // ADDED chunkManager parameter
+        const BlockRaycastHit* target);  // Block under the crosshair, if any
 
 private:
     bool enabled;
@@ -0,0 +1,63 @@
+#ifndef INTEGRATION_PROFILE_H
+#define INTEGRATION_PROFILE_H
+
+#include <string>
+
+// Stages of integrating a ready chunk on the main thread (modification
+// replay and intra-chunk lighting already ran on the generation worker)
+enum class IntegrationStage {
+    Linking = 0,
+    BorderLight,
+    Meshing,
+    Count
+};
+
+// Per-frame time budget and cost tracking for chunk integration.
+// The budget adapts to how much of the target frame time the rest of the
+// frame leaves free; per-stage costs are tracked both as a moving average
+// per chunk and as a histogram of per-frame contributions.
+class IntegrationProfile {
+public:
+    static constexpr int STAGE_COUNT = static_cast<int>(IntegrationStage::Count);
+    static constexpr int BUCKET_COUNT = 9;
+
+    // frameMs: duration of the previous frame. Returns this frame's budget.
+    float beginFrame(float frameMs);
+    void addStageTime(IntegrationStage stage, float ms);
+    void chunkIntegrated();
+    void endFrame();
+
+    // Expected cost of integrating one more chunk
+    float estimatedChunkMs() const { return averageChunkMs; }
+    float getBudgetMs() const { return budgetMs; }
+    float getAverageStageMs(IntegrationStage stage) const { return averageStageMs[static_cast<int>(stage)]; }
+
+    // CSV: one row per stage (plus total), one column per histogram bucket
+    bool exportCSV(const std::string& path) const;
+
+private:
+    static constexpr float TARGET_FRAME_MS = 1000.0f / 60.0f;
+    static constexpr float MIN_BUDGET_MS = 0.5f;
+    static constexpr float MAX_BUDGET_MS = 8.0f;
+    static const float bucketLimitsMs[BUCKET_COUNT - 1];
+
+    static int bucketFor(float ms);
+
+    float budgetMs = 4.0f;
+    float averageChunkMs = 2.0f;
+    float averageStageMs[STAGE_COUNT] = {};
+
+    // Current frame / current chunk accumulators
+    float frameStageMs[STAGE_COUNT] = {};
+    float chunkStageMs[STAGE_COUNT] = {};
+    float lastFrameIntegrationMs = 0.0f;
+    int frameChunks = 0;
+
+    // Row STAGE_COUNT is the per-frame total
+    unsigned long long histogram[STAGE_COUNT + 1][BUCKET_COUNT] = {};
+    unsigned long long busyFrames = 0;
+    unsigned long long idleFrames = 0;
+    unsigned long long chunksIntegrated = 0;
+};
+
+#endif
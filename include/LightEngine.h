@@ -0,0 +1,69 @@
+#ifndef LIGHT_ENGINE_H
+#define LIGHT_ENGINE_H
+
+#include "Chunk.h"
+#include "RingQueue.h"
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+
+// Sky and block light propagation across chunk borders and incremental
+// updates for single block edits, in world coordinates.
+//
+// Skylight rules: air open to the sky straight above is 15, and light
+// spreads to the six neighbors losing 1 per step, except that 15 travels
+// straight down without loss. A block edit only touches voxels whose
+// light actually changes: placing an opaque block runs a removal BFS from
+// the edited voxel (collecting brighter neighbors as re-sources), then an
+// addition BFS refills the darkened region; removing a block seeds the
+// addition BFS from the edited voxel's neighbors.
+//
+// Block light has three 4-bit channels (see Block.h). Emitters keep their
+// emission as their own blockLight; removal runs per channel, addition
+// handles all channels in one pass.
+class LightEngine {
+public:
+    // Returns the loaded chunk at chunk coords, or nullptr
+    using ChunkLookup = std::function<Chunk*(int chunkX, int chunkZ)>;
+
+    explicit LightEngine(ChunkLookup lookup);
+
+    // Call after the block at (x, y, z) changed from oldBlock to its current
+    // type. Chunks whose stored light (or whose faces' sampled light)
+    // changed are added to dirtyChunks.
+    void updateSkyLightAt(int worldX, int worldY, int worldZ, const Block& oldBlock,
+        std::unordered_set<Chunk*>& dirtyChunks);
+
+    // Same contract as updateSkyLightAt, for the RGB block light channel
+    void updateBlockLightAt(int worldX, int worldY, int worldZ, const Block& oldBlock,
+        std::unordered_set<Chunk*>& dirtyChunks);
+
+    // Call once a chunk's own sky and block light are computed and it is
+    // visible through the lookup: exchanges light with its loaded neighbors
+    // until converged.
+    void propagateChunkBorders(Chunk* chunk, std::unordered_set<Chunk*>& dirtyChunks);
+
+private:
+
+    Block* blockAt(int worldX, int worldY, int worldZ);
+    void markDirty(int worldX, int worldZ, Chunk* chunk, std::unordered_set<Chunk*>& dirtyChunks);
+
+    void runRemoval(std::unordered_set<Chunk*>& dirtyChunks);
+    void runAddition(std::unordered_set<Chunk*>& dirtyChunks);
+    void runBlockLightRemoval(int shift, std::unordered_set<Chunk*>& dirtyChunks);
+    void runBlockLightAddition(std::unordered_set<Chunk*>& dirtyChunks);
+
+    ChunkLookup lookup;
+
+    // Last chunk resolved by blockAt (most steps stay inside one chunk)
+    Chunk* cachedChunk = nullptr;
+    int cachedChunkX = 0;
+    int cachedChunkZ = 0;
+
+    // Reused between calls; nodes are packed world coordinates + level
+    RingQueue<uint64_t> removalQueue;
+    RingQueue<uint64_t> additionQueue;
+    RingQueue<uint64_t> blockAdditionQueue;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free multi-producer / single-consumer queue.
+// A power-of-two ring of cells, each with a sequence number (Vyukov's
+// bounded queue): producers claim a slot with one CAS on the enqueue
+// position, write the value and publish it by bumping the cell's
+// sequence; the consumer reads cells in order without any atomic
+// read-modify-write. Nothing is allocated after construction, and a full
+// queue makes push fail instead of growing, so producers can back off.
+template <typename T>
+class MPSCQueue {
+public:
+    explicit MPSCQueue(size_t minCapacity) {
+        size_t capacity = 1;
+        while (capacity < minCapacity) capacity <<= 1;
+
+        cells = std::make_unique<Cell[]>(capacity);
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mask = capacity - 1;
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Any thread. False when the queue is full.
+    bool push(T value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (lag == 0) {
+                // Free and ours if nobody else claimed it first
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (lag < 0) {
+                return false;  // Still holds the value from one lap ago
+            }
+            else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. False when the next value in order hasn't been
+    // published yet, even if later ones have.
+    bool pop(T& out) {
+        Cell& cell = cells[dequeuePosition & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) return false;
+
+        out = std::move(cell.value);
+        cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        dequeuePosition++;
+        return true;
+    }
+
+    // Consumer thread only
+    bool empty() const {
+        return cells[dequeuePosition & mask].sequence.load(std::memory_order_acquire) != dequeuePosition + 1;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+
+    // Separate cache lines: producers hammer the first, the consumer owns the second
+    alignas(64) std::atomic<size_t> enqueuePosition{ 0 };
+    alignas(64) size_t dequeuePosition = 0;
+};
+
+#endif
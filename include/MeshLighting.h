@@ -0,0 +1,70 @@
+#ifndef MESH_LIGHTING_H
+#define MESH_LIGHTING_H
+
+#include "Block.h"
+
+// Per-vertex smooth light and ambient occlusion, baked at mesh time.
+//
+// Every face vertex samples the layer of voxels in front of the face: the
+// voxel directly in front ("front"), the two voxels sharing an edge with
+// the vertex ("side1", "side2") and the one diagonal to it ("corner").
+// Pure functions on Blocks, so they need no GL context.
+
+// AO level (0 = fully occluded .. 3 = open) to brightness factor
+constexpr float AO_CURVE[4] = { 0.45f, 0.65f, 0.85f, 1.0f };
+
+constexpr int vertexAO(bool side1Opaque, bool side2Opaque, bool cornerOpaque) {
+    return (side1Opaque && side2Opaque) ? 0 : 3 - (side1Opaque + side2Opaque + cornerOpaque);
+}
+
+struct VertexLight {
+    float sky;                // 0-1
+    float red, green, blue;   // 0-1 block light
+    float ao;                 // AO_CURVE factor
+};
+
+// Light is averaged over the transparent samples; the corner does not
+// count when both sides are opaque (light can't reach it through them)
+inline VertexLight computeVertexLight(const Block& front, const Block& side1, const Block& side2, const Block& corner) {
+    bool side1Opaque = !side1.isTransparent();
+    bool side2Opaque = !side2.isTransparent();
+    bool cornerOpaque = !corner.isTransparent() || (side1Opaque && side2Opaque);
+
+    const Block* samples[4] = { &front, &side1, &side2, &corner };
+    bool opaque[4] = { false, side1Opaque, side2Opaque, cornerOpaque };
+
+    int sky = 0, red = 0, green = 0, blue = 0, count = 0;
+    for (int i = 0; i < 4; i++) {
+        if (opaque[i]) continue;
+        sky += samples[i]->skyLight;
+        red += blockLightChannel(samples[i]->blockLight, BLOCK_LIGHT_RED_SHIFT);
+        green += blockLightChannel(samples[i]->blockLight, BLOCK_LIGHT_GREEN_SHIFT);
+        blue += blockLightChannel(samples[i]->blockLight, BLOCK_LIGHT_BLUE_SHIFT);
+        count++;
+    }
+
+    float scale = 1.0f / (15.0f * count);
+    VertexLight light;
+    light.sky = sky * scale;
+    light.red = red * scale;
+    light.green = green * scale;
+    light.blue = blue * scale;
+    light.ao = AO_CURVE[vertexAO(side1Opaque, side2Opaque, !corner.isTransparent())];
+    return light;
+}
+
+inline float vertexBrightness(const VertexLight& light) {
+    float block = light.red > light.green ? light.red : light.green;
+    if (light.blue > block) block = light.blue;
+    return light.ao * (light.sky > block ? light.sky : block);
+}
+
+// Quads are split along the 0-2 diagonal by default. Splitting along the
+// brighter diagonal instead keeps a single dark corner from being
+// interpolated across the whole quad (the classic AO anisotropy).
+inline bool flipQuadDiagonal(const VertexLight corners[4]) {
+    return vertexBrightness(corners[0]) + vertexBrightness(corners[2]) <
+        vertexBrightness(corners[1]) + vertexBrightness(corners[3]);
+}
+
+#endif
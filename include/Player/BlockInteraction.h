@@ -4,31 +4,31 @@
 #include "Player/Camera.h"
 #include "ChunkManager.h"
 #include "Block.h"
+#include "BlockRaycast.h"
 
 class BlockInteraction {
 public:
     BlockInteraction();
     ~BlockInteraction() = default;
 
+    // Raycast from the camera; call once per frame. Breaking, placing and
+    // the block outline all use this target.
+    void updateTarget(const Camera& camera, const ChunkManager* chunkManager);
+
+    // Block the player is looking at, or nullptr
+    const BlockRaycastHit* getTarget() const { return hasTarget ? &target : nullptr; }
+
     // Break the block the player is looking at
-    bool breakBlock(Camera& camera, ChunkManager* chunkManager);
+    bool breakBlock(ChunkManager* chunkManager);
 
     // Place a block on the face the player is looking at
     bool placeBlock(Camera& camera, ChunkManager* chunkManager, BlockType blockType);
 
-    // Get info about the block being targeted (for UI/debugging)
-    bool getTargetedBlock(Camera& camera, ChunkManager* chunkManager,
-        int& outBlockX, int& outBlockY, int& outBlockZ,
-        int& outFaceX, int& outFaceY, int& outFaceZ);
-
 private:
     const float maxReach = 5.0f;  // Maximum reach distance
-    const float rayStep = 0.05f;   // Raycast step size
 
-    // Raycast to find targeted block
-    bool raycastBlock(Camera& camera, ChunkManager* chunkManager,
-        int& hitBlockX, int& hitBlockY, int& hitBlockZ,
-        int& faceX, int& faceY, int& faceZ);
+    BlockRaycastHit target;
+    bool hasTarget = false;
 };
 
 #endif
\ No newline at end of file
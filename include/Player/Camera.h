@@ -14,7 +14,6 @@ public:
     float rightX, rightY, rightZ;
 
     // Settings
-    float speed;
     float sensitivity;
 
     Camera(float posX, float posY, float posZ);
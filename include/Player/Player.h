@@ -14,6 +14,9 @@ public:
     // Position
     float x, y, z;
 
+    // Position at the start of the last tick, for render interpolation
+    float previousX, previousY, previousZ;
+
     // Velocity
     float velocityX, velocityY, velocityZ;
 
@@ -25,6 +28,7 @@ public:
     // Movement settings
     float walkSpeed;
     float sprintSpeed;
+    float flySpeed;      // Spectator, blocks per second
     float jumpStrength;
 
     // Physics state
@@ -33,14 +37,19 @@ public:
 
     Player(float posX, float posY, float posZ);
 
+    // Simulation tick: processInput sets velocities, update moves by
+    // them over tickSeconds (a fixed step; see FixedTimestep)
     void processInput(float deltaFront, float deltaRight, float deltaUp, bool jump, bool sprint, Camera& camera);
-    void update(float deltaTime, ChunkManager* chunkManager, Camera& camera);
+    void update(float tickSeconds, ChunkManager* chunkManager);
+
+    // Places the camera at the eye, alpha (0..1) of the way from the
+    // previous tick's position to the current one
+    void updateCamera(Camera& camera, float alpha) const;
     void setGameMode(GameMode mode);
     GameMode getGameMode() const { return gameMode; }
 
 private:
     void applyPhysics(float deltaTime, ChunkManager* chunkManager);
-    bool checkBlockCollision(float x, float y, float z, ChunkManager* chunkManager);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef CHUNK_MESH_H
+#define CHUNK_MESH_H
+
+#include "Chunk.h"
+#include <map>
+#include <vector>
+
+// GPU side of one chunk's mesh: a VAO/VBO/EBO per block type, filled
+// from the CPU buffers built by Chunk::buildMeshData. Owned by
+// ChunkRenderer; needs a current GL context for its whole lifetime.
+class ChunkMesh {
+public:
+    ChunkMesh() = default;
+    ~ChunkMesh();
+
+    ChunkMesh(const ChunkMesh&) = delete;
+    ChunkMesh& operator=(const ChunkMesh&) = delete;
+
+    // Reuses the existing buffers of types that are still present
+    void upload(const std::map<BlockType, ChunkMeshBuffers>& buffers);
+
+    void renderType(BlockType type) const;
+
+    // Translucent types (RenderLayer::TRANSLUCENT) draw back to front, so
+    // their triangles are re-sorted by distance from the camera (render
+    // space). A sort holds until the camera moves more than threshold
+    // blocks from where it was done, or the mesh is re-uploaded.
+    bool hasTranslucent() const { return translucentTypes > 0; }
+    bool needsSort(float cameraX, float cameraY, float cameraZ, float threshold) const;
+    void sortTranslucent(float cameraX, float cameraY, float cameraZ);
+
+private:
+    struct TypeMesh {
+        unsigned int VAO = 0;
+        unsigned int VBO = 0;
+        unsigned int EBO = 0;
+        unsigned int indexCount = 0;
+
+        // Translucent types only: triangles as built and their centroids
+        std::vector<unsigned int> triangles;
+        std::vector<float> centroids;
+    };
+
+    std::map<BlockType, TypeMesh> meshes;
+
+    int translucentTypes = 0;
+    bool sorted = false;
+    float sortX = 0.0f, sortY = 0.0f, sortZ = 0.0f;  // Camera at the last sort
+
+    void setupMesh(TypeMesh& mesh, const ChunkMeshBuffers& buffers, bool dynamicIndices);
+    void deleteMesh(TypeMesh& mesh);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef CHUNK_RENDERER_H
+#define CHUNK_RENDERER_H
+
+#include "Rendering/ChunkMesh.h"
+#include "ChunkManager.h"
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Owns the GPU meshes of all loaded chunks. ChunkManager only builds
+// CPU mesh data; sync() uploads whatever it built (and drops the meshes
+// of chunks it unloaded) since the previous frame.
+class ChunkRenderer {
+public:
+    // Main thread, with the GL context current
+    void sync(ChunkManager& chunkManager);
+
+    void renderType(BlockType type);
+
+    // Translucent pass, after sync each frame: sortTranslucent re-sorts
+    // the faces of chunks the camera (render space) has moved relative
+    // to, nearest chunks first and at most MAX_SORTS_PER_FRAME of them;
+    // renderTranslucent then draws those chunks far to near, binding
+    // each translucent type's texture itself.
+    void sortTranslucent(float cameraX, float cameraY, float cameraZ);
+    void renderTranslucent();
+
+    size_t getMeshCount() const { return meshes.size(); }
+
+private:
+    long long makeKey(int x, int z) const;
+
+    static constexpr float RESORT_DISTANCE = 1.0f;  // Blocks
+    static constexpr int MAX_SORTS_PER_FRAME = 8;
+
+    // Chunks with translucent faces by squared distance, nearest first
+    std::vector<std::pair<float, ChunkMesh*>> translucentOrder;
+
+    std::unordered_map<long long, std::unique_ptr<ChunkMesh>> meshes;
+    std::vector<ChunkMeshUpdate> pendingUpdates;  // Scratch for sync
+};
+
+#endif
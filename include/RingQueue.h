@@ -0,0 +1,60 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <cstddef>
+#include <vector>
+
+// Single-threaded FIFO over a flat power-of-two ring buffer.
+// Grows by doubling when full and never shrinks, so a queue that is kept
+// around (or thread_local) stops allocating after the first few uses.
+// Intended for small trivially-copyable items such as packed coordinates.
+template <typename T>
+class RingQueue {
+public:
+    explicit RingQueue(size_t initialCapacity = 4096) {
+        size_t capacity = 1;
+        while (capacity < initialCapacity) capacity <<= 1;
+        buffer.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    void push(T value) {
+        if (count == buffer.size()) grow();
+        buffer[(head + count) & mask] = value;
+        count++;
+    }
+
+    // Queue must not be empty
+    T pop() {
+        T value = buffer[head];
+        head = (head + 1) & mask;
+        count--;
+        return value;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+private:
+    void grow() {
+        std::vector<T> larger(buffer.size() * 2);
+        for (size_t i = 0; i < count; i++) {
+            larger[i] = buffer[(head + i) & mask];
+        }
+        buffer.swap(larger);
+        mask = buffer.size() - 1;
+        head = 0;
+    }
+
+    std::vector<T> buffer;
+    size_t mask = 0;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+#endif
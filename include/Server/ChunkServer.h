@@ -0,0 +1,109 @@
+#ifndef CHUNK_SERVER_H
+#define CHUNK_SERVER_H
+
+#include "Server/ServerWorld.h"
+#include "Server/Socket.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+struct ChunkServerConfig {
+    uint16_t port = 0;                 // 0 = no socket, simulated players only
+    int tickRate = 20;                 // Ticks per second
+    int simulatedPlayers = 0;          // In-process players flying in circles
+    int simulatedRenderDistance = 8;
+    float simulatedSpeed = 20.0f;      // Blocks per second
+    int maxChunksPerTick = 16;         // Per client
+    size_t maxQueuedBytes = 4 * 1024 * 1024;  // Per client; stop queuing chunks above this
+    float integrationBudgetMs = 15.0f;
+    unsigned int workerCount = 4;
+    std::string worldName = "server";
+};
+
+struct ChunkServerStats {
+    unsigned long long ticks = 0;
+    unsigned long long chunksServed = 0;     // First sends
+    unsigned long long chunksResent = 0;     // Light or block changes after the first send
+    unsigned long long bytesServed = 0;
+    unsigned long long overrunTicks = 0;     // Ticks that took longer than the tick interval
+    std::vector<float> tickMs;               // Duration of each tick (most recent MAX_TICK_HISTORY)
+};
+
+// Dedicated headless server: streams chunks from a ServerWorld to every
+// connected client (and to in-process simulated players) at a fixed
+// tick rate, closest chunks first, and applies their block edits.
+class ChunkServer {
+public:
+    explicit ChunkServer(const ChunkServerConfig& config);
+    ~ChunkServer();
+
+    bool start();
+
+    // Runs ticks until durationSeconds have passed (0 = forever),
+    // printing a report every reportSeconds
+    void run(float durationSeconds, float reportSeconds);
+
+    void tick();
+
+    const ChunkServerStats& getStats() const { return stats; }
+    size_t getClientCount() const { return clients.size(); }
+
+private:
+    struct ClientSession {
+        uint32_t id = 0;
+        Socket socket;                 // Invalid for simulated players
+        bool simulated = false;
+        bool greeted = false;          // Hello received
+        bool disconnected = false;
+
+        float x = 0.0f;                // Render space, like Player
+        float z = 0.0f;
+        int renderDistance = 8;
+        float orbitAngle = 0.0f;       // Simulated players only
+
+        std::unordered_set<long long> sentChunks;
+        std::vector<uint8_t> inbox;
+        std::vector<uint8_t> outbox;
+        size_t outboxOffset = 0;
+    };
+
+    void acceptClients();
+    void readClient(ClientSession& client);
+    void handleMessage(ClientSession& client, const uint8_t* frame, size_t size);
+    void moveSimulatedPlayer(ClientSession& client, float dt);
+    void streamChunks(ClientSession& client, const std::vector<const Chunk*>& changed);
+    void flushClient(ClientSession& client);
+    void report(float windowSeconds);
+
+    int playerChunkX(const ClientSession& client) const;
+    int playerChunkZ(const ClientSession& client) const;
+    long long makeKey(int x, int z) const;
+
+    static constexpr size_t MAX_TICK_HISTORY = 1 << 20;  // About 14 hours at 20 ticks/s
+
+    ChunkServerConfig config;
+    ServerWorld world;
+    Socket listener;
+
+    std::vector<std::unique_ptr<ClientSession>> clients;
+    uint32_t nextClientId = 1;
+
+    // Chunk offsets within the largest render distance, closest first
+    std::vector<std::pair<int, int>> spiralOffsets;
+    int spiralRadius = -1;
+
+    std::vector<ViewerInterest> viewers;       // Scratch
+    std::vector<const Chunk*> changedChunks;   // Scratch
+    std::vector<uint8_t> simulatedOutbox;      // Encoded and discarded for simulated players
+
+    ChunkServerStats stats;
+    size_t reportedTicks = 0;
+    unsigned long long reportedServed = 0;
+    unsigned long long reportedBytes = 0;
+    std::chrono::steady_clock::time_point lastTick;
+};
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef NET_PROTOCOL_H
+#define NET_PROTOCOL_H
+
+#include "Chunk.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Chunk streaming protocol between ChunkServer and its clients.
+//
+// Every message is framed as
+//     uint32 length (of type + payload), uint8 type, payload
+// with all integers little-endian. Chunks travel run-length encoded
+// (type, fluid level, sky light, block light, length) in the chunk's
+// memory order, so a typical chunk is a few KB.
+namespace NetProtocol {
+    constexpr uint32_t VERSION = 2;
+    constexpr uint16_t DEFAULT_PORT = 25570;
+    constexpr uint32_t MAX_MESSAGE_BYTES = 1024 * 1024;  // Larger frames drop the connection
+    constexpr size_t FRAME_HEADER_BYTES = 5;
+    constexpr size_t CHUNK_RUN_BYTES = 7;
+
+    enum class MessageType : uint8_t {
+        // Client -> server
+        Hello = 1,        // uint32 version, uint8 render distance
+        Position = 2,     // float x, float z (render space, as Camera/Player use)
+        SetBlock = 3,     // int32 x, int32 y, int32 z, uint8 block type (world block coords)
+
+        // Server -> client
+        Welcome = 16,     // uint32 version, uint32 client id
+        ChunkData = 17,   // int32 chunkX, int32 chunkZ, uint32 run count, runs
+        ChunkUnload = 18  // int32 chunkX, int32 chunkZ
+    };
+
+    // =============================
+    // Writing
+    // =============================
+    inline void writeU8(std::vector<uint8_t>& out, uint8_t value) {
+        out.push_back(value);
+    }
+
+    inline void writeU16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    inline void writeU32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    inline void writeI32(std::vector<uint8_t>& out, int32_t value) {
+        writeU32(out, static_cast<uint32_t>(value));
+    }
+
+    inline void writeF32(std::vector<uint8_t>& out, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(out, bits);
+    }
+
+    // Starts a frame; returns the offset to pass to endMessage
+    inline size_t beginMessage(std::vector<uint8_t>& out, MessageType type) {
+        size_t start = out.size();
+        writeU32(out, 0);
+        writeU8(out, static_cast<uint8_t>(type));
+        return start;
+    }
+
+    inline void endMessage(std::vector<uint8_t>& out, size_t start) {
+        uint32_t length = static_cast<uint32_t>(out.size() - start - 4);
+        for (int i = 0; i < 4; i++) {
+            out[start + i] = static_cast<uint8_t>(length >> (i * 8));
+        }
+    }
+
+    // =============================
+    // Reading (bounds-checked; a short read poisons the reader)
+    // =============================
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+        uint8_t u8() { return ensure(1) ? data[offset++] : 0; }
+
+        uint16_t u16() {
+            if (!ensure(2)) return 0;
+            uint16_t value = static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+            offset += 2;
+            return value;
+        }
+
+        uint32_t u32() {
+            if (!ensure(4)) return 0;
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= static_cast<uint32_t>(data[offset + i]) << (i * 8);
+            }
+            offset += 4;
+            return value;
+        }
+
+        int32_t i32() { return static_cast<int32_t>(u32()); }
+
+        float f32() {
+            uint32_t bits = u32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        bool ok() const { return valid; }
+        size_t remaining() const { return size - offset; }
+
+    private:
+        bool ensure(size_t bytes) {
+            if (!valid || size - offset < bytes) {
+                valid = false;
+                return false;
+            }
+            return true;
+        }
+
+        const uint8_t* data;
+        size_t size;
+        size_t offset = 0;
+        bool valid = true;
+    };
+
+    // Length of the first complete frame in buffer, 0 if it isn't all
+    // there yet, or -1 if the frame is malformed
+    inline long long completeFrameLength(const uint8_t* buffer, size_t size) {
+        if (size < 4) return 0;
+        uint32_t length = buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (static_cast<uint32_t>(buffer[3]) << 24);
+        if (length == 0 || length > MAX_MESSAGE_BYTES) return -1;
+        return size - 4 >= length ? static_cast<long long>(length) + 4 : 0;
+    }
+
+    // =============================
+    // Chunk payloads
+    // =============================
+    inline void writeChunkData(std::vector<uint8_t>& out, const Chunk& chunk) {
+        size_t start = beginMessage(out, MessageType::ChunkData);
+        writeI32(out, chunk.chunkX);
+        writeI32(out, chunk.chunkZ);
+        size_t countOffset = out.size();
+        writeU32(out, 0);
+
+        uint32_t runCount = 0;
+        const Block* blocks = &chunk.blocks[0][0][0];
+        const int total = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+
+        for (int i = 0; i < total;) {
+            const Block& block = blocks[i];
+            int length = 1;
+            while (i + length < total && length < UINT16_MAX &&
+                blocks[i + length].type == block.type &&
+                blocks[i + length].fluidLevel == block.fluidLevel &&
+                blocks[i + length].skyLight == block.skyLight &&
+                blocks[i + length].blockLight == block.blockLight) {
+                length++;
+            }
+
+            writeU8(out, static_cast<uint8_t>(block.type));
+            writeU8(out, block.fluidLevel);
+            writeU8(out, block.skyLight);
+            writeU16(out, block.blockLight);
+            writeU16(out, static_cast<uint16_t>(length));
+            runCount++;
+            i += length;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            out[countOffset + i] = static_cast<uint8_t>(runCount >> (i * 8));
+        }
+        endMessage(out, start);
+    }
+
+    // Fills chunk->blocks from a ChunkData payload (after chunkX/chunkZ).
+    // Returns false on unknown block types, fluid levels or light values
+    // that don't fit their nibbles, or runs that don't cover the chunk
+    // exactly.
+    inline bool readChunkRuns(Reader& reader, Chunk& chunk) {
+        uint32_t runCount = reader.u32();
+        if (!reader.ok() || reader.remaining() < static_cast<size_t>(runCount) * CHUNK_RUN_BYTES) return false;
+
+        Block* out = &chunk.blocks[0][0][0];
+        const int total = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+        int filled = 0;
+
+        for (uint32_t i = 0; i < runCount; i++) {
+            uint8_t type = reader.u8();
+            uint8_t fluidLevel = reader.u8();
+            uint8_t skyLight = reader.u8();
+            uint16_t blockLight = reader.u16();
+            int length = reader.u16();
+
+            // Block stores these in bit-fields and packed 0x0RGB; anything
+            // wider would be silently truncated
+            if (type >= BLOCK_TYPE_COUNT || fluidLevel > 0xF || skyLight > 15 || (blockLight & 0xF000)) return false;
+            if (length == 0 || filled + length > total) return false;
+
+            Block block(static_cast<BlockType>(type));
+            block.fluidLevel = fluidLevel;
+            block.skyLight = skyLight;
+            block.blockLight = blockLight;
+
+            for (int j = 0; j < length; j++) {
+                out[filled++] = block;
+            }
+        }
+
+        if (filled != total) return false;
+        chunk.recalculateHeightMap();
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SERVER_WORLD_H
+#define SERVER_WORLD_H
+
+#include "Chunk.h"
+#include "ChunkPipeline.h"
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Where a player is and how far it sees, in chunk coordinates
+struct ViewerInterest {
+    int chunkX;
+    int chunkZ;
+    int renderDistance;
+};
+
+struct ServerWorldStats {
+    unsigned long long generated = 0;
+    unsigned long long restoredFromCache = 0;
+    unsigned long long unloaded = 0;
+    unsigned long long blockEdits = 0;
+};
+
+// Headless counterpart of ChunkManager for the dedicated server: the same
+// ChunkPipeline (the tick thread is its owner), driven by any number of
+// viewers instead of one camera, and without meshing. A chunk is servable
+// once it reaches NeighborsReady (its light no longer depends on chunks
+// still loading).
+class ServerWorld {
+public:
+    ServerWorld(const std::string& worldName, unsigned int workerCount);
+    ~ServerWorld();
+
+    // Tick thread. Queues generation for every chunk within any viewer's
+    // load range (render distance plus a one-chunk ring), integrates
+    // finished chunks for up to budgetMs, and unloads chunks nobody is
+    // near any more.
+    void update(const std::vector<ViewerInterest>& viewers, float budgetMs);
+
+    // Tick thread; nullptr when not loaded or not servable yet
+    const Chunk* getServableChunk(int chunkX, int chunkZ) const;
+
+    // Tick thread. Relights incrementally and records the edit in the
+    // save; chunks whose blocks or light changed are reported by
+    // takeChangedChunks.
+    bool setBlockAt(int worldX, int worldY, int worldZ, BlockType type);
+
+    // Chunks already servable whose contents changed since the last call
+    // (late border light, block edits); the caller resends them
+    void takeChangedChunks(std::vector<const Chunk*>& changed);
+
+    size_t getLoadedChunkCount() const { return pipeline.getChunks().size(); }
+    size_t getPendingGenerationCount() const { return pipeline.getQueuedCount(); }
+    ServerWorldStats getStats() const;
+
+    void autoSaveCheck() { pipeline.getWorldSave().autoSaveCheck(); }
+    void save() { pipeline.getWorldSave().flush(); }
+
+private:
+    void integrateChunk(Chunk* chunk);
+    void unloadChunk(Chunk* chunk);
+    void collectChanged(std::unordered_set<Chunk*>& dirty);
+
+    static constexpr size_t CHUNK_CACHE_BYTES = 64 * 1024 * 1024;
+    ChunkPipeline pipeline;
+
+    std::unordered_set<Chunk*> relitChunks;    // Scratch
+    std::vector<Chunk*> readyChunks;           // Scratch
+    std::unordered_set<Chunk*> changedChunks;  // Servable chunks to resend
+
+    unsigned long long blockEdits = 0;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Minimal non-blocking TCP socket (Winsock or BSD sockets), enough for
+// the localhost chunk protocol. Move-only; closes on destruction.
+class Socket {
+public:
+    Socket() = default;
+    ~Socket();
+
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+    Socket(Socket&& other) noexcept;
+    Socket& operator=(Socket&& other) noexcept;
+
+    // Once per process before any other call (WSAStartup on Windows)
+    static bool initializeNetworking();
+
+    bool listen(uint16_t port);                    // Binds 127.0.0.1
+    Socket accept();                               // Invalid socket if nobody is waiting
+    bool connect(const char* host, uint16_t port); // Blocks until connected
+
+    // Bytes transferred, 0 if the call would block, -1 on error or
+    // (for receive) an orderly close by the peer
+    long long send(const uint8_t* data, size_t size);
+    long long receive(uint8_t* data, size_t size);
+
+    bool isValid() const { return handle != INVALID_HANDLE; }
+    void close();
+
+private:
+    static constexpr intptr_t INVALID_HANDLE = -1;
+
+    explicit Socket(intptr_t handle) : handle(handle) {}
+    bool setNonBlocking();
+
+    intptr_t handle = INVALID_HANDLE;
+};
+
+#endif
@@ -3,8 +3,12 @@
 
 #include "Chunk.h"
 
+#include <cstdint>
+
 class TerrainGenerator {
 public:
+    static constexpr uint32_t SEED = 12345;
+
     static void generateFlatTerrain(Chunk& chunk);
 };
 
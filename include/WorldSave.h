@@ -7,10 +7,12 @@
 #include <fstream>
 #include <mutex>
 #include <chrono>
+#include <vector>
 
 struct ModifiedBlock {
     int x, y, z;
     BlockType type;
+    unsigned char fluidLevel;
 };
 
 class WorldSave {
@@ -18,10 +20,11 @@ public:
     WorldSave(const std::string& worldName);
     ~WorldSave();
 
-    void saveBlockChange(int x, int y, int z, BlockType type);
+    void saveBlockChange(int x, int y, int z, BlockType type, unsigned char fluidLevel = FLUID_SOURCE);
     bool getBlockChange(int x, int y, int z, BlockType& outType);
     bool hasBlockChange(int x, int y, int z);
     void loadChunkModifications(int chunkX, int chunkZ, std::vector<ModifiedBlock>& modifications);
+    size_t getModificationCount();
 
     void flush();
     void autoSaveCheck();  // Call this every frame to auto-save periodically
@@ -30,16 +33,42 @@ private:
     std::string worldName;
     std::string getSaveFilePath();
 
-    std::unordered_map<long long, BlockType> modifiedBlocks;
+    struct SavedBlock {
+        BlockType type;
+        unsigned char fluidLevel;
+    };
+    // Block key -> change, per chunk key, so a chunk's changes are found
+    // without walking everyone else's
+    std::unordered_map<long long, std::unordered_map<long long, SavedBlock>> modifiedChunks;
+    size_t modifiedCount = 0;
     std::mutex saveMutex;
 
     bool isDirty;  // Track if we have unsaved changes
+    bool saveLocked = false;  // The file on disk couldn't be backed up before a lossy rewrite; never save over it
     std::chrono::steady_clock::time_point lastSaveTime;
     const float autoSaveInterval = 30.0f;  // Auto-save every 30 seconds
 
-    long long makeBlockKey(int x, int y, int z);
+    static long long makeBlockKey(int x, int y, int z);
+    static void unpackBlockKey(long long key, int& x, int& y, int& z);
+    static long long makeChunkKey(int chunkX, int chunkZ);
+    static long long chunkKeyOf(int x, int z);  // Chunk holding block (x, z)
+    void storeBlockChange(int x, int y, int z, SavedBlock saved);
+    const SavedBlock* findBlockChange(int x, int y, int z) const;
     void loadFromDisk();
+    bool loadLegacy(std::ifstream& file, int count);
+    bool backUpSaveFile(const std::string& filepath, const std::string& backupPath);
     void saveToDisk();
+
+    // File layout: FILE_MAGIC, FILE_VERSION, record count, then per
+    // record x, y, z (int), the type and the fluid level (1 byte each).
+    // Version 2 files have no fluid level and are read as sources.
+    // Version 1 files have no header and store the type as a 4-byte int;
+    // they are converted on load and the original is kept as
+    // world_blocks.v1.dat (if that copy fails, nothing is saved). A file
+    // with a truncated or corrupt record loads the records before it and
+    // is copied to world_blocks.corrupt.dat, or left alone if it can't be.
+    static constexpr char FILE_MAGIC[4] = { 'M', 'C', 'W', 'S' };
+    static constexpr int FILE_VERSION = 3;
 };
 
 #endif
\ No newline at end of file
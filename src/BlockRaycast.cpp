@@ -0,0 +1,89 @@
+#include "BlockRaycast.h"
+#include "ChunkManager.h"
+#include <cmath>
+#include <limits>
+
+bool raycastBlocks(const ChunkManager& chunkManager,
+    float originX, float originY, float originZ,
+    float dirX, float dirY, float dirZ,
+    float maxDistance, BlockRaycastHit& hit) {
+    float length = std::sqrt(dirX * dirX + dirY * dirY + dirZ * dirZ);
+    if (length <= 0.0f) return false;
+
+    // Block space: shifted by half a block so every block spans
+    // [n, n + 1) on each axis, and Z flipped to the chunk system
+    const float position[3] = { originX + 0.5f, originY + 0.5f, -originZ + 0.5f };
+    const float direction[3] = { dirX / length, dirY / length, -dirZ / length };
+
+    int block[3];
+    int step[3];
+    float tMax[3];    // Distance along the ray to the next boundary on each axis
+    float tDelta[3];  // Distance between boundaries on each axis
+    for (int axis = 0; axis < 3; axis++) {
+        block[axis] = static_cast<int>(std::floor(position[axis]));
+
+        if (direction[axis] > 0.0f) {
+            step[axis] = 1;
+            tDelta[axis] = 1.0f / direction[axis];
+            tMax[axis] = (block[axis] + 1 - position[axis]) * tDelta[axis];
+        }
+        else if (direction[axis] < 0.0f) {
+            step[axis] = -1;
+            tDelta[axis] = -1.0f / direction[axis];
+            tMax[axis] = (position[axis] - block[axis]) * tDelta[axis];
+        }
+        else {
+            step[axis] = 0;
+            tDelta[axis] = std::numeric_limits<float>::infinity();
+            tMax[axis] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    auto isTarget = [&]() {
+        std::optional<Block> found = chunkManager.getBlockAt(block[0], block[1], block[2]);
+        return found && found->isTargetable();
+    };
+
+    // Starting inside a block: report the face on the origin's side of it
+    if (isTarget()) {
+        hit = BlockRaycastHit();
+        hit.blockX = block[0];
+        hit.blockY = block[1];
+        hit.blockZ = block[2];
+
+        float offset[3];
+        int major = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            offset[axis] = position[axis] - (block[axis] + 0.5f);
+            if (std::abs(offset[axis]) > std::abs(offset[major])) major = axis;
+        }
+        int face = offset[major] >= 0.0f ? 1 : -1;
+        if (major == 0) hit.faceX = face;
+        else if (major == 1) hit.faceY = face;
+        else hit.faceZ = face;
+        return true;
+    }
+
+    while (true) {
+        int axis = tMax[0] < tMax[1]
+            ? (tMax[0] < tMax[2] ? 0 : 2)
+            : (tMax[1] < tMax[2] ? 1 : 2);
+
+        float distance = tMax[axis];
+        if (distance > maxDistance) return false;
+
+        block[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+
+        if (!isTarget()) continue;
+
+        hit.blockX = block[0];
+        hit.blockY = block[1];
+        hit.blockZ = block[2];
+        hit.faceX = axis == 0 ? -step[0] : 0;
+        hit.faceY = axis == 1 ? -step[1] : 0;
+        hit.faceZ = axis == 2 ? -step[2] : 0;
+        hit.distance = distance;
+        return true;
+    }
+}
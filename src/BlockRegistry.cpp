@@ -2,20 +2,18 @@
 #include <iostream>
 
 void BlockRegistry::loadTextures() {
-    textures[BlockType::GRASS] = new Texture("assets/textures/blocks/GrassBlock.png");
-    textures[BlockType::DIRT] = new Texture("assets/textures/blocks/DirtBlock.png");
-    textures[BlockType::STONE] = new Texture("assets/textures/blocks/StoneBlock.png");
-	textures[BlockType::SAND] = new Texture("assets/textures/blocks/SandBlock.png");
-    textures[BlockType::BLOCKOFPUREWHITELIGHT] = new Texture("assets/textures/blocks/BlockOfPureWhiteLight.png");
-    textures[BlockType::BLOCKOFPUREREDLIGHT] = new Texture("assets/textures/blocks/BlockOfPureRedLight.png");
-    textures[BlockType::BLOCKOFPUREGREENLIGHT] = new Texture("assets/textures/blocks/BlockOfPureGreenLight.png");
-    textures[BlockType::BLOCKOFPUREBLUELIGHT] = new Texture("assets/textures/blocks/BlockOfPureBlueLight.png");
+    for (int i = 0; i < BLOCK_TYPE_COUNT; i++) {
+        const char* path = BLOCK_INFO[i].texture;
+        if (path && !textures[i]) textures[i] = new Texture(path);
+    }
 
     std::cout << "Block textures loaded" << std::endl;
 }
 
-void BlockRegistry::bindTexture(BlockType type) {
-    if (textures.find(type) != textures.end()) {
-        textures[type]->bind();
-    }
-}
\ No newline at end of file
+bool BlockRegistry::bindTexture(BlockType type) {
+    Texture* texture = textures[static_cast<int>(type)];
+    if (!texture) return false;
+
+    texture->bind();
+    return true;
+}
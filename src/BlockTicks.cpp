@@ -0,0 +1,111 @@
+#include "BlockTicks.h"
+#include "Chunk.h"
+#include <algorithm>
+
+namespace {
+    // Heap order: earliest due tick on top, then earliest scheduled
+    struct LaterEntry {
+        template <typename Entry>
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.dueTick != b.dueTick) return a.dueTick > b.dueTick;
+            return a.sequence > b.sequence;
+        }
+    };
+}
+
+long long BlockTickScheduler::makeKey(int x, int z) const {
+    return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+}
+
+uint16_t BlockTickScheduler::localIndex(int localX, int y, int localZ) {
+    return static_cast<uint16_t>((localX * CHUNK_SIZE_Y + y) * CHUNK_SIZE_Z + localZ);
+}
+
+void BlockTickScheduler::schedule(int x, int y, int z, unsigned int delay) {
+    if (y < 0 || y >= CHUNK_SIZE_Y) return;
+
+    int chunkX = x / CHUNK_SIZE_X;
+    if (x < 0 && x % CHUNK_SIZE_X != 0) chunkX--;
+
+    int chunkZ = z / CHUNK_SIZE_Z;
+    if (z < 0 && z % CHUNK_SIZE_Z != 0) chunkZ--;
+
+    long long key = makeKey(chunkX, chunkZ);
+    ChunkQueue& queue = queues[key];
+
+    uint16_t index = localIndex(x - chunkX * CHUNK_SIZE_X, y, z - chunkZ * CHUNK_SIZE_Z);
+    if (!queue.scheduled.insert(index).second) return;
+
+    uint64_t dueTick = currentTick + std::max(1u, delay);
+    queue.heap.push_back({ dueTick, nextSequence++, index });
+    std::push_heap(queue.heap.begin(), queue.heap.end(), LaterEntry());
+    pendingCount++;
+
+    registerOnWheel(key, queue, dueTick);
+}
+
+// A chunk sits on the wheel once, at its earliest due tick. Moving it
+// earlier leaves the old wheel entry behind; advance skips such entries.
+void BlockTickScheduler::registerOnWheel(long long key, ChunkQueue& queue, uint64_t dueTick) {
+    if (queue.wheelTick != 0 && queue.wheelTick <= dueTick) return;
+
+    queue.wheelTick = dueTick;
+    wheel[dueTick % WHEEL_SLOTS].push_back({ key, dueTick });
+}
+
+void BlockTickScheduler::advance(std::vector<ChunkTicks>& due) {
+    due.clear();
+    currentTick++;
+
+    std::vector<WheelEntry>& slot = wheel[currentTick % WHEEL_SLOTS];
+    turning.clear();
+    turning.swap(slot);
+
+    for (const WheelEntry& entry : turning) {
+        if (entry.dueTick > currentTick) {
+            slot.push_back(entry);  // A later turn of the wheel
+            continue;
+        }
+
+        auto it = queues.find(entry.key);
+        if (it == queues.end() || it->second.wheelTick != entry.dueTick) continue;
+
+        ChunkQueue& queue = it->second;
+        queue.wheelTick = 0;
+
+        ChunkTicks chunkTicks;
+        chunkTicks.chunkX = static_cast<int>(entry.key >> 32);
+        chunkTicks.chunkZ = static_cast<int>(static_cast<uint32_t>(entry.key));
+
+        while (!queue.heap.empty() && queue.heap.front().dueTick <= currentTick) {
+            std::pop_heap(queue.heap.begin(), queue.heap.end(), LaterEntry());
+            uint16_t index = queue.heap.back().localIndex;
+            queue.heap.pop_back();
+            queue.scheduled.erase(index);
+            pendingCount--;
+
+            int localZ = index % CHUNK_SIZE_Z;
+            int y = (index / CHUNK_SIZE_Z) % CHUNK_SIZE_Y;
+            int localX = index / (CHUNK_SIZE_Z * CHUNK_SIZE_Y);
+            chunkTicks.ticks.push_back({
+                chunkTicks.chunkX * CHUNK_SIZE_X + localX, y, chunkTicks.chunkZ * CHUNK_SIZE_Z + localZ });
+        }
+
+        if (queue.heap.empty()) queues.erase(it);
+        else registerOnWheel(entry.key, queue, queue.heap.front().dueTick);
+
+        if (!chunkTicks.ticks.empty()) due.push_back(std::move(chunkTicks));
+    }
+
+    std::sort(due.begin(), due.end(), [](const ChunkTicks& a, const ChunkTicks& b) {
+        return a.chunkX != b.chunkX ? a.chunkX < b.chunkX : a.chunkZ < b.chunkZ;
+        });
+}
+
+void BlockTickScheduler::dropChunk(int chunkX, int chunkZ) {
+    auto it = queues.find(makeKey(chunkX, chunkZ));
+    if (it == queues.end()) return;
+
+    pendingCount -= it->second.heap.size();
+    queues.erase(it);
+}
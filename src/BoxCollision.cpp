@@ -0,0 +1,89 @@
+#include "BoxCollision.h"
+#include "ChunkManager.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Faces closer than this count as touching, not overlapping, so a box
+    // resting on the ground can slide across block seams
+    constexpr float CONTACT_EPSILON = 1e-4f;
+
+    // Block space: block (bx, by, bz) spans [b, b + 1] on every axis
+    struct BlockSpaceBox {
+        float min[3];
+        float max[3];
+    };
+
+    // Blocks whose [n, n + 1] overlaps (low, high) by more than the epsilon
+    void blockRange(float low, float high, int& first, int& last) {
+        first = static_cast<int>(std::floor(low + CONTACT_EPSILON));
+        last = static_cast<int>(std::ceil(high - CONTACT_EPSILON)) - 1;
+    }
+
+    float sweepAxis(const ChunkManager& chunkManager, BlockSpaceBox& box, int axis, float move, BlockRegion& region,
+        bool& touchedUnloaded) {
+        if (move == 0.0f) return 0.0f;
+
+        int first[3];
+        int last[3];
+        for (int i = 0; i < 3; i++) {
+            float low = box.min[i];
+            float high = box.max[i];
+            if (i == axis) {
+                low = std::min(low, low + move);
+                high = std::max(high, high + move);
+            }
+            blockRange(low, high, first[i], last[i]);
+            if (first[i] > last[i]) return move;
+        }
+
+        chunkManager.getBlocksInRegion(first[0], first[1], first[2], last[0], last[1], last[2], region);
+        if (region.missingChunks) touchedUnloaded = true;
+
+        float allowed = move;
+        int block[3];
+        for (block[0] = first[0]; block[0] <= last[0]; block[0]++) {
+            for (block[1] = first[1]; block[1] <= last[1]; block[1]++) {
+                for (block[2] = first[2]; block[2] <= last[2]; block[2]++) {
+                    if (!region.at(block[0], block[1], block[2]).isSolid()) continue;
+
+                    // Gap between the box and this block along the axis;
+                    // blocks the box already overlaps are skipped
+                    if (move > 0.0f) {
+                        float gap = block[axis] - box.max[axis];
+                        if (gap >= -CONTACT_EPSILON) allowed = std::min(allowed, std::max(gap, 0.0f));
+                    }
+                    else {
+                        float gap = block[axis] + 1 - box.min[axis];
+                        if (gap <= CONTACT_EPSILON) allowed = std::max(allowed, std::min(gap, 0.0f));
+                    }
+                }
+            }
+        }
+
+        box.min[axis] += allowed;
+        box.max[axis] += allowed;
+        return allowed;
+    }
+}
+
+BoxSweepResult sweepBox(const ChunkManager& chunkManager, const CollisionBox& box,
+    float moveX, float moveY, float moveZ) {
+    // Render z is negated block z; blocks are centered on integer x and z
+    BlockSpaceBox blockBox = {
+        { box.minX + 0.5f, box.minY, -box.maxZ + 0.5f },
+        { box.maxX + 0.5f, box.maxY, -box.minZ + 0.5f }
+    };
+
+    BlockRegion region;
+    BoxSweepResult result;
+
+    result.moveY = sweepAxis(chunkManager, blockBox, 1, moveY, region, result.touchedUnloaded);
+    result.moveX = sweepAxis(chunkManager, blockBox, 0, moveX, region, result.touchedUnloaded);
+    result.moveZ = -sweepAxis(chunkManager, blockBox, 2, -moveZ, region, result.touchedUnloaded);
+
+    result.blockedX = result.moveX != moveX;
+    result.blockedY = result.moveY != moveY;
+    result.blockedZ = result.moveZ != moveZ;
+    return result;
+}
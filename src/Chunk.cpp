@@ -1,13 +1,14 @@
 #include "Chunk.h"
+#include "MeshLighting.h"
+#include <algorithm>
 #include <vector>
 #include <iostream>
-#include <queue>
-#include <unordered_set>
+#include <cmath>
 
 Chunk::Chunk(int chunkX, int chunkZ)
     : chunkX(chunkX), chunkZ(chunkZ) {
     // Initialize neighbors to null
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < NEIGHBOR_COUNT; i++) {
         neighbors[i] = nullptr;
     }
 
@@ -18,16 +19,9 @@ Chunk::Chunk(int chunkX, int chunkZ)
                 blocks[x][y][z] = Block(BlockType::AIR);
             }
         }
-    }
-}
-
-Chunk::~Chunk() {
-    // Clean up all meshes
-    for (auto& pair : meshes) {
-        MeshData& mesh = pair.second;
-        if (mesh.VAO) glDeleteVertexArrays(1, &mesh.VAO);
-        if (mesh.VBO) glDeleteBuffers(1, &mesh.VBO);
-        if (mesh.EBO) glDeleteBuffers(1, &mesh.EBO);
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            heightMap[x][z] = 0;
+        }
     }
 }
 
@@ -58,46 +52,67 @@ Block Chunk::getBlockWorld(int worldX, int worldY, int worldZ) const {
         return blocks[localX][worldY][localZ];
     }
 
-    // Check which neighbor we need
+    // Check which neighbor we need (cardinal or diagonal)
     int deltaX = targetChunkX - chunkX;
     int deltaZ = targetChunkZ - chunkZ;
 
-    // Direct neighbors only
-    if (deltaX == 0 && deltaZ == 1 && neighbors[0]) {  // North
-        return neighbors[0]->getBlockWorld(worldX, worldY, worldZ);
-    }
-    if (deltaX == 0 && deltaZ == -1 && neighbors[1]) {  // South
-        return neighbors[1]->getBlockWorld(worldX, worldY, worldZ);
-    }
-    if (deltaX == 1 && deltaZ == 0 && neighbors[2]) {  // East
-        return neighbors[2]->getBlockWorld(worldX, worldY, worldZ);
-    }
-    if (deltaX == -1 && deltaZ == 0 && neighbors[3]) {  // West
-        return neighbors[3]->getBlockWorld(worldX, worldY, worldZ);
+    if (deltaX >= -1 && deltaX <= 1 && deltaZ >= -1 && deltaZ <= 1) {
+        if (const Chunk* neighbor = neighborAt(deltaX, deltaZ)) {
+            int localX = worldX - (neighbor->chunkX * CHUNK_SIZE_X);
+            int localZ = worldZ - (neighbor->chunkZ * CHUNK_SIZE_Z);
+            return neighbor->blocks[localX][worldY][localZ];
+        }
     }
 
     // Neighbor not loaded -> treat as solid so faces are not generated
     return Block(BlockType::STONE);
 }
 
-void Chunk::setBlock(int x, int y, int z, BlockType type) {
+void Chunk::setBlock(int x, int y, int z, BlockType type, unsigned char fluidLevel) {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
         return;
     }
     blocks[x][y][z] = Block(type);
+    blocks[x][y][z].fluidLevel = fluidLevel;
+
+    // Keep the column height in sync
+    short& height = heightMap[x][z];
+    if (!blocks[x][y][z].isTransparent()) {
+        if (y >= height) height = static_cast<short>(y + 1);
+    }
+    else if (y == height - 1) {
+        while (height > 0 && blocks[x][height - 1][z].isTransparent()) height--;
+    }
+}
+
+void Chunk::recalculateHeightMap() {
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            int height = CHUNK_SIZE_Y;
+            while (height > 0 && blocks[x][height - 1][z].isTransparent()) height--;
+            heightMap[x][z] = static_cast<short>(height);
+        }
+    }
 }
 
 void Chunk::setNeighbor(int direction, Chunk* neighbor) {
-    if (direction >= 0 && direction < 4) {
+    if (direction >= 0 && direction < NEIGHBOR_COUNT) {
         neighbors[direction] = neighbor;
     }
 }
 
 Chunk* Chunk::getNeighbor(int direction) const {
-    if (direction < 0 || direction >= 4) return nullptr;
+    if (direction < 0 || direction >= NEIGHBOR_COUNT) return nullptr;
     return neighbors[direction];
 }
 
+bool Chunk::hasAllNeighbors() const {
+    for (int i = 0; i < NEIGHBOR_COUNT; i++) {
+        if (!neighbors[i]) return false;
+    }
+    return true;
+}
+
 unsigned char Chunk::getSkyLight(int x, int y, int z) const {
     if (x < 0 || x >= CHUNK_SIZE_X || y < 0 || y >= CHUNK_SIZE_Y || z < 0 || z >= CHUNK_SIZE_Z) {
         return 0;
@@ -105,262 +120,148 @@ unsigned char Chunk::getSkyLight(int x, int y, int z) const {
     return blocks[x][y][z].skyLight;
 }
 
-void Chunk::calculateSkyLight(unsigned char maxSkyLight) {
-    // Step 1: Initialize ALL blocks to 0
+namespace {
+    // Local voxel index packed into 16 bits: xxxx yyyyyyyy zzzz
+    inline uint16_t packLocal(int x, int y, int z) {
+        return static_cast<uint16_t>((x << 12) | (y << 4) | z);
+    }
+}
+
+void Chunk::collectTickingBlocks() {
+    tickingBlocks.clear();
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
         for (int y = 0; y < CHUNK_SIZE_Y; y++) {
             for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                blocks[x][y][z].skyLight = 0;
+                if (getBlockProperties(blocks[x][y][z].type).tickDelay != 0) tickingBlocks.push_back(packLocal(x, y, z));
             }
         }
     }
+}
+
+// Direct skylight comes straight from the heightmap: everything at or
+// above a column's height is open sky, everything below starts dark.
+// Light can only spread sideways where a neighboring column is taller,
+// so only those voxels seed the BFS.
+void Chunk::calculateSkyLight(unsigned char maxSkyLight) {
+    static thread_local RingQueue<uint16_t> lightQueue;
+    lightQueue.clear();
 
-    // Step 2: Direct skylight - scan each column from top
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
         for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-            for (int y = CHUNK_SIZE_Y - 1; y >= 0; y--) {
-                if (blocks[x][y][z].isAir()) {
-                    blocks[x][y][z].skyLight = maxSkyLight;
-                }
-                else {
-                    break;
-                }
-            }
+            int height = heightMap[x][z];
+            for (int y = 0; y < height; y++) blocks[x][y][z].skyLight = 0;
+            for (int y = height; y < CHUNK_SIZE_Y; y++) blocks[x][y][z].skyLight = maxSkyLight;
         }
     }
 
-    // Step 3: Propagate within chunk (handles Y-axis perfectly)
-    propagateSkyLight();
-}
+    if (maxSkyLight <= 1) return;
 
-// INTERNAL PROPAGATION: Uses LOCAL coordinates (keeps Y-axis working!)
-void Chunk::propagateSkyLight() {
-    static bool queued[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+    static const int dx[4] = { 1, -1, 0, 0 };
+    static const int dz[4] = { 0, 0, 1, -1 };
 
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                queued[x][y][z] = false;
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            int height = heightMap[x][z];
+
+            // Highest neighbor column: lit voxels below it face a possibly dark neighbor
+            int seedTop = height;
+            for (int i = 0; i < 4; i++) {
+                int nx = x + dx[i];
+                int nz = z + dz[i];
+                if (nx < 0 || nx >= CHUNK_SIZE_X || nz < 0 || nz >= CHUNK_SIZE_Z) continue;
+                if (heightMap[nx][nz] > seedTop) seedTop = heightMap[nx][nz];
             }
-        }
-    }
 
-    std::queue<std::tuple<int, int, int, unsigned char>> lightQueue;
-
-    // CRITICAL FIX: Seed ALL blocks that have ANY light and a dimmer neighbor
-    // Not just blocks with max light!
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                // OLD: if (blocks[x][y][z].skyLight != maxLightInChunk || !blocks[x][y][z].isAir())
-                // NEW: Seed ANY block with light > 0
-                if (blocks[x][y][z].skyLight == 0 || !blocks[x][y][z].isAir())
-                    continue;
-
-                unsigned char myLight = blocks[x][y][z].skyLight;
-                bool isBoundary = false;
-
-                // Check if ANY neighbor has LESS light
-                if (x > 0 && blocks[x - 1][y][z].isAir() && blocks[x - 1][y][z].skyLight < myLight)
-                    isBoundary = true;
-                if (x < CHUNK_SIZE_X - 1 && blocks[x + 1][y][z].isAir() && blocks[x + 1][y][z].skyLight < myLight)
-                    isBoundary = true;
-
-                if (y > 0 && blocks[x][y - 1][z].isAir() && blocks[x][y - 1][z].skyLight < myLight)
-                    isBoundary = true;
-                if (y < CHUNK_SIZE_Y - 1 && blocks[x][y + 1][z].isAir() && blocks[x][y + 1][z].skyLight < myLight)
-                    isBoundary = true;
-
-                if (z > 0 && blocks[x][y][z - 1].isAir() && blocks[x][y][z - 1].skyLight < myLight)
-                    isBoundary = true;
-                if (z < CHUNK_SIZE_Z - 1 && blocks[x][y][z + 1].isAir() && blocks[x][y][z + 1].skyLight < myLight)
-                    isBoundary = true;
-
-                if (isBoundary) {
-                    lightQueue.push(std::make_tuple(x, y, z, myLight));
-                    queued[x][y][z] = true;
-                }
+            for (int y = height; y < seedTop; y++) {
+                lightQueue.push(packLocal(x, y, z));
             }
         }
     }
 
-    // Propagate light
-    int processed = 0;
-    const int MAX_PROCESS = 10000;
-
-    while (!lightQueue.empty() && processed < MAX_PROCESS) {
-        processed++;
-
-        auto [x, y, z, currentLight] = lightQueue.front();
-        lightQueue.pop();
+    propagateSkyLight(lightQueue);
+}
 
-        currentLight = blocks[x][y][z].skyLight;
+// INTERNAL PROPAGATION: Uses LOCAL coordinates, runs to convergence.
+// A voxel is only re-queued when its light strictly increases, so no
+// visited set is needed and the result does not depend on queue order.
+void Chunk::propagateSkyLight(RingQueue<uint16_t>& lightQueue) {
+    while (!lightQueue.empty()) {
+        uint16_t packed = lightQueue.pop();
+        int x = packed >> 12;
+        int y = (packed >> 4) & 0xFF;
+        int z = packed & 0xF;
+
+        unsigned char currentLight = blocks[x][y][z].skyLight;
         if (currentLight <= 1) continue;
 
         unsigned char spreadLight = currentLight - 1;
 
-        int dx[] = { 1, -1, 0, 0, 0, 0 };
-        int dy[] = { 0, 0, 1, -1, 0, 0 };
-        int dz[] = { 0, 0, 0, 0, 1, -1 };
-
-        for (int i = 0; i < 6; i++) {
-            int nx = x + dx[i];
-            int ny = y + dy[i];
-            int nz = z + dz[i];
-
-            // Stay within chunk bounds
-            if (nx < 0 || nx >= CHUNK_SIZE_X ||
-                ny < 0 || ny >= CHUNK_SIZE_Y ||
-                nz < 0 || nz >= CHUNK_SIZE_Z) {
-                continue;
-            }
-
-            if (queued[nx][ny][nz]) continue;
-
-            Block& neighbor = blocks[nx][ny][nz];
-            if (!neighbor.isAir()) continue;
-
-            if (spreadLight > neighbor.skyLight) {
-                neighbor.skyLight = spreadLight;
-
-                if (spreadLight > 2) {
-                    lightQueue.push(std::make_tuple(nx, ny, nz, spreadLight));
-                    queued[nx][ny][nz] = true;
-                }
-            }
-        }
+        // Only direct sunlight (15) is ever above 14, and it already fills its
+        // whole column, so plain decay in every direction is exact here
+        if (x > 0) spreadSkyLight(lightQueue, x - 1, y, z, spreadLight);
+        if (x < CHUNK_SIZE_X - 1) spreadSkyLight(lightQueue, x + 1, y, z, spreadLight);
+        if (y > 0) spreadSkyLight(lightQueue, x, y - 1, z, spreadLight);
+        if (y < CHUNK_SIZE_Y - 1) spreadSkyLight(lightQueue, x, y + 1, z, spreadLight);
+        if (z > 0) spreadSkyLight(lightQueue, x, y, z - 1, spreadLight);
+        if (z < CHUNK_SIZE_Z - 1) spreadSkyLight(lightQueue, x, y, z + 1, spreadLight);
     }
 }
 
-// CROSS-CHUNK PROPAGATION: Uses WORLD coordinates (fixes X/Z between chunks!)
-void Chunk::propagateSkyLightFloodFill() {
-    std::queue<std::tuple<int, int, int>> lightQueue;
-    std::unordered_set<long long> queued;
+void Chunk::spreadSkyLight(RingQueue<uint16_t>& lightQueue, int x, int y, int z, unsigned char level) {
+    Block& neighbor = blocks[x][y][z];
+    if (!neighbor.isTransparent() || neighbor.skyLight >= level) return;
+
+    neighbor.skyLight = level;
+    if (level > 1) lightQueue.push(packLocal(x, y, z));
+}
 
-    auto makeWorldKey = [](int x, int y, int z) -> long long {
-        return (static_cast<long long>(x + 100000) << 32) |
-            (static_cast<long long>(y) << 16) |
-            static_cast<long long>(z + 100000);
-        };
+// =============================
+// Block light (RGB emitters)
+// =============================
+// Emitters hold their own emission as blockLight; light spreads through
+// air with each channel losing 1 per step independently. Runs to
+// convergence inside the chunk; borders are handled by LightEngine.
+void Chunk::calculateBlockLight() {
+    static thread_local RingQueue<uint16_t> lightQueue;
+    lightQueue.clear();
 
-    // Seed ONLY edge blocks that can propagate to neighbors
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
         for (int y = 0; y < CHUNK_SIZE_Y; y++) {
             for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                // Only check edge blocks
-                if (x != 0 && x != CHUNK_SIZE_X - 1 && z != 0 && z != CHUNK_SIZE_Z - 1)
-                    continue;
-
-                if (!blocks[x][y][z].isAir() || blocks[x][y][z].skyLight == 0)
-                    continue;
-
-                int worldX = chunkX * CHUNK_SIZE_X + x;
-                int worldY = y;
-                int worldZ = chunkZ * CHUNK_SIZE_Z + z;
-
-                unsigned char myLight = blocks[x][y][z].skyLight;
-
-                // Check if we can improve a neighbor's light
-                bool canPropagate = false;
-
-                Block neighbor;
-
-                neighbor = getBlockWorld(worldX - 1, worldY, worldZ);
-                if (neighbor.isAir() && myLight > neighbor.skyLight + 1) canPropagate = true;
-
-                neighbor = getBlockWorld(worldX + 1, worldY, worldZ);
-                if (neighbor.isAir() && myLight > neighbor.skyLight + 1) canPropagate = true;
-
-                neighbor = getBlockWorld(worldX, worldY, worldZ - 1);
-                if (neighbor.isAir() && myLight > neighbor.skyLight + 1) canPropagate = true;
-
-                neighbor = getBlockWorld(worldX, worldY, worldZ + 1);
-                if (neighbor.isAir() && myLight > neighbor.skyLight + 1) canPropagate = true;
-
-                if (canPropagate) {
-                    long long key = makeWorldKey(worldX, worldY, worldZ);
-                    lightQueue.push(std::make_tuple(worldX, worldY, worldZ));
-                    queued.insert(key);
-                }
+                unsigned short emission = getLightEmission(blocks[x][y][z].type);
+                blocks[x][y][z].blockLight = emission;
+                if (emission != 0) lightQueue.push(packLocal(x, y, z));
             }
         }
     }
 
-    // Propagate across chunks (X/Z only, Y is already handled internally)
-    int iterations = 0;
-    const int MAX_ITERATIONS = 50000;
-
-    while (!lightQueue.empty() && iterations < MAX_ITERATIONS) {
-        iterations++;
-
-        auto [worldX, worldY, worldZ] = lightQueue.front();
-        lightQueue.pop();
-
-        Block currentBlock = getBlockWorld(worldX, worldY, worldZ);
-        if (!currentBlock.isAir()) continue;
-
-        unsigned char currentLight = currentBlock.skyLight;
-        if (currentLight <= 1) continue;
-
-        unsigned char spreadLight = currentLight - 1;
-
-        // Only spread in X/Z directions (Y is handled internally)
-        int dx[] = { 1, -1, 0, 0 };
-        int dz[] = { 0, 0, 1, -1 };
-
-        for (int i = 0; i < 4; i++) {
-            int nx = worldX + dx[i];
-            int nz = worldZ + dz[i];
-            int ny = worldY;
-
-            long long neighborKey = makeWorldKey(nx, ny, nz);
-            if (queued.count(neighborKey)) continue;
-
-            Block neighbor = getBlockWorld(nx, ny, nz);
-            if (!neighbor.isAir()) continue;
-
-            if (spreadLight > neighbor.skyLight) {
-                setBlockWorldLight(nx, ny, nz, spreadLight);
-
-                lightQueue.push(std::make_tuple(nx, ny, nz));
-                queued.insert(neighborKey);
-            }
-        }
+    while (!lightQueue.empty()) {
+        uint16_t packed = lightQueue.pop();
+        int x = packed >> 12;
+        int y = (packed >> 4) & 0xFF;
+        int z = packed & 0xF;
+
+        unsigned short spreadLight = decayBlockLight(blocks[x][y][z].blockLight);
+        if (spreadLight == 0) continue;
+
+        if (x > 0) spreadBlockLight(lightQueue, x - 1, y, z, spreadLight);
+        if (x < CHUNK_SIZE_X - 1) spreadBlockLight(lightQueue, x + 1, y, z, spreadLight);
+        if (y > 0) spreadBlockLight(lightQueue, x, y - 1, z, spreadLight);
+        if (y < CHUNK_SIZE_Y - 1) spreadBlockLight(lightQueue, x, y + 1, z, spreadLight);
+        if (z > 0) spreadBlockLight(lightQueue, x, y, z - 1, spreadLight);
+        if (z < CHUNK_SIZE_Z - 1) spreadBlockLight(lightQueue, x, y, z + 1, spreadLight);
     }
 }
 
-// Helper to set light across chunks
-void Chunk::setBlockWorldLight(int worldX, int worldY, int worldZ, unsigned char lightLevel) {
-    if (worldY < 0 || worldY >= CHUNK_SIZE_Y) return;
-
-    int targetChunkX = worldX / CHUNK_SIZE_X;
-    if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) targetChunkX--;
+void Chunk::spreadBlockLight(RingQueue<uint16_t>& lightQueue, int x, int y, int z, unsigned short light) {
+    Block& neighbor = blocks[x][y][z];
+    if (!neighbor.isTransparent()) return;
 
-    int targetChunkZ = worldZ / CHUNK_SIZE_Z;
-    if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) targetChunkZ--;
+    unsigned short merged = maxBlockLight(neighbor.blockLight, light);
+    if (merged == neighbor.blockLight) return;
 
-    if (targetChunkX == chunkX && targetChunkZ == chunkZ) {
-        int localX = worldX - (chunkX * CHUNK_SIZE_X);
-        int localZ = worldZ - (chunkZ * CHUNK_SIZE_Z);
-        blocks[localX][worldY][localZ].skyLight = lightLevel;
-        return;
-    }
-
-    int deltaX = targetChunkX - chunkX;
-    int deltaZ = targetChunkZ - chunkZ;
-
-    if (deltaX == 0 && deltaZ == 1 && neighbors[0]) {
-        neighbors[0]->setBlockWorldLight(worldX, worldY, worldZ, lightLevel);
-    }
-    else if (deltaX == 0 && deltaZ == -1 && neighbors[1]) {
-        neighbors[1]->setBlockWorldLight(worldX, worldY, worldZ, lightLevel);
-    }
-    else if (deltaX == 1 && deltaZ == 0 && neighbors[2]) {
-        neighbors[2]->setBlockWorldLight(worldX, worldY, worldZ, lightLevel);
-    }
-    else if (deltaX == -1 && deltaZ == 0 && neighbors[3]) {
-        neighbors[3]->setBlockWorldLight(worldX, worldY, worldZ, lightLevel);
-    }
+    neighbor.blockLight = merged;
+    lightQueue.push(packLocal(x, y, z));
 }
 
 void Chunk::updateSkyLightLevel(unsigned char newMaxSkyLight) {
@@ -396,220 +297,243 @@ void Chunk::updateSkyLightLevel(unsigned char newMaxSkyLight) {
     }
 }
 
-void Chunk::buildMesh() {
-    buildMeshForType(BlockType::GRASS);
-    buildMeshForType(BlockType::DIRT);
-    buildMeshForType(BlockType::STONE);
-    buildMeshForType(BlockType::SAND);
+// =============================
+// Meshing
+// =============================
+namespace {
+    // Chunk plus a one-voxel border on every side, local coords -1..size
+    constexpr int PADDED_X = CHUNK_SIZE_X + 2;
+    constexpr int PADDED_Y = CHUNK_SIZE_Y + 2;
+    constexpr int PADDED_Z = CHUNK_SIZE_Z + 2;
+
+    inline int paddedIndex(int x, int y, int z) {
+        return ((x + 1) * PADDED_Y + (y + 1)) * PADDED_Z + (z + 1);
+    }
+
+    // Corner offsets are in render space (Z negated) along with the UVs
+    struct FaceVertex {
+        float x, y, z;
+        float u, v;
+    };
+
+    struct FaceDef {
+        int dx, dy, dz;      // Neighbor in front of the face (block space)
+        float nx, ny, nz;    // Normal written to the vertex
+        FaceVertex vertices[4];
+    };
+
+    const FaceDef FACES[6] = {
+        // Top
+        { 0, 1, 0,   0.0f, 1.0f, 0.0f, {
+            { -0.5f, 0.5f,  0.5f,  0.25f, 0.666f },
+            {  0.5f, 0.5f,  0.5f,  0.5f,  0.666f },
+            {  0.5f, 0.5f, -0.5f,  0.5f,  1.0f   },
+            { -0.5f, 0.5f, -0.5f,  0.25f, 1.0f   } } },
+        // Bottom
+        { 0, -1, 0,  0.0f, -1.0f, 0.0f, {
+            { -0.5f, -0.5f, -0.5f,  0.25f, 0.0f   },
+            {  0.5f, -0.5f, -0.5f,  0.5f,  0.0f   },
+            {  0.5f, -0.5f,  0.5f,  0.5f,  0.333f },
+            { -0.5f, -0.5f,  0.5f,  0.25f, 0.333f } } },
+        // South
+        { 0, 0, -1,  0.0f, 0.0f, -1.0f, {
+            { -0.5f, -0.5f, 0.5f,  0.25f, 0.333f },
+            {  0.5f, -0.5f, 0.5f,  0.5f,  0.333f },
+            {  0.5f,  0.5f, 0.5f,  0.5f,  0.666f },
+            { -0.5f,  0.5f, 0.5f,  0.25f, 0.666f } } },
+        // North
+        { 0, 0, 1,   0.0f, 0.0f, 1.0f, {
+            {  0.5f, -0.5f, -0.5f,  0.75f, 0.333f },
+            { -0.5f, -0.5f, -0.5f,  1.0f,  0.333f },
+            { -0.5f,  0.5f, -0.5f,  1.0f,  0.666f },
+            {  0.5f,  0.5f, -0.5f,  0.75f, 0.666f } } },
+        // East
+        { 1, 0, 0,   1.0f, 0.0f, 0.0f, {
+            { 0.5f, -0.5f,  0.5f,  0.5f,  0.333f },
+            { 0.5f, -0.5f, -0.5f,  0.75f, 0.333f },
+            { 0.5f,  0.5f, -0.5f,  0.75f, 0.666f },
+            { 0.5f,  0.5f,  0.5f,  0.5f,  0.666f } } },
+        // West
+        { -1, 0, 0,  -1.0f, 0.0f, 0.0f, {
+            { -0.5f, -0.5f, -0.5f,  0.0f,  0.333f },
+            { -0.5f, -0.5f,  0.5f,  0.25f, 0.333f },
+            { -0.5f,  0.5f,  0.5f,  0.25f, 0.666f },
+            { -0.5f,  0.5f, -0.5f,  0.0f,  0.666f } } },
+    };
+
+    // CROSS blocks: two vertical quads along the diagonals, textured with
+    // the side cell. Drawn from both sides, so each is indexed twice.
+    const FaceDef CROSS_QUADS[2] = {
+        { 0, 0, 0,   0.7071f, 0.0f, 0.7071f, {
+            { -0.5f, -0.5f,  0.5f,  0.25f, 0.333f },
+            {  0.5f, -0.5f, -0.5f,  0.5f,  0.333f },
+            {  0.5f,  0.5f, -0.5f,  0.5f,  0.666f },
+            { -0.5f,  0.5f,  0.5f,  0.25f, 0.666f } } },
+        { 0, 0, 0,   -0.7071f, 0.0f, 0.7071f, {
+            { -0.5f, -0.5f, -0.5f,  0.25f, 0.333f },
+            {  0.5f, -0.5f,  0.5f,  0.5f,  0.333f },
+            {  0.5f,  0.5f,  0.5f,  0.5f,  0.666f },
+            { -0.5f,  0.5f, -0.5f,  0.25f, 0.666f } } },
+    };
+
+    // A face is hidden by an opaque block in front of it, or by another
+    // block of the same type when that type says so (no walls inside a
+    // pool of water or a pane of glass)
+    inline bool isFaceHidden(const Block& block, const Block& front) {
+        const BlockProperties& properties = getBlockProperties(front.type);
+        return properties.opaque || (properties.hidesSameType && front.type == block.type);
+    }
+
 }
 
-void Chunk::buildMeshForType(BlockType targetType) {
-    std::vector<float> vertices;
-    std::vector<unsigned int> indices;
-    unsigned int vertexCount = 0;
+const Chunk* Chunk::neighborAt(int dx, int dz) const {
+    // [dx + 1][dz + 1] -> neighbor direction
+    static const int directions[3][3] = {
+        { 7, 3, 5 },
+        { 1, -1, 0 },
+        { 6, 2, 4 }
+    };
+
+    int direction = directions[dx + 1][dz + 1];
+    return direction < 0 ? this : neighbors[direction];
+}
+
+// Unloaded neighbors read as stone so no faces are built against them;
+// below the world is dark air and above it is open sky
+void Chunk::gatherNeighborhood(std::vector<Block>& padded) const {
+    padded.resize(PADDED_X * PADDED_Y * PADDED_Z);
+
+    Block openSky(BlockType::AIR);
+    openSky.skyLight = 15;
+    const Block unloaded(BlockType::STONE);
+    const Block belowWorld(BlockType::AIR);
+
+    for (int x = -1; x <= CHUNK_SIZE_X; x++) {
+        for (int z = -1; z <= CHUNK_SIZE_Z; z++) {
+            int dx = x < 0 ? -1 : (x >= CHUNK_SIZE_X ? 1 : 0);
+            int dz = z < 0 ? -1 : (z >= CHUNK_SIZE_Z ? 1 : 0);
+            const Chunk* source = neighborAt(dx, dz);
+            int localX = x - dx * CHUNK_SIZE_X;
+            int localZ = z - dz * CHUNK_SIZE_Z;
+
+            padded[paddedIndex(x, -1, z)] = belowWorld;
+            padded[paddedIndex(x, CHUNK_SIZE_Y, z)] = openSky;
+
+            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+                padded[paddedIndex(x, y, z)] = source ? source->blocks[localX][y][localZ] : unloaded;
+            }
+        }
+    }
+}
+
+// One pass over the chunk for every block type. Each face vertex gets
+// smooth light and AO from the padded neighborhood, so sampling across
+// chunk borders costs the same as inside the chunk.
+void Chunk::buildMeshData(std::map<BlockType, ChunkMeshBuffers>& buffers) const {
+    static thread_local std::vector<Block> padded;
+    gatherNeighborhood(padded);
+
+    buffers.clear();
+    ChunkMeshBuffers* meshes[BLOCK_TYPE_COUNT] = {};  // One map lookup per type, not per block
 
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
         for (int y = 0; y < CHUNK_SIZE_Y; y++) {
             for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                Block block = getBlock(x, y, z);
+                const Block& block = blocks[x][y][z];
+                if (block.isAir()) continue;
 
-                if (block.isAir() || block.type != targetType) continue;
+                ChunkMeshBuffers*& cached = meshes[static_cast<int>(block.type)];
+                if (!cached) cached = &buffers[block.type];
+                ChunkMeshBuffers& mesh = *cached;
+                unsigned short emission = getLightEmission(block.type);
 
                 float worldX = chunkX * CHUNK_SIZE_X + x;
                 float worldY = y;
                 float worldZ = -(chunkZ * CHUNK_SIZE_Z + z);
 
-                int blockWorldX = chunkX * CHUNK_SIZE_X + x;
-                int blockWorldY = y;
-                int blockWorldZ = chunkZ * CHUNK_SIZE_Z + z;
-
-                // Top face
-                if (getBlockWorld(blockWorldX, blockWorldY + 1, blockWorldZ).isAir()) {
-                    Block airBlock = getBlockWorld(blockWorldX, blockWorldY + 1, blockWorldZ);
-                    float lightLevel = airBlock.skyLight / 15.0f;
-
-                    vertices.insert(vertices.end(), {
-                        worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f,   0.25f, 0.666f,  0.0f, 1.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f,   0.5f,  0.666f,  0.0f, 1.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f,   0.5f,  1.0f,    0.0f, 1.0f, 0.0f,  lightLevel,
-                        worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f,   0.25f, 1.0f,    0.0f, 1.0f, 0.0f,  lightLevel
-                        });
-                    indices.insert(indices.end(), {
-                        vertexCount, vertexCount + 1, vertexCount + 2,
-                        vertexCount + 2, vertexCount + 3, vertexCount
-                        });
-                    vertexCount += 4;
-                }
-
-                // Bottom face
-                if (getBlockWorld(blockWorldX, blockWorldY - 1, blockWorldZ).isAir()) {
-                    Block airBlock = getBlockWorld(blockWorldX, blockWorldY - 1, blockWorldZ);
-                    float lightLevel = airBlock.skyLight / 15.0f;
-
-                    vertices.insert(vertices.end(), {
-                        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f,   0.25f, 0.0f,    0.0f, -1.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f,   0.5f,  0.0f,    0.0f, -1.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f,   0.5f,  0.333f,  0.0f, -1.0f, 0.0f,  lightLevel,
-                        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f,   0.25f, 0.333f,  0.0f, -1.0f, 0.0f,  lightLevel
-                        });
-                    indices.insert(indices.end(), {
-                        vertexCount, vertexCount + 1, vertexCount + 2,
-                        vertexCount + 2, vertexCount + 3, vertexCount
-                        });
-                    vertexCount += 4;
-                }
-
-                // South face
-                if (getBlockWorld(blockWorldX, blockWorldY, blockWorldZ - 1).isAir()) {
-                    Block airBlock = getBlockWorld(blockWorldX, blockWorldY, blockWorldZ - 1);
-                    float lightLevel = airBlock.skyLight / 15.0f;
-
-                    vertices.insert(vertices.end(), {
-                        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f,   0.25f, 0.333f,  0.0f, 0.0f, -1.0f,  lightLevel,
-                        worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f,   0.5f,  0.333f,  0.0f, 0.0f, -1.0f,  lightLevel,
-                        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f,   0.5f,  0.666f,  0.0f, 0.0f, -1.0f,  lightLevel,
-                        worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f,   0.25f, 0.666f,  0.0f, 0.0f, -1.0f,  lightLevel
-                        });
-                    indices.insert(indices.end(), {
-                        vertexCount, vertexCount + 1, vertexCount + 2,
-                        vertexCount + 2, vertexCount + 3, vertexCount
-                        });
-                    vertexCount += 4;
-                }
-
-                // North face
-                if (getBlockWorld(blockWorldX, blockWorldY, blockWorldZ + 1).isAir()) {
-                    Block airBlock = getBlockWorld(blockWorldX, blockWorldY, blockWorldZ + 1);
-                    float lightLevel = airBlock.skyLight / 15.0f;
-
-                    vertices.insert(vertices.end(), {
-                        worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f,   0.75f, 0.333f,  0.0f, 0.0f, 1.0f,  lightLevel,
-                        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f,   1.0f,  0.333f,  0.0f, 0.0f, 1.0f,  lightLevel,
-                        worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f,   1.0f,  0.666f,  0.0f, 0.0f, 1.0f,  lightLevel,
-                        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f,   0.75f, 0.666f,  0.0f, 0.0f, 1.0f,  lightLevel
-                        });
-                    indices.insert(indices.end(), {
-                        vertexCount, vertexCount + 1, vertexCount + 2,
-                        vertexCount + 2, vertexCount + 3, vertexCount
-                        });
-                    vertexCount += 4;
-                }
-
-                // East face
-                if (getBlockWorld(blockWorldX + 1, blockWorldY, blockWorldZ).isAir()) {
-                    Block airBlock = getBlockWorld(blockWorldX + 1, blockWorldY, blockWorldZ);
-                    float lightLevel = airBlock.skyLight / 15.0f;
-
-                    vertices.insert(vertices.end(), {
-                        worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f,   0.5f,  0.333f,  1.0f, 0.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f,   0.75f, 0.333f,  1.0f, 0.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f,   0.75f, 0.666f,  1.0f, 0.0f, 0.0f,  lightLevel,
-                        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f,   0.5f,  0.666f,  1.0f, 0.0f, 0.0f,  lightLevel
-                        });
-                    indices.insert(indices.end(), {
-                        vertexCount, vertexCount + 1, vertexCount + 2,
-                        vertexCount + 2, vertexCount + 3, vertexCount
-                        });
-                    vertexCount += 4;
+                if (getBlockProperties(block.type).shape == BlockShape::CROSS) {
+                    // Lit by the block's own cell, no AO
+                    VertexLight light = computeVertexLight(block, block, block, block);
+                    for (const FaceDef& quad : CROSS_QUADS) {
+                        for (const FaceVertex& vertex : quad.vertices) {
+                            mesh.vertices.insert(mesh.vertices.end(), {
+                                worldX + vertex.x, worldY + vertex.y, worldZ + vertex.z,   vertex.u, vertex.v,
+                                quad.nx, quad.ny, quad.nz,   light.sky, light.red, light.green, light.blue, light.ao
+                                });
+                        }
+
+                        unsigned int base = mesh.vertexCount;
+                        mesh.indices.insert(mesh.indices.end(), {
+                            base, base + 1, base + 2,   base + 2, base + 3, base,
+                            base, base + 3, base + 2,   base + 2, base + 1, base
+                            });
+                        mesh.vertexCount += 4;
+                    }
+                    continue;
                 }
 
-                // West face
-                if (getBlockWorld(blockWorldX - 1, blockWorldY, blockWorldZ).isAir()) {
-                    Block airBlock = getBlockWorld(blockWorldX - 1, blockWorldY, blockWorldZ);
-                    float lightLevel = airBlock.skyLight / 15.0f;
-
-                    vertices.insert(vertices.end(), {
-                        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f,   0.0f,  0.333f,  -1.0f, 0.0f, 0.0f,  lightLevel,
-                        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f,   0.25f, 0.333f,  -1.0f, 0.0f, 0.0f,  lightLevel,
-                        worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f,   0.25f, 0.666f,  -1.0f, 0.0f, 0.0f,  lightLevel,
-                        worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f,   0.0f,  0.666f,  -1.0f, 0.0f, 0.0f,  lightLevel
-                        });
-                    indices.insert(indices.end(), {
-                        vertexCount, vertexCount + 1, vertexCount + 2,
-                        vertexCount + 2, vertexCount + 3, vertexCount
-                        });
-                    vertexCount += 4;
+                for (const FaceDef& face : FACES) {
+                    int fx = x + face.dx;
+                    int fy = y + face.dy;
+                    int fz = z + face.dz;
+
+                    const Block& front = padded[paddedIndex(fx, fy, fz)];
+                    if (isFaceHidden(block, front)) continue;
+
+                    VertexLight corners[4];
+                    for (int i = 0; i < 4; i++) {
+                        const FaceVertex& vertex = face.vertices[i];
+
+                        // Block-space direction of this corner along the face's two tangent axes
+                        int sx = face.dx != 0 ? 0 : (vertex.x > 0.0f ? 1 : -1);
+                        int sy = face.dy != 0 ? 0 : (vertex.y > 0.0f ? 1 : -1);
+                        int sz = face.dz != 0 ? 0 : (vertex.z > 0.0f ? -1 : 1);
+
+                        int s1x = 0, s1y = 0, s1z = 0;
+                        int s2x = 0, s2y = 0, s2z = 0;
+                        if (face.dx != 0) { s1y = sy; s2z = sz; }
+                        else if (face.dy != 0) { s1x = sx; s2z = sz; }
+                        else { s1x = sx; s2y = sy; }
+
+                        corners[i] = computeVertexLight(front,
+                            padded[paddedIndex(fx + s1x, fy + s1y, fz + s1z)],
+                            padded[paddedIndex(fx + s2x, fy + s2y, fz + s2z)],
+                            padded[paddedIndex(fx + sx, fy + sy, fz + sz)]);
+
+                        // Light blocks glow at full strength and are not occluded
+                        if (emission != 0) {
+                            corners[i].red = std::max(corners[i].red, blockLightChannel(emission, BLOCK_LIGHT_RED_SHIFT) / 15.0f);
+                            corners[i].green = std::max(corners[i].green, blockLightChannel(emission, BLOCK_LIGHT_GREEN_SHIFT) / 15.0f);
+                            corners[i].blue = std::max(corners[i].blue, blockLightChannel(emission, BLOCK_LIGHT_BLUE_SHIFT) / 15.0f);
+                            corners[i].ao = 1.0f;
+                        }
+                    }
+
+                    for (int i = 0; i < 4; i++) {
+                        const FaceVertex& vertex = face.vertices[i];
+                        const VertexLight& light = corners[i];
+                        mesh.vertices.insert(mesh.vertices.end(), {
+                            worldX + vertex.x, worldY + vertex.y, worldZ + vertex.z,   vertex.u, vertex.v,
+                            face.nx, face.ny, face.nz,   light.sky, light.red, light.green, light.blue, light.ao
+                            });
+                    }
+
+                    unsigned int base = mesh.vertexCount;
+                    if (flipQuadDiagonal(corners)) {
+                        mesh.indices.insert(mesh.indices.end(), {
+                            base + 1, base + 2, base + 3,
+                            base + 3, base, base + 1
+                            });
+                    }
+                    else {
+                        mesh.indices.insert(mesh.indices.end(), {
+                            base, base + 1, base + 2,
+                            base + 2, base + 3, base
+                            });
+                    }
+                    mesh.vertexCount += 4;
                 }
             }
         }
     }
-
-    if (indices.size() > 0) {
-        MeshData mesh;
-        mesh.indexCount = indices.size();
-        setupMesh(mesh, vertices, indices);
-        meshes[targetType] = mesh;
-    }
-    else {
-        auto it = meshes.find(targetType);
-        if (it != meshes.end()) {
-            if (it->second.VAO) glDeleteVertexArrays(1, &it->second.VAO);
-            if (it->second.VBO) glDeleteBuffers(1, &it->second.VBO);
-            if (it->second.EBO) glDeleteBuffers(1, &it->second.EBO);
-            meshes.erase(it);
-        }
-    }
 }
-
-void Chunk::setupMesh(MeshData& mesh, const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
-    glGenVertexArrays(1, &mesh.VAO);
-    glGenBuffers(1, &mesh.VBO);
-    glGenBuffers(1, &mesh.EBO);
-
-    glBindVertexArray(mesh.VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Texture coordinate attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Normal attribute
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(5 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // Light level attribute
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(8 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-
-    glBindVertexArray(0);
-}
-
-void Chunk::render() {
-    for (auto& pair : meshes) {
-        MeshData& mesh = pair.second;
-        if (mesh.indexCount == 0) continue;
-
-        glBindVertexArray(mesh.VAO);
-        glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-    }
-}
-
-void Chunk::renderType(BlockType type) {
-    if (meshes.find(type) == meshes.end()) return;
-
-    MeshData& mesh = meshes[type];
-    if (mesh.indexCount == 0) return;
-
-    glBindVertexArray(mesh.VAO);
-    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-}
-
-void Chunk::initializeLightTexture() {
-    glGenTextures(1, &lightTexture);
-    glBindTexture(GL_TEXTURE_3D, lightTexture);
-    glTexImage3D(GL_TEXTURE_3D, 0, GL_R8UI, CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glBindTexture(GL_TEXTURE_3D, 0);
-}
\ No newline at end of file
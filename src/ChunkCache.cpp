@@ -0,0 +1,111 @@
+#include "ChunkCache.h"
+
+ChunkCache::ChunkCache(size_t maxBytes)
+    : maxBytes(maxBytes) {
+}
+
+long long ChunkCache::makeKey(int x, int z) const {
+    return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+}
+
+// =============================
+// Store (RLE in memory order)
+// =============================
+void ChunkCache::store(const Chunk& chunk) {
+    Entry entry;
+    entry.key = makeKey(chunk.chunkX, chunk.chunkZ);
+
+    // Most chunks compress to a few thousand runs
+    entry.runs.reserve(4096);
+
+    Run current = { 0, 0, 0 };
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                const Block& block = chunk.blocks[x][y][z];
+                uint8_t type = static_cast<uint8_t>(block.type);
+                uint8_t fluidLevel = block.fluidLevel;
+
+                if (current.length > 0 && current.type == type && current.fluidLevel == fluidLevel &&
+                    current.length < UINT16_MAX) {
+                    current.length++;
+                    continue;
+                }
+
+                if (current.length > 0) entry.runs.push_back(current);
+                current = { type, fluidLevel, 1 };
+            }
+        }
+    }
+    if (current.length > 0) entry.runs.push_back(current);
+    entry.runs.shrink_to_fit();
+
+    // Replace an older copy of the same chunk
+    auto existing = index.find(entry.key);
+    if (existing != index.end()) {
+        stats.bytesUsed -= existing->second->bytes();
+        lru.erase(existing->second);
+        index.erase(existing);
+    }
+
+    size_t entryBytes = entry.bytes();
+    if (entryBytes > maxBytes) return;
+
+    evictUntilFits(entryBytes);
+
+    lru.push_front(std::move(entry));
+    index[lru.front().key] = lru.begin();
+    stats.bytesUsed += entryBytes;
+    stats.entryCount = index.size();
+}
+
+// =============================
+// Take (decompress + remove)
+// =============================
+Chunk* ChunkCache::take(int chunkX, int chunkZ) {
+    auto it = index.find(makeKey(chunkX, chunkZ));
+    if (it == index.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+
+    stats.hits++;
+
+    Chunk* chunk = new Chunk(chunkX, chunkZ);
+    Block* out = &chunk->blocks[0][0][0];
+
+    for (const Run& run : it->second->runs) {
+        Block block(static_cast<BlockType>(run.type));
+        block.fluidLevel = run.fluidLevel;
+        for (int i = 0; i < run.length; i++) {
+            *out++ = block;
+        }
+    }
+
+    chunk->recalculateHeightMap();
+
+    stats.bytesUsed -= it->second->bytes();
+    lru.erase(it->second);
+    index.erase(it);
+    stats.entryCount = index.size();
+
+    return chunk;
+}
+
+void ChunkCache::evictUntilFits(size_t incoming) {
+    while (!lru.empty() && stats.bytesUsed + incoming > maxBytes) {
+        Entry& oldest = lru.back();
+        stats.bytesUsed -= oldest.bytes();
+        index.erase(oldest.key);
+        lru.pop_back();
+        stats.evictions++;
+    }
+    stats.entryCount = index.size();
+}
+
+void ChunkCache::clear() {
+    lru.clear();
+    index.clear();
+    stats.bytesUsed = 0;
+    stats.entryCount = 0;
+}
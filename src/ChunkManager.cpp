@@ -1,6 +1,8 @@
 #include "ChunkManager.h"
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <thread>
 
 // =============================
 // Utility
@@ -12,67 +14,32 @@ long long ChunkManager::makeKey(int x, int z) const {
 // =============================
 // Constructor / Destructor
 // =============================
+// Leave cores for the render thread; terrain generation is thread-safe
 ChunkManager::ChunkManager(int rd, const std::string& worldName)
     : renderDistance(rd),
     renderDistanceSquared(rd* rd),
     lastPlayerChunkX(INT_MAX),
     lastPlayerChunkZ(INT_MAX),
-    shouldStop(false),
-    worldSave(std::make_unique<WorldSave>(worldName))
+    pipeline(worldName, CHUNK_CACHE_BYTES, std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2)))
 {
-    generationThread = std::thread(&ChunkManager::generationWorker, this);
 }
 
-ChunkManager::~ChunkManager() {
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        shouldStop = true;
-    }
-    queueCV.notify_all();
-    generationThread.join();
-
-    for (auto& [_, chunk] : chunks) {
-        delete chunk;
-    }
-    chunks.clear();
-}
+ChunkManager::~ChunkManager() = default;
 
 // =============================
-// Threaded Generation
+// Main Update - GPU OPTIMIZED VERSION
 // =============================
-void ChunkManager::generationWorker() {
-    while (true) {
-        std::pair<int, int> coords;
-
-        {
-            std::unique_lock<std::mutex> lock(mutex);
-            queueCV.wait(lock, [&] {
-                return shouldStop || !generationQueue.empty();
-                });
-
-            if (shouldStop) return;
-
-            coords = generationQueue.front();
-            generationQueue.pop();
-        }
-
-        Chunk* chunk = new Chunk(coords.first, coords.second);
-        TerrainGenerator::generateFlatTerrain(*chunk);
+void ChunkManager::update(float playerX, float playerZ, float viewX, float viewZ) {
+    auto [playerChunkX, playerChunkZ] = worldToChunkCoords(playerX, playerZ);
 
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            readyChunks.push(chunk);
-            chunksBeingGenerated.erase({ coords.first, coords.second });
-            queuedChunks.erase(makeKey(coords.first, coords.second));
-        }
+    // Render space -Z is chunk space +Z
+    float dirLength = std::sqrt(viewX * viewX + viewZ * viewZ);
+    if (dirLength > 0.001f) {
+        viewDirX = viewX / dirLength;
+        viewDirZ = -viewZ / dirLength;
     }
-}
 
-// =============================
-// Main Update - GPU OPTIMIZED VERSION
-// =============================
-void ChunkManager::update(float playerX, float playerZ) {
-    auto [playerChunkX, playerChunkZ] = worldToChunkCoords(playerX, playerZ);
+    updatePlayerMotion(playerX, playerZ);
 
     if (playerChunkX != lastPlayerChunkX || playerChunkZ != lastPlayerChunkZ) {
         lastPlayerChunkX = playerChunkX;
@@ -80,56 +47,149 @@ void ChunkManager::update(float playerX, float playerZ) {
 
         updateDesiredChunks(playerChunkX, playerChunkZ);
     }
+    else if (viewDirX * prioritizedDirX + viewDirZ * prioritizedDirZ < REPRIORITIZE_VIEW_COS) {
+        // Turned around without changing chunk: re-sort what is still pending
+        submitGenerationRequests();
+    }
 
     processReadyChunks();
+    updateViewCompletion();
 
     // Auto-save check
-    if (worldSave) {
-        worldSave->autoSaveCheck();
-    }
+    pipeline.getWorldSave().autoSaveCheck();
 }
 
 // =============================
 // Update desired chunks in radius
 // =============================
 void ChunkManager::updateDesiredChunks(int pcx, int pcz) {
-    std::vector<ChunkDistanceEntry> ordered;
-    ordered.reserve((renderDistance * 2 + 1) * (renderDistance * 2 + 1));
-
-    for (int dx = -renderDistance; dx <= renderDistance; dx++) {
-        for (int dz = -renderDistance; dz <= renderDistance; dz++) {
-            int distSq = dx * dx + dz * dz;
-            if (distSq <= renderDistanceSquared) {
-                ordered.push_back({ pcx + dx, pcz + dz, distSq });
+    // Generation order comes from generationPriority when the requests are submitted
+    std::vector<std::pair<int, int>> desired;
+    desired.reserve((renderDistance * 2 + 3) * (renderDistance * 2 + 3));
+
+    for (int dx = -renderDistance - 1; dx <= renderDistance + 1; dx++) {
+        for (int dz = -renderDistance - 1; dz <= renderDistance + 1; dz++) {
+            if (isInLoadRange(dx, dz)) {
+                desired.push_back({ pcx + dx, pcz + dz });
             }
         }
     }
 
-    std::sort(ordered.begin(), ordered.end(), [](const ChunkDistanceEntry& a, const ChunkDistanceEntry& b) {
-        return a.distSq < b.distSq;
-        });
+    unloadDistantChunks(pcx, pcz);
 
-    std::unordered_set<long long> desired;
-    desired.reserve(ordered.size());
-    for (const auto& entry : ordered) {
-        desired.insert(makeKey(entry.x, entry.z));
+    for (const auto& [cx, cz] : desired) {
+        pipeline.request(cx, cz);
     }
 
-    unloadDistantChunks(pcx, pcz);
+    // Drop requests that fell out of range and re-key the rest for the new position
+    submitGenerationRequests();
+}
+
+// =============================
+// Generation priority
+// =============================
+// Squared distance from where the player is heading (current chunk plus
+// velocity * PREDICTION_SECONDS), stretched for chunks outside the view
+// frustum so that visible chunks along the flight path generate first
+float ChunkManager::generationPriority(int cx, int cz) const {
+    int dx = cx - lastPlayerChunkX;
+    int dz = cz - lastPlayerChunkZ;
+    if (dx == 0 && dz == 0) return 0.0f;
+
+    float aheadX = velocityX * PREDICTION_SECONDS;
+    float aheadZ = velocityZ * PREDICTION_SECONDS;
+    float aheadLength = std::sqrt(aheadX * aheadX + aheadZ * aheadZ);
+    float maxAhead = renderDistance * 0.5f;
+    if (aheadLength > maxAhead) {
+        aheadX *= maxAhead / aheadLength;
+        aheadZ *= maxAhead / aheadLength;
+    }
+
+    float px = dx - aheadX;
+    float pz = dz - aheadZ;
+    float distSq = px * px + pz * pz;
+
+    if (isInViewFrustum(dx, dz)) return distSq;
+
+    float alignment = (dx * viewDirX + dz * viewDirZ) / std::sqrt(static_cast<float>(dx * dx + dz * dz));
+    return distSq * (1.0f + OUTSIDE_FRUSTUM_WEIGHT * (1.0f - alignment));
+}
+
+bool ChunkManager::isInViewFrustum(int dx, int dz) const {
+    float distSq = static_cast<float>(dx * dx + dz * dz);
+    if (distSq <= 2.0f) return true;  // Adjacent chunks are always (partly) on screen
 
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        for (const auto& entry : ordered) {
-            long long key = makeKey(entry.x, entry.z);
-            if (chunks.count(key) || queuedChunks.count(key)) continue;
+    float dist = std::sqrt(distSq);
+    float alignment = (dx * viewDirX + dz * viewDirZ) / dist;
+    float angle = std::acos(std::max(-1.0f, std::min(1.0f, alignment)));
+
+    // Widen by the angle the chunk's half diagonal covers at this distance
+    return angle <= viewHalfFov + std::atan(0.7071f / dist);
+}
 
-            queuedChunks.insert(key);
-            generationQueue.push({ entry.x, entry.z });
-            chunksBeingGenerated.insert({ entry.x, entry.z });
+void ChunkManager::updatePlayerMotion(float playerX, float playerZ) {
+    auto now = std::chrono::steady_clock::now();
+
+    // Chunk space: render -Z is +Z
+    float chunkSpaceX = playerX / CHUNK_SIZE_X;
+    float chunkSpaceZ = -playerZ / CHUNK_SIZE_Z;
+
+    if (hasLastUpdate) {
+        float dt = std::chrono::duration<float>(now - lastUpdateTime).count();
+        if (dt > 0.0f) {
+            float blend = std::min(1.0f, dt * 4.0f);  // ~250ms smoothing
+            velocityX += ((chunkSpaceX - lastPlayerX) / dt - velocityX) * blend;
+            velocityZ += ((chunkSpaceZ - lastPlayerZ) / dt - velocityZ) * blend;
         }
     }
 
-    queueCV.notify_all();
+    lastPlayerX = chunkSpaceX;
+    lastPlayerZ = chunkSpaceZ;
+    lastUpdateTime = now;
+    hasLastUpdate = true;
+}
+
+bool ChunkManager::isInLoadRange(int dx, int dz) const {
+    return ChunkPipeline::isInLoadRange(dx, dz, renderDistance);
+}
+
+// Tracks how long the visible part of the render distance has holes in it
+void ChunkManager::updateViewCompletion() {
+    int missing = 0;
+    for (int dx = -renderDistance; dx <= renderDistance; dx++) {
+        for (int dz = -renderDistance; dz <= renderDistance; dz++) {
+            if (dx * dx + dz * dz > renderDistanceSquared) continue;
+            if (!isInViewFrustum(dx, dz)) continue;
+            Chunk* chunk = findChunk(lastPlayerChunkX + dx, lastPlayerChunkZ + dz);
+            if (!chunk || chunk->state != ChunkState::Meshed) missing++;
+        }
+    }
+    viewCompletion.missingVisible = missing;
+
+    auto now = std::chrono::steady_clock::now();
+    if (missing > 0 && !viewIncomplete) {
+        viewIncomplete = true;
+        viewIncompleteSince = now;
+    }
+    else if (missing == 0 && viewIncomplete) {
+        viewIncomplete = false;
+        float ms = std::chrono::duration<float, std::milli>(now - viewIncompleteSince).count();
+        viewCompletion.lastMs = ms;
+        viewCompletion.worstMs = std::max(viewCompletion.worstMs, ms);
+        viewCompletion.totalMs += ms;
+        viewCompletion.completions++;
+    }
+}
+
+void ChunkManager::submitGenerationRequests() {
+    pipeline.submitRequests([this](int cx, int cz) {
+        // Out of range: cancel before a worker picks it up
+        if (!isInLoadRange(cx - lastPlayerChunkX, cz - lastPlayerChunkZ)) return -1.0f;
+        return generationPriority(cx, cz);
+        });
+
+    prioritizedDirX = viewDirX;
+    prioritizedDirZ = viewDirZ;
 }
 
 // =============================
@@ -138,18 +198,15 @@ void ChunkManager::updateDesiredChunks(int pcx, int pcz) {
 void ChunkManager::unloadDistantChunks(int playerChunkX, int playerChunkZ) {
     std::vector<std::pair<int, int>> toUnload;
 
-    {
-        std::lock_guard<std::mutex> lock(chunksMutex);
-        for (auto& [key, chunk] : chunks) {
-            int cx = static_cast<int>(key >> 32);
-            int cz = static_cast<int>(key & 0xffffffff);
-            int dx = cx - playerChunkX;
-            int dz = cz - playerChunkZ;
-            float distance = std::sqrt(dx * dx + dz * dz);
-
-            if (distance > renderDistance + 2) {
-                toUnload.push_back({ cx, cz });
-            }
+    for (auto& [key, chunk] : pipeline.getChunks()) {
+        int cx = chunk->chunkX;
+        int cz = chunk->chunkZ;
+        int dx = cx - playerChunkX;
+        int dz = cz - playerChunkZ;
+        float distance = std::sqrt(dx * dx + dz * dz);
+
+        if (distance > renderDistance + 2) {
+            toUnload.push_back({ cx, cz });
         }
     }
 
@@ -158,134 +215,216 @@ void ChunkManager::unloadDistantChunks(int playerChunkX, int playerChunkZ) {
     }
 
     if (!toUnload.empty()) {
-        std::cout << "Unloaded " << toUnload.size() << " chunks\n";
+        const ChunkCache::Stats& stats = pipeline.getCacheStats();
+        std::cout << "Unloaded " << toUnload.size() << " chunks (cache: "
+            << stats.entryCount << " chunks, " << (stats.bytesUsed / 1024) << " KB, "
+            << static_cast<int>(stats.hitRate() * 100.0f) << "% hit rate)\n";
     }
 }
 
 // =============================
 // Chunk Load / Unload
 // =============================
-bool ChunkManager::isChunkLoaded(int cx, int cz) {
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    return chunks.count(makeKey(cx, cz)) > 0;
-}
-
-void ChunkManager::loadChunk(int cx, int cz) {
-    std::lock_guard<std::mutex> lock(mutex);
-    long long key = makeKey(cx, cz);
-    if (queuedChunks.count(key)) return;
-
-    queuedChunks.insert(key);
-    generationQueue.push({ cx, cz });
-    queueCV.notify_all();
+bool ChunkManager::isChunkLoaded(int cx, int cz) const {
+    return findChunk(cx, cz) != nullptr;
 }
 
 void ChunkManager::unloadChunk(int cx, int cz) {
-    long long key = makeKey(cx, cz);
-
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    auto it = chunks.find(key);
-    if (it != chunks.end()) {
-        delete it->second;
-        chunks.erase(it);
+    Chunk* chunk = findChunk(cx, cz);
+    if (!chunk) return;
+
+    pendingMeshRebuilds.erase(chunk);
+    blockTicks.dropChunk(cx, cz);
+    if (lastQueriedChunk == chunk) lastQueriedChunk = nullptr;
+    if (chunk->state == ChunkState::Meshed) {
+        ChunkMeshUpdate& update = meshUpdates[makeKey(cx, cz)];
+        update.chunkX = cx;
+        update.chunkZ = cz;
+        update.removed = true;
+        update.buffers.clear();
     }
+    pipeline.unload(chunk);
 }
 
 // =============================
-// UPDATED: Integrate Ready Chunks with Flood Fill
+// Integrate Ready Chunks within a per-frame time budget
 // =============================
 void ChunkManager::processReadyChunks() {
-    const int maxPerFrame = 4;  // Reduced to prevent FPS drops
-
-    for (int i = 0; i < maxPerFrame; i++) {
-        Chunk* chunk = nullptr;
-
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            if (readyChunks.empty()) return;
-            chunk = readyChunks.front();
-            readyChunks.pop();
-            long long key = makeKey(chunk->chunkX, chunk->chunkZ);
-            chunks[key] = chunk;
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point frameStart = Clock::now();
+    float frameMs = hasIntegrationFrame
+        ? std::chrono::duration<float, std::milli>(frameStart - lastIntegrationFrame).count()
+        : 0.0f;
+    lastIntegrationFrame = frameStart;
+    hasIntegrationFrame = true;
+
+    float budgetMs = integrationProfile.beginFrame(frameMs);
+    float spentMs = 0.0f;
+    int integrated = 0;
+
+    Clock::time_point stageStart;
+    auto endStage = [&](IntegrationStage stage) {
+        Clock::time_point now = Clock::now();
+        float ms = std::chrono::duration<float, std::milli>(now - stageStart).count();
+        integrationProfile.addStageTime(stage, ms);
+        spentMs += ms;
+        stageStart = now;
+    };
+
+    // Always integrate at least one chunk so a tiny budget can't stall loading
+    while (integrated == 0 || spentMs + integrationProfile.estimatedChunkMs() <= budgetMs) {
+        Chunk* chunk = pipeline.popReady();
+        if (!chunk) break;
+
+        // Player moved away while this was generating: it would be unloaded immediately
+        int dx = chunk->chunkX - lastPlayerChunkX;
+        int dz = chunk->chunkZ - lastPlayerChunkZ;
+        if (std::sqrt(static_cast<float>(dx * dx + dz * dz)) > renderDistance + 2) {
+            pipeline.discard(chunk);
+            continue;
         }
 
-        // Apply saved modifications
-        std::vector<ModifiedBlock> modifications;
-        worldSave->loadChunkModifications(chunk->chunkX, chunk->chunkZ, modifications);
-        for (auto& mod : modifications) {
-            int localX = mod.x - chunk->chunkX * CHUNK_SIZE_X;
-            int localZ = mod.z - chunk->chunkZ * CHUNK_SIZE_Z;
-            chunk->setBlock(localX, mod.y, localZ, mod.type);
+        stageStart = Clock::now();
+
+        // Link neighbors, then wake fluid whose ticks were dropped when it
+        // was unloaded (or never scheduled: saves don't keep ticks)
+        pipeline.insert(chunk);
+        scheduleFluidTicks(chunk);
+        endStage(IntegrationStage::Linking);
+
+        // Cross-chunk propagation for this chunk and any neighbor whose
+        // 3x3 neighborhood it completed
+        relitChunks.clear();
+        readyToMesh.clear();
+        pipeline.exchangeBorderLight(chunk, relitChunks, readyToMesh);
+        endStage(IntegrationStage::BorderLight);
+
+        // Already meshed chunks are rebuilt only if their light changed;
+        // chunks that just became ready get their first (normally only) mesh
+        for (Chunk* dirty : relitChunks) {
+            if (dirty->state != ChunkState::Meshed) continue;
+            meshChunk(dirty);
+            meshStats.rebuilds++;
         }
+        for (Chunk* ready : readyToMesh) {
+            meshChunk(ready);
+            ready->state = ChunkState::Meshed;
+            meshStats.initialBuilds++;
+        }
+        meshStats.chunksLoaded++;
+        endStage(IntegrationStage::Meshing);
 
-        // Calculate sky light (includes internal propagation)
-        chunk->calculateSkyLight(15);  // ALWAYS 15
-
-        // Link neighbors
-        linkChunkNeighbors(chunk);
+        integrationProfile.chunkIntegrated();
+        integrated++;
+    }
 
-        // Cross-chunk propagation
-        chunk->propagateSkyLightFloodFill();
+    integrationProfile.endFrame();
+}
 
-        // Build mesh
-        chunk->buildMesh();
-    }
+bool ChunkManager::exportIntegrationProfile(const std::string& path) const {
+    return integrationProfile.exportCSV(path);
 }
 
 
-// =============================
-// Neighbor Linking
-// =============================
-void ChunkManager::linkChunkNeighbors(Chunk* chunk) {
-    static const int dx[4] = { 0,0,1,-1 };
-    static const int dz[4] = { 1,-1,0,0 };
-
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    for (int i = 0; i < 4; i++) {
-        long long key = makeKey(chunk->chunkX + dx[i], chunk->chunkZ + dz[i]);
-        auto it = chunks.find(key);
-        if (it != chunks.end()) {
-            chunk->setNeighbor(i, it->second);
-            it->second->setNeighbor(i ^ 1, chunk);
-            it->second->buildMesh();
-        }
-    }
+// Main thread only, like every access to loaded chunks
+Chunk* ChunkManager::findChunk(int cx, int cz) const {
+    return pipeline.findChunk(cx, cz);
 }
 
 // =============================
-// Rendering
+// Mesh hand-off to the renderer
 // =============================
-void ChunkManager::render() {
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    for (auto& [_, chunk] : chunks) {
-        chunk->render();
-    }
+void ChunkManager::meshChunk(Chunk* chunk) {
+    ChunkMeshUpdate& update = meshUpdates[makeKey(chunk->chunkX, chunk->chunkZ)];
+    update.chunkX = chunk->chunkX;
+    update.chunkZ = chunk->chunkZ;
+    update.removed = false;
+    chunk->buildMeshData(update.buffers);
 }
 
-void ChunkManager::renderType(BlockType type) {
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    for (auto& [_, chunk] : chunks) {
-        chunk->renderType(type);
+void ChunkManager::takeMeshUpdates(std::vector<ChunkMeshUpdate>& updates) {
+    updates.reserve(updates.size() + meshUpdates.size());
+    for (auto& [_, update] : meshUpdates) {
+        updates.push_back(std::move(update));
     }
+    meshUpdates.clear();
 }
 
 // =============================
 // Block Query
 // =============================
-Block* ChunkManager::getBlockAt(int worldX, int worldY, int worldZ) {
+// Collision, raycasts and the debug overlay query runs of blocks in the
+// same chunk, so remember the last one instead of hashing every time.
+// Cleared in unloadChunk.
+Chunk* ChunkManager::findChunkCached(int cx, int cz) const {
+    if (lastQueriedChunk && lastQueriedChunk->chunkX == cx && lastQueriedChunk->chunkZ == cz) {
+        return lastQueriedChunk;
+    }
+
+    Chunk* chunk = findChunk(cx, cz);
+    if (chunk) lastQueriedChunk = chunk;
+    return chunk;
+}
+
+std::optional<Block> ChunkManager::getBlockAt(int worldX, int worldY, int worldZ) const {
     int cx = worldX / CHUNK_SIZE_X;
     if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) cx--;
     int cz = worldZ / CHUNK_SIZE_Z;
     if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) cz--;
 
-    int lx = worldX - cx * CHUNK_SIZE_X;
-    int lz = worldZ - cz * CHUNK_SIZE_Z;
+    const Chunk* chunk = findChunkCached(cx, cz);
+    if (!chunk) return std::nullopt;
+
+    return chunk->getBlock(worldX - cx * CHUNK_SIZE_X, worldY, worldZ - cz * CHUNK_SIZE_Z);
+}
 
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    auto it = chunks.find(makeKey(cx, cz));
-    if (it == chunks.end()) return nullptr;
+void ChunkManager::getBlocksInRegion(int minX, int minY, int minZ, int maxX, int maxY, int maxZ,
+    BlockRegion& region) const {
+    region.minX = minX;
+    region.minY = minY;
+    region.minZ = minZ;
+    region.sizeX = std::max(maxX - minX + 1, 0);
+    region.sizeY = std::max(maxY - minY + 1, 0);
+    region.sizeZ = std::max(maxZ - minZ + 1, 0);
+    region.blocks.assign(static_cast<size_t>(region.sizeX) * region.sizeY * region.sizeZ, Block());
+    region.missingChunks = false;
+
+    int firstY = std::max(minY, 0);
+    int lastY = std::min(maxY, CHUNK_SIZE_Y - 1);
+    if (region.blocks.empty() || firstY > lastY) return;
+
+    auto chunkCoord = [](int world, int size) {
+        int chunk = world / size;
+        if (world < 0 && world % size != 0) chunk--;
+        return chunk;
+    };
+
+    // One lookup per overlapped chunk, then straight copies of z runs,
+    // which are contiguous in both Chunk::blocks and the region
+    for (int cx = chunkCoord(minX, CHUNK_SIZE_X); cx <= chunkCoord(maxX, CHUNK_SIZE_X); cx++) {
+        for (int cz = chunkCoord(minZ, CHUNK_SIZE_Z); cz <= chunkCoord(maxZ, CHUNK_SIZE_Z); cz++) {
+            const Chunk* chunk = findChunkCached(cx, cz);
+            if (!chunk) {
+                region.missingChunks = true;
+                continue;
+            }
 
-    return new Block(it->second->getBlock(lx, worldY, lz));
+            int baseX = cx * CHUNK_SIZE_X;
+            int baseZ = cz * CHUNK_SIZE_Z;
+            int firstX = std::max(minX, baseX);
+            int lastX = std::min(maxX, baseX + CHUNK_SIZE_X - 1);
+            int firstZ = std::max(minZ, baseZ);
+            int runLength = std::min(maxZ, baseZ + CHUNK_SIZE_Z - 1) - firstZ + 1;
+
+            for (int x = firstX; x <= lastX; x++) {
+                for (int y = firstY; y <= lastY; y++) {
+                    const Block* source = &chunk->blocks[x - baseX][y][firstZ - baseZ];
+                    std::copy(source, source + runLength, &region.blocks[region.indexOf(x, y, firstZ)]);
+                }
+            }
+        }
+    }
 }
 
 // =============================
@@ -297,92 +436,173 @@ std::pair<int, int> ChunkManager::worldToChunkCoords(float x, float z) {
     return { cx, cz };
 }
 
-bool ChunkManager::setBlockAt(int worldX, int worldY, int worldZ, BlockType type) {
-    int chunkX = worldX / CHUNK_SIZE_X;
-    if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) chunkX--;
+// Relights incrementally and saves the edit; affected chunks are
+// remeshed by rebuildChunkMeshAt / flushMeshRebuilds
+bool ChunkManager::setBlockAt(int worldX, int worldY, int worldZ, BlockType type, unsigned char fluidLevel) {
+    if (!pipeline.setBlock(worldX, worldY, worldZ, type, fluidLevel, pendingMeshRebuilds)) return false;
 
-    int chunkZ = worldZ / CHUNK_SIZE_Z;
-    if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) chunkZ--;
+    scheduleTicksAround(worldX, worldY, worldZ);
+    return true;
+}
 
-    int localX = worldX - chunkX * CHUNK_SIZE_X;
-    int localZ = worldZ - chunkZ * CHUNK_SIZE_Z;
+void ChunkManager::scheduleTicksAround(int worldX, int worldY, int worldZ) {
+    static const int OFFSETS[7][3] = {
+        { 0, 0, 0 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
 
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    long long key = makeKey(chunkX, chunkZ);
-    auto it = chunks.find(key);
-    if (it == chunks.end()) return false;
+    for (const auto& offset : OFFSETS) {
+        int x = worldX + offset[0];
+        int y = worldY + offset[1];
+        int z = worldZ + offset[2];
 
-    it->second->setBlock(localX, worldY, localZ, type);
+        std::optional<Block> block = getBlockAt(x, y, z);
+        if (!block) continue;
 
-    // SAVE THE MODIFICATION
-    worldSave->saveBlockChange(worldX, worldY, worldZ, type);
+        unsigned char delay = getBlockProperties(block->type).tickDelay;
+        if (delay != 0) blockTicks.schedule(x, y, z, delay);
+    }
+}
 
-    return true;
+// A fluid block needs a tick unless it is a source with nowhere to go:
+// flowing fluid may have lost its feeder, and a source next to (or above)
+// an open block would spread. Neighbors in unloaded chunks are skipped;
+// the fluid is looked at again when they load.
+void ChunkManager::scheduleIfUnsettled(int worldX, int worldY, int worldZ, const Block& block) {
+    unsigned char delay = getBlockProperties(block.type).tickDelay;
+    if (delay == 0) return;
+
+    bool unsettled = block.fluidLevel != FLUID_SOURCE;
+    static const int OFFSETS[5][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    for (int i = 0; i < 5 && !unsettled; i++) {
+        std::optional<Block> neighbor = getBlockAt(worldX + OFFSETS[i][0], worldY + OFFSETS[i][1], worldZ + OFFSETS[i][2]);
+        unsettled = neighbor && getBlockProperties(neighbor->type).replaceable;
+    }
+
+    if (unsettled) blockTicks.schedule(worldX, worldY, worldZ, delay);
+}
+
+void ChunkManager::scheduleFluidTicks(Chunk* chunk) {
+    int baseX = chunk->chunkX * CHUNK_SIZE_X;
+    int baseZ = chunk->chunkZ * CHUNK_SIZE_Z;
+
+    // Found by the worker; the chunk has not been edited since
+    for (uint16_t packed : chunk->tickingBlocks) {
+        int x = packed >> 12;
+        int y = (packed >> 4) & 0xFF;
+        int z = packed & 0xF;
+        scheduleIfUnsettled(baseX + x, y, baseZ + z, chunk->blocks[x][y][z]);
+    }
+    std::vector<uint16_t>().swap(chunk->tickingBlocks);
+
+    // Side neighbors: the column of blocks touching this chunk, whose
+    // sources could not flow while it was missing
+    for (int direction = 0; direction < 4; direction++) {
+        Chunk* neighbor = chunk->getNeighbor(direction);
+        if (!neighbor) continue;
+
+        int edgeX = NEIGHBOR_DX[direction] == 0 ? -1 : (NEIGHBOR_DX[direction] > 0 ? 0 : CHUNK_SIZE_X - 1);
+        int edgeZ = NEIGHBOR_DZ[direction] == 0 ? -1 : (NEIGHBOR_DZ[direction] > 0 ? 0 : CHUNK_SIZE_Z - 1);
+        int neighborBaseX = neighbor->chunkX * CHUNK_SIZE_X;
+        int neighborBaseZ = neighbor->chunkZ * CHUNK_SIZE_Z;
+
+        int edgeLength = edgeX >= 0 ? CHUNK_SIZE_Z : CHUNK_SIZE_X;
+        for (int i = 0; i < edgeLength; i++) {
+            int x = edgeX >= 0 ? edgeX : i;
+            int z = edgeZ >= 0 ? edgeZ : i;
+            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+                const Block& block = neighbor->blocks[x][y][z];
+                if (getBlockProperties(block.type).tickDelay != 0) {
+                    scheduleIfUnsettled(neighborBaseX + x, y, neighborBaseZ + z, block);
+                }
+            }
+        }
+    }
 }
 
 // =============================
-// UPDATED: Rebuild with Comprehensive Flood Fill
+// Rebuild meshes touched by a block edit
 // =============================
-// CRITICAL: When block changes, do proper increase/decrease passes
+// Lighting was already updated incrementally in setBlockAt; this only
+// remeshes the edited chunk, any neighbor (diagonals included) whose
+// border vertices sample the edited voxel, and the chunks whose light
+// changed.
 void ChunkManager::rebuildChunkMeshAt(int worldX, int worldY, int worldZ) {
+    queueMeshRebuildAt(worldX, worldZ);
+    flushMeshRebuilds();
+}
+
+void ChunkManager::queueMeshRebuildAt(int worldX, int worldZ) {
     int chunkX = worldX / CHUNK_SIZE_X;
     if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) chunkX--;
 
     int chunkZ = worldZ / CHUNK_SIZE_Z;
     if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) chunkZ--;
 
-    std::lock_guard<std::mutex> lock(chunksMutex);
+    int localX = worldX - chunkX * CHUNK_SIZE_X;
+    int localZ = worldZ - chunkZ * CHUNK_SIZE_Z;
 
-    // Recalculate light for center + neighbors
-    long long key = makeKey(chunkX, chunkZ);
-    auto it = chunks.find(key);
-    if (it != chunks.end()) {
-        it->second->calculateSkyLight(15);
-    }
+    auto markChunk = [&](int cx, int cz) {
+        if (Chunk* chunk = findChunk(cx, cz)) pendingMeshRebuilds.insert(chunk);
+    };
 
-    static const int dx[4] = { 0, 0, 1, -1 };
-    static const int dz[4] = { 1, -1, 0, 0 };
+    int dx = localX == 0 ? -1 : (localX == CHUNK_SIZE_X - 1 ? 1 : 0);
+    int dz = localZ == 0 ? -1 : (localZ == CHUNK_SIZE_Z - 1 ? 1 : 0);
 
-    for (int dir = 0; dir < 4; dir++) {
-        long long neighborKey = makeKey(chunkX + dx[dir], chunkZ + dz[dir]);
-        auto neighbor = chunks.find(neighborKey);
-        if (neighbor != chunks.end()) {
-            neighbor->second->calculateSkyLight(15);
-        }
-    }
+    markChunk(chunkX, chunkZ);
+    if (dx != 0) markChunk(chunkX + dx, chunkZ);
+    if (dz != 0) markChunk(chunkX, chunkZ + dz);
+    if (dx != 0 && dz != 0) markChunk(chunkX + dx, chunkZ + dz);
+}
 
-    // Cross-chunk propagation from center + neighbors
-    if (it != chunks.end()) {
-        it->second->propagateSkyLightFloodFill();
-    }
+void ChunkManager::flushMeshRebuilds() {
+    flushMeshRebuilds(std::numeric_limits<float>::infinity());
+}
 
-    for (int dir = 0; dir < 4; dir++) {
-        long long neighborKey = makeKey(chunkX + dx[dir], chunkZ + dz[dir]);
-        auto neighbor = chunks.find(neighborKey);
-        if (neighbor != chunks.end()) {
-            neighbor->second->propagateSkyLightFloodFill();
-        }
-    }
+void ChunkManager::flushMeshRebuilds(float budgetMs) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
 
-    // Rebuild meshes
-    if (it != chunks.end()) {
-        it->second->buildMesh();
+    // Chunks that haven't reached Meshed yet pick the edit up when they do
+    meshRebuildOrder.clear();
+    for (Chunk* chunk : pendingMeshRebuilds) {
+        if (chunk->state == ChunkState::Meshed) meshRebuildOrder.push_back(chunk);
     }
+    pendingMeshRebuilds.clear();
+
+    // Nearest first (then by position, so the order never depends on hashing)
+    auto distanceSquared = [this](const Chunk* chunk) {
+        long long dx = static_cast<long long>(chunk->chunkX) - lastPlayerChunkX;
+        long long dz = static_cast<long long>(chunk->chunkZ) - lastPlayerChunkZ;
+        return dx * dx + dz * dz;
+    };
+    std::sort(meshRebuildOrder.begin(), meshRebuildOrder.end(), [&](const Chunk* a, const Chunk* b) {
+        long long distanceA = distanceSquared(a);
+        long long distanceB = distanceSquared(b);
+        if (distanceA != distanceB) return distanceA < distanceB;
+        return a->chunkX != b->chunkX ? a->chunkX < b->chunkX : a->chunkZ < b->chunkZ;
+        });
 
-    for (int dir = 0; dir < 4; dir++) {
-        long long neighborKey = makeKey(chunkX + dx[dir], chunkZ + dz[dir]);
-        auto neighbor = chunks.find(neighborKey);
-        if (neighbor != chunks.end()) {
-            neighbor->second->buildMesh();
-        }
+    size_t rebuilt = 0;
+    Clock::time_point rebuildStart = start;
+    for (; rebuilt < meshRebuildOrder.size(); rebuilt++) {
+        float spentMs = std::chrono::duration<float, std::milli>(rebuildStart - start).count();
+        if (rebuilt > 0 && spentMs + averageRebuildMs > budgetMs) break;
+
+        meshChunk(meshRebuildOrder[rebuilt]);
+        meshStats.rebuilds++;
+
+        Clock::time_point now = Clock::now();
+        float ms = std::chrono::duration<float, std::milli>(now - rebuildStart).count();
+        averageRebuildMs = averageRebuildMs == 0.0f ? ms : averageRebuildMs * 0.9f + ms * 0.1f;
+        rebuildStart = now;
     }
+    pendingMeshRebuilds.insert(meshRebuildOrder.begin() + rebuilt, meshRebuildOrder.end());
 }
 
 std::vector<Chunk*> ChunkManager::getLoadedChunks() {
     std::vector<Chunk*> loaded;
-    std::lock_guard<std::mutex> lock(chunksMutex);
-    loaded.reserve(chunks.size());
-    for (auto& pair : chunks) {
+    loaded.reserve(pipeline.getChunks().size());
+    for (auto& pair : pipeline.getChunks()) {
         loaded.push_back(pair.second);
     }
     return loaded;
@@ -0,0 +1,280 @@
+#include "ChunkPipeline.h"
+#include "TerrainGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+// =============================
+// Utility
+// =============================
+long long ChunkPipeline::makeKey(int x, int z) {
+    return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+}
+
+bool ChunkPipeline::isInLoadRange(int dx, int dz, int renderDistance) {
+    int nearX = std::max(std::abs(dx) - 1, 0);
+    int nearZ = std::max(std::abs(dz) - 1, 0);
+    return nearX * nearX + nearZ * nearZ <= renderDistance * renderDistance;
+}
+
+// =============================
+// Constructor / Destructor
+// =============================
+ChunkPipeline::ChunkPipeline(const std::string& worldName, size_t cacheBytes, unsigned int workerCount)
+    : worldSave(std::make_unique<WorldSave>(worldName)),
+    chunkCache(cacheBytes),
+    lightEngine([this](int cx, int cz) { return findChunk(cx, cz); })
+{
+    for (unsigned int i = 0; i < std::max(1u, workerCount); i++) {
+        workers.emplace_back(&ChunkPipeline::generationWorker, this);
+    }
+}
+
+ChunkPipeline::~ChunkPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(generationMutex);
+        shouldStop = true;
+    }
+    queueCV.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (const GenerationRequest& request : generationQueue) {
+        delete request.restored;
+    }
+
+    Chunk* pending = nullptr;
+    while (readyChunks.pop(pending)) {
+        delete pending;
+    }
+
+    for (auto& [_, chunk] : chunks) {
+        delete chunk;
+    }
+    chunks.clear();
+}
+
+// =============================
+// Threaded Generation
+// =============================
+void ChunkPipeline::generationWorker() {
+    while (true) {
+        GenerationRequest request;
+
+        {
+            std::unique_lock<std::mutex> lock(generationMutex);
+            queueCV.wait(lock, [&] {
+                return shouldStop || !generationQueue.empty();
+                });
+
+            if (shouldStop) return;
+
+            std::pop_heap(generationQueue.begin(), generationQueue.end(), GenerationRequestCompare());
+            request = generationQueue.back();
+            generationQueue.pop_back();
+        }
+
+        // Everything that only touches this chunk happens here, off the owner thread
+        Chunk* chunk = request.restored;
+        if (!chunk) {
+            chunk = new Chunk(request.x, request.z);
+            TerrainGenerator::generateFlatTerrain(*chunk);
+
+            std::vector<ModifiedBlock> modifications;
+            worldSave->loadChunkModifications(chunk->chunkX, chunk->chunkZ, modifications);
+            for (auto& mod : modifications) {
+                int localX = mod.x - chunk->chunkX * CHUNK_SIZE_X;
+                int localZ = mod.z - chunk->chunkZ * CHUNK_SIZE_Z;
+                chunk->setBlock(localX, mod.y, localZ, mod.type, mod.fluidLevel);
+            }
+        }
+
+        chunk->calculateSkyLight(15);  // ALWAYS 15
+        chunk->calculateBlockLight();
+        chunk->collectTickingBlocks();
+        chunk->state = ChunkState::Lit;
+
+        while (!readyChunks.push(chunk)) {
+            if (shouldStop) {
+                delete chunk;
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+// =============================
+// Requests
+// =============================
+bool ChunkPipeline::request(int chunkX, int chunkZ) {
+    long long key = makeKey(chunkX, chunkZ);
+    if (chunks.count(key) || queuedChunks.count(key)) return false;
+
+    queuedChunks.insert(key);
+
+    // Recently unloaded? Restore it instead of regenerating; it still
+    // goes through the workers to be relit
+    Chunk* cached = chunkCache.take(chunkX, chunkZ);
+    if (cached) cached->restoredFromCache = true;
+    else stats.requested++;
+
+    newRequests.push_back({ chunkX, chunkZ, 0.0f, cached });
+    return true;
+}
+
+void ChunkPipeline::submitRequests(const PriorityFunction& priority) {
+    {
+        std::lock_guard<std::mutex> lock(generationMutex);
+
+        // Drop requests nobody wants any more, before a worker picks them up
+        size_t kept = 0;
+        for (size_t i = 0; i < generationQueue.size(); i++) {
+            GenerationRequest request = generationQueue[i];
+            request.priority = priority(request.x, request.z);
+            if (request.priority < 0.0f) {
+                cancel(request);
+                continue;
+            }
+            generationQueue[kept++] = request;
+        }
+        generationQueue.resize(kept);
+
+        for (GenerationRequest request : newRequests) {
+            request.priority = priority(request.x, request.z);
+            if (request.priority < 0.0f) {
+                cancel(request);
+                continue;
+            }
+            generationQueue.push_back(request);
+        }
+        std::make_heap(generationQueue.begin(), generationQueue.end(), GenerationRequestCompare());
+    }
+
+    newRequests.clear();
+    queueCV.notify_all();
+}
+
+// Restored chunks go back to the cache untouched
+void ChunkPipeline::cancel(const GenerationRequest& request) {
+    queuedChunks.erase(makeKey(request.x, request.z));
+    if (request.restored) {
+        chunkCache.store(*request.restored);
+        delete request.restored;
+    }
+    else {
+        stats.cancelled++;
+    }
+}
+
+// =============================
+// Integration
+// =============================
+Chunk* ChunkPipeline::popReady() {
+    Chunk* chunk = nullptr;
+    if (!readyChunks.pop(chunk)) return nullptr;
+
+    queuedChunks.erase(makeKey(chunk->chunkX, chunk->chunkZ));
+    if (chunk->restoredFromCache) stats.restored++;
+    else stats.completed++;
+    return chunk;
+}
+
+void ChunkPipeline::discard(Chunk* chunk) {
+    if (chunk->restoredFromCache) chunkCache.store(*chunk);
+    else stats.wasted++;
+    delete chunk;
+}
+
+void ChunkPipeline::insert(Chunk* chunk) {
+    chunks[makeKey(chunk->chunkX, chunk->chunkZ)] = chunk;
+
+    for (int i = 0; i < NEIGHBOR_COUNT; i++) {
+        Chunk* neighbor = findChunk(chunk->chunkX + NEIGHBOR_DX[i], chunk->chunkZ + NEIGHBOR_DZ[i]);
+        if (!neighbor) continue;
+        chunk->setNeighbor(i, neighbor);
+        neighbor->setNeighbor(oppositeNeighbor(i), chunk);
+    }
+}
+
+void ChunkPipeline::exchangeBorderLight(Chunk* chunk, std::unordered_set<Chunk*>& relit,
+    std::vector<Chunk*>& becameReady) {
+    updateReadiness(chunk, relit, becameReady);
+    for (int i = 0; i < NEIGHBOR_COUNT; i++) {
+        if (Chunk* neighbor = chunk->getNeighbor(i)) updateReadiness(neighbor, relit, becameReady);
+    }
+}
+
+// Lit -> NeighborsReady: border light depends on the four side neighbors
+// and the mesh (face culling, smooth light and AO at the corners) on all
+// eight, so both wait until the whole 3x3 neighborhood is linked and then
+// run exactly once. Chunks on the outer load ring stay Lit.
+void ChunkPipeline::updateReadiness(Chunk* chunk, std::unordered_set<Chunk*>& relit,
+    std::vector<Chunk*>& becameReady) {
+    if (chunk->state != ChunkState::Lit || !chunk->hasAllNeighbors()) return;
+
+    lightEngine.propagateChunkBorders(chunk, relit);
+    chunk->state = ChunkState::NeighborsReady;
+    becameReady.push_back(chunk);
+}
+
+void ChunkPipeline::unload(Chunk* chunk) {
+    // Unlink so remaining neighbors don't keep a dangling pointer
+    for (int i = 0; i < NEIGHBOR_COUNT; i++) {
+        Chunk* neighbor = chunk->getNeighbor(i);
+        if (neighbor) neighbor->setNeighbor(oppositeNeighbor(i), nullptr);
+    }
+
+    chunks.erase(makeKey(chunk->chunkX, chunk->chunkZ));
+    chunkCache.store(*chunk);
+    delete chunk;
+    stats.unloaded++;
+}
+
+// =============================
+// Edits and queries
+// =============================
+std::optional<Block> ChunkPipeline::setBlock(int worldX, int worldY, int worldZ, BlockType type,
+    unsigned char fluidLevel, std::unordered_set<Chunk*>& relit) {
+    if (worldY < 0 || worldY >= CHUNK_SIZE_Y) return std::nullopt;
+
+    int chunkX = worldX / CHUNK_SIZE_X;
+    if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) chunkX--;
+
+    int chunkZ = worldZ / CHUNK_SIZE_Z;
+    if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) chunkZ--;
+
+    Chunk* chunk = findChunk(chunkX, chunkZ);
+    if (!chunk) return std::nullopt;
+
+    int localX = worldX - chunkX * CHUNK_SIZE_X;
+    int localZ = worldZ - chunkZ * CHUNK_SIZE_Z;
+
+    Block oldBlock = chunk->getBlock(localX, worldY, localZ);
+    chunk->setBlock(localX, worldY, localZ, type, fluidLevel);
+
+    lightEngine.updateSkyLightAt(worldX, worldY, worldZ, oldBlock, relit);
+    lightEngine.updateBlockLightAt(worldX, worldY, worldZ, oldBlock, relit);
+
+    worldSave->saveBlockChange(worldX, worldY, worldZ, type, fluidLevel);
+    return oldBlock;
+}
+
+Chunk* ChunkPipeline::findChunk(int chunkX, int chunkZ) const {
+    auto it = chunks.find(makeKey(chunkX, chunkZ));
+    return it != chunks.end() ? it->second : nullptr;
+}
+
+std::optional<Block> ChunkPipeline::getBlock(int worldX, int worldY, int worldZ) const {
+    int chunkX = worldX / CHUNK_SIZE_X;
+    if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) chunkX--;
+
+    int chunkZ = worldZ / CHUNK_SIZE_Z;
+    if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) chunkZ--;
+
+    const Chunk* chunk = findChunk(chunkX, chunkZ);
+    if (!chunk) return std::nullopt;
+
+    return chunk->getBlock(worldX - chunkX * CHUNK_SIZE_X, worldY, worldZ - chunkZ * CHUNK_SIZE_Z);
+}
@@ -0,0 +1,95 @@
+#include "Entity/EntityPhysics.h"
+#include "BoxCollision.h"
+#include "ChunkManager.h"
+
+void EntityPhysics::update(EntityWorld& world, const ChunkManager& chunkManager, float tickSeconds) {
+    simulatedCount = 0;
+    frozenCount = 0;
+
+    collectChunks(world);
+
+    for (const ChunkSpan& span : chunkSpans) {
+        bool loaded = chunkManager.isChunkLoaded(span.chunkX, span.chunkZ);
+
+        for (size_t i = span.begin; i < span.end; i++) {
+            uint32_t entity = chunkOrder[i];
+            PhysicsBody* body = world.bodies.get(entity);
+            Transform* transform = world.transforms.get(entity);
+            if (!body || !transform) continue;
+
+            Velocity* velocity = world.velocities.get(entity);
+
+            transform->previousX = transform->x;
+            transform->previousY = transform->y;
+            transform->previousZ = transform->z;
+
+            if (!loaded || !velocity) {
+                frozenCount++;
+                continue;
+            }
+
+            // Same integration as Player::applyPhysics, kept aside until
+            // the move is known to be valid
+            Velocity next = *velocity;
+            if (!body->onGround) {
+                next.y += GRAVITY * tickSeconds;
+                if (next.y < MAX_FALL_SPEED) {
+                    next.y = MAX_FALL_SPEED;
+                }
+            }
+            else {
+                next.y = -0.08f;
+            }
+
+            next.x *= DRAG;
+            next.z *= DRAG;
+
+            CollisionBox box = {
+                transform->x - body->halfWidth, transform->y, transform->z - body->halfWidth,
+                transform->x + body->halfWidth, transform->y + body->height, transform->z + body->halfWidth
+            };
+            BoxSweepResult sweep = sweepBox(chunkManager, box, next.x * tickSeconds, next.y * tickSeconds, next.z * tickSeconds);
+
+            // Missing terrain reads as air: stay put, as if the chunk were
+            // unloaded, instead of walking or falling into it
+            if (sweep.touchedUnloaded) {
+                frozenCount++;
+                continue;
+            }
+
+            transform->x += sweep.moveX;
+            transform->y += sweep.moveY;
+            transform->z += sweep.moveZ;
+
+            body->blockedHorizontally = sweep.blockedX || sweep.blockedZ;
+            if (sweep.blockedX) next.x = 0.0f;
+            if (sweep.blockedZ) next.z = 0.0f;
+            if (sweep.blockedY) {
+                body->onGround = next.y < 0.0f;
+                next.y = 0.0f;
+            }
+            else if (sweep.moveY != 0.0f) {
+                body->onGround = false;
+            }
+            *velocity = next;
+
+            world.spatial.update(entity, transform->x, transform->y, transform->z);
+            simulatedCount++;
+        }
+    }
+}
+
+// Every chunk's entities are taken up front: moving an entity updates the
+// spatial hash, and one that crossed into a chunk not simulated yet must
+// not be simulated twice
+void EntityPhysics::collectChunks(const EntityWorld& world) {
+    chunkSpans.clear();
+    chunkOrder.clear();
+
+    world.spatial.getOccupiedChunks(occupiedChunks);
+    for (auto& [chunkX, chunkZ] : occupiedChunks) {
+        world.spatial.queryChunk(chunkX, chunkZ, chunkEntities);
+        chunkSpans.push_back({ chunkX, chunkZ, chunkOrder.size(), chunkOrder.size() + chunkEntities.size() });
+        chunkOrder.insert(chunkOrder.end(), chunkEntities.begin(), chunkEntities.end());
+    }
+}
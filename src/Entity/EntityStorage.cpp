@@ -0,0 +1,196 @@
+#include "Entity/EntityStorage.h"
+#include "ChunkManager.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+EntityStorage::EntityStorage(const std::string& worldName) : worldName(worldName) {
+    loadFromDisk();
+}
+
+EntityStorage::~EntityStorage() {
+    flush();
+}
+
+// =============================
+// Chunk load / unload
+// =============================
+void EntityStorage::update(EntityWorld& world, const ChunkManager& chunkManager) {
+    world.spatial.getOccupiedChunks(occupiedChunks);
+    for (auto& [chunkX, chunkZ] : occupiedChunks) {
+        if (!chunkManager.isChunkLoaded(chunkX, chunkZ)) storeChunk(world, chunkX, chunkZ);
+    }
+
+    restoredKeys.clear();
+    for (auto& [key, entities] : storedChunks) {
+        int chunkX = static_cast<int>(key >> 32);
+        int chunkZ = static_cast<int>(static_cast<uint32_t>(key));
+        if (!chunkManager.isChunkLoaded(chunkX, chunkZ)) continue;
+
+        restoreChunk(world, entities);
+        storedEntities -= entities.size();
+        totalRestored += entities.size();
+        restoredKeys.push_back(key);
+    }
+
+    for (long long key : restoredKeys) storedChunks.erase(key);
+    if (!restoredKeys.empty()) isDirty = true;
+}
+
+void EntityStorage::storeAll(EntityWorld& world) {
+    world.spatial.getOccupiedChunks(occupiedChunks);
+    for (auto& [chunkX, chunkZ] : occupiedChunks) {
+        storeChunk(world, chunkX, chunkZ);
+    }
+}
+
+void EntityStorage::storeChunk(EntityWorld& world, int chunkX, int chunkZ) {
+    world.spatial.queryChunk(chunkX, chunkZ, chunkEntities);
+    if (chunkEntities.empty()) return;
+
+    long long key = makeKey(chunkX, chunkZ);
+    std::vector<StoredEntity>& stored = storedChunks[key];
+    for (uint32_t index : chunkEntities) {
+        const Transform* transform = world.transforms.get(index);
+        if (!transform) {
+            world.spatial.remove(index);
+            continue;
+        }
+
+        StoredEntity entity;
+        entity.transform = *transform;
+        if (const Velocity* velocity = world.velocities.get(index)) {
+            entity.components |= StoredEntity::HAS_VELOCITY;
+            entity.velocity = *velocity;
+        }
+        if (const PhysicsBody* body = world.bodies.get(index)) {
+            entity.components |= StoredEntity::HAS_BODY;
+            entity.body = *body;
+        }
+        stored.push_back(entity);
+        storedEntities++;
+        totalStored++;
+        isDirty = true;
+
+        world.destroy(world.handleOf(index));
+    }
+
+    if (stored.empty()) storedChunks.erase(key);
+}
+
+void EntityStorage::restoreChunk(EntityWorld& world, const std::vector<StoredEntity>& entities) {
+    for (const StoredEntity& stored : entities) {
+        EntityHandle entity = world.create();
+
+        Transform transform = stored.transform;
+        transform.previousX = transform.x;
+        transform.previousY = transform.y;
+        transform.previousZ = transform.z;
+        world.transforms.add(entity.index, transform);
+        if (stored.components & StoredEntity::HAS_VELOCITY) world.velocities.add(entity.index, stored.velocity);
+        if (stored.components & StoredEntity::HAS_BODY) world.bodies.add(entity.index, stored.body);
+
+        world.spatial.update(entity.index, transform.x, transform.y, transform.z);
+    }
+}
+
+long long EntityStorage::makeKey(int x, int z) const {
+    return (static_cast<long long>(x) << 32) ^ static_cast<unsigned int>(z);
+}
+
+// =============================
+// Disk
+// =============================
+std::string EntityStorage::getSaveFilePath() {
+    std::filesystem::create_directories("SavedData/" + worldName);
+    return "SavedData/" + worldName + "/entities.dat";
+}
+
+void EntityStorage::loadFromDisk() {
+    std::string filepath = getSaveFilePath();
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) return;
+
+    int version = 0;
+    int chunkCount = 0;
+    file.read((char*)&version, sizeof(int));
+    file.read((char*)&chunkCount, sizeof(int));
+    if (!file || version != FILE_VERSION) {
+        std::cerr << "Ignoring unreadable entity save: " << filepath << std::endl;
+        return;
+    }
+
+    for (int i = 0; i < chunkCount && file; i++) {
+        int chunkX, chunkZ, count;
+        file.read((char*)&chunkX, sizeof(int));
+        file.read((char*)&chunkZ, sizeof(int));
+        file.read((char*)&count, sizeof(int));
+
+        std::vector<StoredEntity>& entities = storedChunks[makeKey(chunkX, chunkZ)];
+        for (int j = 0; j < count && file; j++) {
+            StoredEntity entity;
+            file.read((char*)&entity.components, sizeof(unsigned char));
+            file.read((char*)&entity.transform.x, sizeof(float));
+            file.read((char*)&entity.transform.y, sizeof(float));
+            file.read((char*)&entity.transform.z, sizeof(float));
+            file.read((char*)&entity.velocity.x, sizeof(float));
+            file.read((char*)&entity.velocity.y, sizeof(float));
+            file.read((char*)&entity.velocity.z, sizeof(float));
+            file.read((char*)&entity.body.halfWidth, sizeof(float));
+            file.read((char*)&entity.body.height, sizeof(float));
+            file.read((char*)&entity.body.onGround, sizeof(bool));
+            if (file) {
+                entities.push_back(entity);
+                storedEntities++;
+            }
+        }
+    }
+
+    std::cout << "Loaded " << storedEntities << " stored entities from: " << filepath << std::endl;
+}
+
+void EntityStorage::saveToDisk() {
+    if (!isDirty) return;
+
+    std::string filepath = getSaveFilePath();
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to save entities to: " << filepath << std::endl;
+        return;
+    }
+
+    int version = FILE_VERSION;
+    int chunkCount = static_cast<int>(storedChunks.size());
+    file.write((char*)&version, sizeof(int));
+    file.write((char*)&chunkCount, sizeof(int));
+
+    for (auto& [key, entities] : storedChunks) {
+        int chunkX = static_cast<int>(key >> 32);
+        int chunkZ = static_cast<int>(static_cast<uint32_t>(key));
+        int count = static_cast<int>(entities.size());
+        file.write((char*)&chunkX, sizeof(int));
+        file.write((char*)&chunkZ, sizeof(int));
+        file.write((char*)&count, sizeof(int));
+
+        for (const StoredEntity& entity : entities) {
+            file.write((char*)&entity.components, sizeof(unsigned char));
+            file.write((char*)&entity.transform.x, sizeof(float));
+            file.write((char*)&entity.transform.y, sizeof(float));
+            file.write((char*)&entity.transform.z, sizeof(float));
+            file.write((char*)&entity.velocity.x, sizeof(float));
+            file.write((char*)&entity.velocity.y, sizeof(float));
+            file.write((char*)&entity.velocity.z, sizeof(float));
+            file.write((char*)&entity.body.halfWidth, sizeof(float));
+            file.write((char*)&entity.body.height, sizeof(float));
+            file.write((char*)&entity.body.onGround, sizeof(bool));
+        }
+    }
+
+    file.close();
+    isDirty = false;
+    std::cout << "Saved " << storedEntities << " stored entities to: " << filepath << std::endl;
+}
+
+void EntityStorage::flush() {
+    saveToDisk();
+}
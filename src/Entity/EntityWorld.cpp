@@ -0,0 +1,36 @@
+#include "Entity/EntityWorld.h"
+
+EntityHandle EntityWorld::create() {
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(generations.size());
+        generations.push_back(0);
+    }
+
+    generations[index]++;  // Even (free) -> odd (alive)
+    aliveCount++;
+    return { index, generations[index] };
+}
+
+void EntityWorld::destroy(EntityHandle entity) {
+    if (!isAlive(entity)) return;
+
+    transforms.remove(entity.index);
+    velocities.remove(entity.index);
+    bodies.remove(entity.index);
+    spatial.remove(entity.index);
+
+    generations[entity.index]++;  // Odd -> even: outstanding handles go stale
+    freeIndices.push_back(entity.index);
+    aliveCount--;
+}
+
+bool EntityWorld::isAlive(EntityHandle entity) const {
+    return entity.index < generations.size()
+        && generations[entity.index] == entity.generation
+        && (entity.generation & 1) != 0;
+}
@@ -0,0 +1,157 @@
+#include "Entity/SpatialHash.h"
+#include "Chunk.h"
+#include <cmath>
+
+static_assert(CHUNK_SIZE_X == CHUNK_SIZE_Z && CHUNK_SIZE_X % SpatialHash::CELL_SIZE == 0,
+    "Spatial hash cells must tile chunks");
+
+// =============================
+// Registration
+// =============================
+void SpatialHash::update(uint32_t entity, float x, float y, float z) {
+    // Block space: blocks are centered on integer x and world z (render z negated)
+    long long key = makeKey(cellCoord(x + 0.5f), cellCoord(-z + 0.5f));
+
+    if (entity >= locations.size()) locations.resize(entity + 1);
+    Location& location = locations[entity];
+
+    if (location.slot != INVALID) {
+        if (location.cell == key) {
+            cells[key][location.slot] = { entity, x, y, z };
+            return;
+        }
+        removeFromCell(location);
+    }
+    else {
+        count++;
+    }
+
+    std::vector<Point>& points = cells[key];
+    location.cell = key;
+    location.slot = static_cast<uint32_t>(points.size());
+    points.push_back({ entity, x, y, z });
+
+    int cellX = static_cast<int>(key >> 32);
+    int cellZ = static_cast<int>(static_cast<uint32_t>(key));
+    chunkCounts[makeKey(floorDiv(cellX, CELLS_PER_CHUNK), floorDiv(cellZ, CELLS_PER_CHUNK))]++;
+}
+
+void SpatialHash::remove(uint32_t entity) {
+    if (!contains(entity)) return;
+
+    removeFromCell(locations[entity]);
+    locations[entity].slot = INVALID;
+    count--;
+}
+
+bool SpatialHash::contains(uint32_t entity) const {
+    return entity < locations.size() && locations[entity].slot != INVALID;
+}
+
+void SpatialHash::removeFromCell(const Location& location) {
+    auto it = cells.find(location.cell);
+    std::vector<Point>& points = it->second;
+
+    // Swap the last point into the hole, like ComponentArray
+    if (location.slot != points.size() - 1) {
+        points[location.slot] = points.back();
+        locations[points[location.slot].entity].slot = location.slot;
+    }
+    points.pop_back();
+    if (points.empty()) cells.erase(it);
+
+    int cellX = static_cast<int>(location.cell >> 32);
+    int cellZ = static_cast<int>(static_cast<uint32_t>(location.cell));
+    auto chunk = chunkCounts.find(makeKey(floorDiv(cellX, CELLS_PER_CHUNK), floorDiv(cellZ, CELLS_PER_CHUNK)));
+    if (--chunk->second == 0) chunkCounts.erase(chunk);
+}
+
+// =============================
+// Queries
+// =============================
+template <typename Fn>
+void SpatialHash::forEachPointInBox(const CollisionBox& box, Fn&& fn) const {
+    int firstX = cellCoord(box.minX + 0.5f);
+    int lastX = cellCoord(box.maxX + 0.5f);
+    int firstZ = cellCoord(-box.maxZ + 0.5f);
+    int lastZ = cellCoord(-box.minZ + 0.5f);
+
+    auto visit = [&](const std::vector<Point>& points) {
+        for (const Point& point : points) {
+            if (point.x >= box.minX && point.x <= box.maxX
+                && point.y >= box.minY && point.y <= box.maxY
+                && point.z >= box.minZ && point.z <= box.maxZ) {
+                fn(point);
+            }
+        }
+    };
+
+    // A box covering more cells than exist is cheaper as a scan of the map
+    double cellsInBox = (static_cast<double>(lastX) - firstX + 1) * (static_cast<double>(lastZ) - firstZ + 1);
+    if (cellsInBox > static_cast<double>(cells.size())) {
+        for (const auto& [key, points] : cells) visit(points);
+        return;
+    }
+
+    for (int cellX = firstX; cellX <= lastX; cellX++) {
+        for (int cellZ = firstZ; cellZ <= lastZ; cellZ++) {
+            auto it = cells.find(makeKey(cellX, cellZ));
+            if (it != cells.end()) visit(it->second);
+        }
+    }
+}
+
+void SpatialHash::queryRadius(float x, float y, float z, float radius, std::vector<uint32_t>& out) const {
+    out.clear();
+    float radiusSquared = radius * radius;
+    CollisionBox bounds = { x - radius, y - radius, z - radius, x + radius, y + radius, z + radius };
+
+    forEachPointInBox(bounds, [&](const Point& point) {
+        float dx = point.x - x;
+        float dy = point.y - y;
+        float dz = point.z - z;
+        if (dx * dx + dy * dy + dz * dz <= radiusSquared) out.push_back(point.entity);
+    });
+}
+
+void SpatialHash::queryBox(const CollisionBox& box, std::vector<uint32_t>& out) const {
+    out.clear();
+    forEachPointInBox(box, [&](const Point& point) { out.push_back(point.entity); });
+}
+
+void SpatialHash::queryChunk(int chunkX, int chunkZ, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (!chunkCounts.count(makeKey(chunkX, chunkZ))) return;
+
+    for (int x = 0; x < CELLS_PER_CHUNK; x++) {
+        for (int z = 0; z < CELLS_PER_CHUNK; z++) {
+            auto it = cells.find(makeKey(chunkX * CELLS_PER_CHUNK + x, chunkZ * CELLS_PER_CHUNK + z));
+            if (it == cells.end()) continue;
+            for (const Point& point : it->second) out.push_back(point.entity);
+        }
+    }
+}
+
+void SpatialHash::getOccupiedChunks(std::vector<std::pair<int, int>>& out) const {
+    out.clear();
+    for (const auto& [key, entities] : chunkCounts) {
+        out.push_back({ static_cast<int>(key >> 32), static_cast<int>(static_cast<uint32_t>(key)) });
+    }
+}
+
+// =============================
+// Coordinates
+// =============================
+int SpatialHash::cellCoord(float blockSpace) {
+    return static_cast<int>(std::floor(blockSpace / CELL_SIZE));
+}
+
+int SpatialHash::floorDiv(int value, int divisor) {
+    int result = value / divisor;
+    if (value < 0 && value % divisor != 0) result--;
+    return result;
+}
+
+long long SpatialHash::makeKey(int x, int z) {
+    return (static_cast<long long>(x) << 32) ^ static_cast<unsigned int>(z);
+}
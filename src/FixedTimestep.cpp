@@ -0,0 +1,25 @@
+#include "FixedTimestep.h"
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(int ticksPerSecond, int maxTicksPerFrame)
+    : tickSeconds(1.0f / std::max(ticksPerSecond, 1)),
+    maxTicksPerFrame(std::max(maxTicksPerFrame, 1))
+{
+}
+
+int FixedTimestep::advance(float frameSeconds) {
+    accumulator += std::max(frameSeconds, 0.0f);
+
+    int ticks = static_cast<int>(accumulator / tickSeconds);
+    if (ticks > maxTicksPerFrame) {
+        droppedSeconds += accumulator - maxTicksPerFrame * tickSeconds;
+        ticks = maxTicksPerFrame;
+        accumulator = maxTicksPerFrame * tickSeconds;
+    }
+
+    accumulator -= ticks * tickSeconds;
+    if (accumulator < 0.0f) accumulator = 0.0f;
+
+    tickCount += ticks;
+    return ticks;
+}
@@ -0,0 +1,295 @@
+#include "FluidSimulation.h"
+#include "ChunkManager.h"
+#include <algorithm>
+#include <map>
+
+namespace {
+    struct FluidRules {
+        BlockType type;
+        unsigned char spread;   // Highest flowing level: how far it runs on flat ground
+        bool infinite;          // A flowing block between two sources becomes one
+        BlockType hardensNextTo;  // Turns to stone when this touches it (AIR = never)
+    };
+
+    constexpr FluidRules FLUIDS[] = {
+        { BlockType::WATER, FLUID_MAX_LEVEL, true,  BlockType::AIR },
+        { BlockType::LAVA,  3,               false, BlockType::WATER },
+    };
+
+    const FluidRules* fluidRules(BlockType type) {
+        for (const FluidRules& rules : FLUIDS) {
+            if (rules.type == type) return &rules;
+        }
+        return nullptr;
+    }
+
+    const int HORIZONTAL[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+    bool isFalling(const Block& block) {
+        return (block.fluidLevel & FLUID_FALLING) != 0;
+    }
+
+    // How far a fluid block is from its source for spreading purposes;
+    // falling fluid spreads like a source where it lands
+    int flowDistance(const Block& block) {
+        return isFalling(block) ? 0 : block.fluidLevel;
+    }
+
+    // Fluid can move in: empty, a plant, or flowing fluid of its own kind
+    bool isOpenTo(const Block& block, BlockType fluid) {
+        if (getBlockProperties(block.type).replaceable) return true;
+        return block.type == fluid && block.fluidLevel != FLUID_SOURCE;
+    }
+
+}
+
+FluidSimulation::FluidSimulation(unsigned int threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+
+    for (unsigned int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&FluidSimulation::workerLoop, this);
+    }
+}
+
+FluidSimulation::~FluidSimulation() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        shouldStop = true;
+    }
+    workReady.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// =============================
+// Tick
+// =============================
+void FluidSimulation::update(ChunkManager& chunkManager) {
+    chunkManager.getBlockTicks().advance(due);
+
+    lastTickCount = 0;
+    lastChangeCount = 0;
+    if (due.empty()) return;
+
+    // Chunks are looked up here: ChunkManager is main thread only
+    dueChunks.resize(due.size());
+    for (size_t i = 0; i < due.size(); i++) {
+        dueChunks[i] = chunkManager.getChunk(due[i].chunkX, due[i].chunkZ);
+        if (dueChunks[i]) lastTickCount += due[i].ticks.size();
+    }
+
+    buildJobs();
+    runJobs();
+
+    merged.clear();
+    for (size_t i = 0; i < jobCount; i++) {
+        merged.insert(merged.end(), jobs[i].changes.begin(), jobs[i].changes.end());
+    }
+
+    // One change per block: the strongest proposal
+    std::sort(merged.begin(), merged.end(), [](const BlockChange& a, const BlockChange& b) {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        if (a.z != b.z) return a.z < b.z;
+        return strongerChange(a, b);
+        });
+    merged.erase(std::unique(merged.begin(), merged.end(), [](const BlockChange& a, const BlockChange& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+        }), merged.end());
+
+    for (const BlockChange& change : merged) {
+        std::optional<Block> current = chunkManager.getBlockAt(change.x, change.y, change.z);
+        if (!current || (current->type == change.type && current->fluidLevel == change.fluidLevel)) continue;
+
+        if (chunkManager.setBlockAt(change.x, change.y, change.z, change.type, change.fluidLevel)) {
+            chunkManager.queueMeshRebuildAt(change.x, change.z);
+            lastChangeCount++;
+        }
+    }
+
+    totalTicks += lastTickCount;
+    totalChanges += lastChangeCount;
+}
+
+// Due chunks (sorted by chunk already) grouped by region, regions in
+// key order
+void FluidSimulation::buildJobs() {
+    std::map<std::pair<int, int>, size_t> regionJobs;
+    jobCount = 0;
+
+    for (size_t i = 0; i < due.size(); i++) {
+        if (!dueChunks[i]) continue;
+
+        // Floor division, so regions don't straddle zero
+        int regionX = due[i].chunkX >= 0 ? due[i].chunkX / REGION_SIZE : (due[i].chunkX - REGION_SIZE + 1) / REGION_SIZE;
+        int regionZ = due[i].chunkZ >= 0 ? due[i].chunkZ / REGION_SIZE : (due[i].chunkZ - REGION_SIZE + 1) / REGION_SIZE;
+
+        auto [it, inserted] = regionJobs.try_emplace({ regionX, regionZ }, 0);
+        if (inserted) {
+            if (jobs.size() <= jobCount) jobs.emplace_back();
+            jobs[jobCount].chunks.clear();
+            jobs[jobCount].changes.clear();
+            it->second = jobCount++;
+        }
+        jobs[it->second].chunks.push_back(i);
+    }
+}
+
+void FluidSimulation::simulateRegion(RegionJob& job) {
+    for (size_t index : job.chunks) {
+        for (const BlockTick& tick : due[index].ticks) {
+            tickBlock(*dueChunks[index], tick, job.changes);
+        }
+    }
+}
+
+// =============================
+// Worker pool
+// =============================
+void FluidSimulation::runJobs() {
+    nextJob.store(0);
+    if (workers.empty() || jobCount < 2) {
+        runQueuedJobs();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        busyWorkers = static_cast<unsigned int>(workers.size());
+        jobBatch++;
+    }
+    workReady.notify_all();
+
+    runQueuedJobs();
+
+    std::unique_lock<std::mutex> lock(poolMutex);
+    workDone.wait(lock, [&] { return busyWorkers == 0; });
+}
+
+void FluidSimulation::runQueuedJobs() {
+    for (size_t i = nextJob.fetch_add(1); i < jobCount; i = nextJob.fetch_add(1)) {
+        simulateRegion(jobs[i]);
+    }
+}
+
+void FluidSimulation::workerLoop() {
+    uint64_t seenBatch = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            workReady.wait(lock, [&] { return shouldStop || jobBatch != seenBatch; });
+            if (shouldStop) return;
+            seenBatch = jobBatch;
+        }
+
+        runQueuedJobs();
+
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (--busyWorkers == 0) workDone.notify_one();
+    }
+}
+
+// =============================
+// Flow rules
+// =============================
+// Reads only; neighbors come through the chunk's neighbor links (unloaded
+// ones read as stone, so fluid stops at the edge of the loaded world).
+// A flowing block takes its level from what feeds it (fluid above, or
+// the nearest horizontal neighbor) and dries up when nothing does. Then
+// fluid falls if it can, and otherwise spreads one level weaker to the
+// four sides.
+void FluidSimulation::tickBlock(const Chunk& chunk, const BlockTick& tick, std::vector<BlockChange>& changes) {
+    const int x = tick.x, y = tick.y, z = tick.z;
+
+    const Block self = chunk.getBlockWorld(x, y, z);
+    const FluidRules* rules = fluidRules(self.type);
+    if (!rules) return;  // Replaced since it was scheduled
+
+    const Block above = chunk.getBlockWorld(x, y + 1, z);
+    const Block below = y > 0 ? chunk.getBlockWorld(x, y - 1, z) : Block(BlockType::STONE);
+
+    Block sides[4];
+    for (int i = 0; i < 4; i++) {
+        sides[i] = chunk.getBlockWorld(x + HORIZONTAL[i][0], y, z + HORIZONTAL[i][1]);
+    }
+
+    if (rules->hardensNextTo != BlockType::AIR) {
+        bool touching = above.type == rules->hardensNextTo;
+        for (const Block& side : sides) touching = touching || side.type == rules->hardensNextTo;
+        if (touching) {
+            changes.push_back({ x, y, z, BlockType::STONE, FLUID_SOURCE });
+            return;
+        }
+    }
+
+    unsigned char level = self.fluidLevel;
+    if (level != FLUID_SOURCE) {
+        unsigned char fed;
+        if (above.type == self.type) {
+            fed = FLUID_FALLING;
+        }
+        else {
+            int nearest = FLUID_MAX_LEVEL + 1;
+            int sources = 0;
+            for (const Block& side : sides) {
+                if (side.type != self.type) continue;
+                if (side.fluidLevel == FLUID_SOURCE) sources++;
+                nearest = std::min(nearest, flowDistance(side));
+            }
+
+            bool grounded = below.isSolid() || (below.type == self.type && below.fluidLevel == FLUID_SOURCE);
+            if (rules->infinite && sources >= 2 && grounded) fed = FLUID_SOURCE;
+            else if (nearest < rules->spread) fed = static_cast<unsigned char>(nearest + 1);
+            else {
+                changes.push_back({ x, y, z, BlockType::AIR, FLUID_SOURCE });
+                return;
+            }
+        }
+
+        if (fed != level) {
+            changes.push_back({ x, y, z, self.type, fed });
+            level = fed;
+        }
+    }
+
+    if (y > 0 && isOpenTo(below, self.type)) {
+        if (below.type != self.type || below.fluidLevel != FLUID_FALLING) {
+            changes.push_back({ x, y - 1, z, self.type, FLUID_FALLING });
+        }
+        return;
+    }
+
+    int next = (level == FLUID_SOURCE || (level & FLUID_FALLING)) ? 1 : level + 1;
+    if (next > rules->spread) return;
+
+    for (int i = 0; i < 4; i++) {
+        const Block& side = sides[i];
+        bool weaker = side.type == self.type && side.fluidLevel != FLUID_SOURCE &&
+            !isFalling(side) && side.fluidLevel > next;
+        if (getBlockProperties(side.type).replaceable || weaker) {
+            changes.push_back({ x + HORIZONTAL[i][0], y, z + HORIZONTAL[i][1], self.type, static_cast<unsigned char>(next) });
+        }
+    }
+}
+
+// Order-independent choice between proposals for the same block. Solid
+// results win (lava hardening), then fluid over air; between fluids the
+// lower type, then sources, then falling, then the lower flowing level.
+bool FluidSimulation::strongerChange(const BlockChange& a, const BlockChange& b) {
+    auto category = [](const BlockChange& change) {
+        if (change.type == BlockType::AIR) return 2;
+        return fluidRules(change.type) ? 1 : 0;
+    };
+    auto fluidRank = [](const BlockChange& change) {
+        if (change.fluidLevel == FLUID_SOURCE) return 0;
+        if (change.fluidLevel & FLUID_FALLING) return 1;
+        return change.fluidLevel + 1;
+    };
+
+    if (category(a) != category(b)) return category(a) < category(b);
+    if (a.type != b.type) return a.type < b.type;
+    return fluidRank(a) < fluidRank(b);
+}
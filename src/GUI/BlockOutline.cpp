@@ -1,6 +1,7 @@
 #include "GUI/BlockOutline.h"
 #include "Player/Camera.h"
 #include "ChunkManager.h"
+#include "BlockRaycast.h"
 #include "Block.h"
 #include <iostream>
 #include <cmath>
@@ -33,9 +34,7 @@ void main()
 )";
 
 BlockOutline::BlockOutline()
-    : VAO(0), VBO(0), shaderProgram(0),
-    selectedBlockX(0), selectedBlockY(0), selectedBlockZ(0),
-    hitFace(-1), hasSelection(false) {
+    : VAO(0), VBO(0), shaderProgram(0) {
 }
 
 BlockOutline::~BlockOutline() {
@@ -108,61 +107,23 @@ unsigned int BlockOutline::createShader() {
     return program;
 }
 
-bool BlockOutline::raycastBlock(Camera& camera, ChunkManager* chunkManager) {
-    if (!chunkManager) return false;
-
-    hasSelection = false;
-    hitFace = -1;
-
-    const float maxDistance = 5.0f;
-    const float step = 0.05f;
-
-    // Apply offset to detection point
-    float rayX = camera.x + 0.0f;  // Offset X
-    float rayY = camera.y + 0.5f;  // Offset Y
-    float rayZ = camera.z + 0.0f;  // Offset Z
-
-    float dirX = camera.frontX;
-    float dirY = camera.frontY;
-    float dirZ = camera.frontZ;
-
-    for (float distance = 0.0f; distance < maxDistance; distance += step) {
-        rayX += dirX * step;
-        rayY += dirY * step;
-        rayZ += dirZ * step;
-
-        // Convert to block coordinates
-        int blockX = static_cast<int>(std::round(rayX));
-        int blockY = static_cast<int>(std::floor(rayY));
-        int blockZ = static_cast<int>(std::round(-rayZ));
-
-        Block* block = chunkManager->getBlockAt(blockX, blockY, blockZ);
-        if (block && !block->isAir()) {
-            selectedBlockX = blockX;
-            selectedBlockY = blockY;
-            selectedBlockZ = blockZ;
-            hasSelection = true;
-            delete block;
-            return true;
-        }
-        if (block) delete block;
-    }
-
-    return false;
-}
-
 void BlockOutline::render(
     Camera& camera,
     ChunkManager* chunkManager,
+    const BlockRaycastHit* target,
     float* viewMatrix,
     float* projectionMatrix
 ) {
     // CRITICAL FIX: Check for selection FIRST, before changing GL state
-    if (!raycastBlock(camera, chunkManager)) {
+    if (!target || !chunkManager) {
         // No block selected - don't change any GL state!
         return;
     }
 
+    const int selectedBlockX = target->blockX;
+    const int selectedBlockY = target->blockY;
+    const int selectedBlockZ = target->blockZ;
+
     // Save current GL state
     GLboolean depthMaskBefore;
     glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMaskBefore);
@@ -200,14 +161,12 @@ void BlockOutline::render(
         };
 
     auto isExposed = [&](int dx, int dy, int dz) {
-        Block* b = chunkManager->getBlockAt(
+        std::optional<Block> b = chunkManager->getBlockAt(
             selectedBlockX + dx,
             selectedBlockY + dy,
             selectedBlockZ + dz
         );
-        bool exposed = (!b || b->isAir());
-        if (b) delete b;
-        return exposed;
+        return !b || b->isTransparent();  // Seen through air, fluids, glass and plants
         };
 
     auto facingCamera = [&](float nx, float ny, float nz) {
@@ -7,6 +7,7 @@
 #include <iomanip>
 #include "ChunkManager.h" 
 #include "Block.h"
+#include "BlockRaycast.h"
 
 DebugOverlay::DebugOverlay()
     : enabled(true), VAO(0), VBO(0), shaderProgram(0),
@@ -213,7 +214,8 @@ std::string DebugOverlay::formatTimeOfDay(float timeOfDay) {
 void DebugOverlay::render(int windowWidth, int windowHeight,
     float posX, float posY, float posZ,
     float yaw, float fps, float timeOfDay,
-    ChunkManager* chunkManager) {
+    ChunkManager* chunkManager,
+    const BlockRaycastHit* target) {
     if (!enabled) return;
 
     glDisable(GL_DEPTH_TEST);
@@ -236,7 +238,7 @@ void DebugOverlay::render(int windowWidth, int windowHeight,
         int blockY = static_cast<int>(std::floor(posY));  // Keep floor for Y
         int blockZ = static_cast<int>(std::round(-posZ));
 
-        Block* block = chunkManager->getBlockAt(blockX, blockY, blockZ);
+        std::optional<Block> block = chunkManager->getBlockAt(blockX, blockY, blockZ);
         if (block) {
             // ===== FIXED: Apply GPU scaling to match what player actually sees! =====
             int storedMaxLight = block->skyLight;  // Max light in mesh (0-15)
@@ -247,8 +249,6 @@ void DebugOverlay::render(int windowWidth, int windowHeight,
 
             lightText += std::to_string(actualDisplayedLight);
             lightText += " (max: " + std::to_string(storedMaxLight) + ")";
-
-            delete block;
         }
         else {
             lightText += "N/A";
@@ -258,6 +258,77 @@ void DebugOverlay::render(int windowWidth, int windowHeight,
         lightText += "N/A";
     }
 
+    std::string targetText = "Looking At: ";
+    std::optional<Block> targetBlock;
+    if (chunkManager && target) {
+        targetBlock = chunkManager->getBlockAt(target->blockX, target->blockY, target->blockZ);
+    }
+    if (targetBlock) {
+        targetText += std::string(getBlockInfo(targetBlock->type).name) + " (" +
+            std::to_string(target->blockX) + ", " + std::to_string(target->blockY) + ", " +
+            std::to_string(target->blockZ) + ")";
+    }
+    else {
+        targetText += "N/A";
+    }
+
+    std::string cacheText = "Chunk Cache: ";
+    if (chunkManager) {
+        const ChunkCache::Stats& stats = chunkManager->getChunkCacheStats();
+        cacheText += std::to_string(stats.entryCount) + " chunks, " +
+            std::to_string(stats.bytesUsed / 1024) + " KB, " +
+            std::to_string(static_cast<int>(stats.hitRate() * 100.0f)) + "% hits";
+    }
+    else {
+        cacheText += "N/A";
+    }
+
+    std::string generationText = "Generation: ";
+    if (chunkManager) {
+        const GenerationStats& stats = chunkManager->getGenerationStats();
+        generationText += std::to_string(stats.completed) + "/" + std::to_string(stats.requested) +
+            " done, " + std::to_string(stats.cancelled) + " cancelled, " +
+            std::to_string(stats.wasted) + " wasted";
+    }
+    else {
+        generationText += "N/A";
+    }
+
+    std::string viewText = "View Fill: ";
+    if (chunkManager) {
+        const ViewCompletionStats& stats = chunkManager->getViewCompletionStats();
+        viewText += std::to_string(stats.missingVisible) + " missing, last " +
+            std::to_string(static_cast<int>(stats.lastMs)) + " ms, avg " +
+            std::to_string(static_cast<int>(stats.averageMs())) + " ms";
+    }
+    else {
+        viewText += "N/A";
+    }
+
+    std::string integrationText = "Integration: ";
+    if (chunkManager) {
+        const IntegrationProfile& profile = chunkManager->getIntegrationProfile();
+        std::ostringstream budget;
+        budget << std::fixed << std::setprecision(1) << profile.getBudgetMs() << " ms budget, "
+            << profile.estimatedChunkMs() << " ms/chunk";
+        integrationText += budget.str();
+    }
+    else {
+        integrationText += "N/A";
+    }
+
+    std::string meshText = "Meshing: ";
+    if (chunkManager) {
+        const MeshStats& stats = chunkManager->getMeshStats();
+        std::ostringstream builds;
+        builds << std::fixed << std::setprecision(2) << stats.buildsPerLoad() << " builds/load, "
+            << stats.rebuilds << " rebuilds";
+        meshText += builds.str();
+    }
+    else {
+        meshText += "N/A";
+    }
+
     // Render all debug info
     renderText(posText, 10, 50, 1.2f, windowWidth, windowHeight);
     renderText(dirText, 10, 80, 1.2f, windowWidth, windowHeight);
@@ -265,6 +336,12 @@ void DebugOverlay::render(int windowWidth, int windowHeight,
     renderText(yawText, 10, 140, 1.2f, windowWidth, windowHeight);
     renderText(fpsText, 10, 170, 1.2f, windowWidth, windowHeight);
     renderText(lightText, 10, 200, 1.2f, windowWidth, windowHeight);
+    renderText(targetText, 10, 230, 1.2f, windowWidth, windowHeight);
+    renderText(cacheText, 10, 260, 1.2f, windowWidth, windowHeight);
+    renderText(generationText, 10, 290, 1.2f, windowWidth, windowHeight);
+    renderText(viewText, 10, 320, 1.2f, windowWidth, windowHeight);
+    renderText(integrationText, 10, 350, 1.2f, windowWidth, windowHeight);
+    renderText(meshText, 10, 380, 1.2f, windowWidth, windowHeight);
 
     glDisable(GL_BLEND);
     glEnable(GL_DEPTH_TEST);
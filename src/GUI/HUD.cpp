@@ -15,8 +15,8 @@ HUD::HUD()
     hotbarSlots[5] = BlockType::BLOCKOFPUREREDLIGHT;      // Slot 6 
     hotbarSlots[6] = BlockType::BLOCKOFPUREGREENLIGHT;    // Slot 7 
     hotbarSlots[7] = BlockType::BLOCKOFPUREBLUELIGHT;     // Slot 8 
-    hotbarSlots[8] = BlockType::AIR;    // Slot 9 (empty)
-    hotbarSlots[9] = BlockType::AIR;    // Slot 10 (empty)
+    hotbarSlots[8] = BlockType::GLASS;  // Slot 9
+    hotbarSlots[9] = BlockType::WATER;  // Slot 10
 }
 
 HUD::~HUD() {
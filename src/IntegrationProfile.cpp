@@ -0,0 +1,99 @@
+#include "IntegrationProfile.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+const float IntegrationProfile::bucketLimitsMs[BUCKET_COUNT - 1] = {
+    0.1f, 0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 16.0f
+};
+
+static const char* stageNames[IntegrationProfile::STAGE_COUNT + 1] = {
+    "linking", "border_light", "meshing", "total"
+};
+
+int IntegrationProfile::bucketFor(float ms) {
+    for (int i = 0; i < BUCKET_COUNT - 1; i++) {
+        if (ms < bucketLimitsMs[i]) return i;
+    }
+    return BUCKET_COUNT - 1;
+}
+
+// =============================
+// Frame budget
+// =============================
+float IntegrationProfile::beginFrame(float frameMs) {
+    // Time the rest of the frame took, excluding last frame's integration
+    float otherMs = std::max(0.0f, frameMs - lastFrameIntegrationMs);
+    float headroom = TARGET_FRAME_MS - otherMs;
+    float target = std::clamp(headroom * 0.75f, MIN_BUDGET_MS, MAX_BUDGET_MS);
+
+    // Smooth so one slow frame doesn't starve integration
+    budgetMs += (target - budgetMs) * 0.2f;
+
+    for (int i = 0; i < STAGE_COUNT; i++) frameStageMs[i] = 0.0f;
+    frameChunks = 0;
+    return budgetMs;
+}
+
+void IntegrationProfile::addStageTime(IntegrationStage stage, float ms) {
+    int index = static_cast<int>(stage);
+    frameStageMs[index] += ms;
+    chunkStageMs[index] += ms;
+}
+
+void IntegrationProfile::chunkIntegrated() {
+    float chunkMs = 0.0f;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        averageStageMs[i] += (chunkStageMs[i] - averageStageMs[i]) * 0.1f;
+        chunkMs += chunkStageMs[i];
+        chunkStageMs[i] = 0.0f;
+    }
+    averageChunkMs += (chunkMs - averageChunkMs) * 0.1f;
+
+    frameChunks++;
+    chunksIntegrated++;
+}
+
+void IntegrationProfile::endFrame() {
+    float totalMs = 0.0f;
+    for (int i = 0; i < STAGE_COUNT; i++) totalMs += frameStageMs[i];
+    lastFrameIntegrationMs = totalMs;
+
+    if (frameChunks == 0) {
+        idleFrames++;
+        return;
+    }
+
+    busyFrames++;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        histogram[i][bucketFor(frameStageMs[i])]++;
+    }
+    histogram[STAGE_COUNT][bucketFor(totalMs)]++;
+}
+
+// =============================
+// Export
+// =============================
+bool IntegrationProfile::exportCSV(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write integration profile to: " << path << std::endl;
+        return false;
+    }
+
+    file << "stage";
+    for (int b = 0; b < BUCKET_COUNT - 1; b++) file << ",<" << bucketLimitsMs[b] << "ms";
+    file << ",>=" << bucketLimitsMs[BUCKET_COUNT - 2] << "ms,avg_ms_per_chunk\n";
+
+    for (int row = 0; row <= STAGE_COUNT; row++) {
+        file << stageNames[row];
+        for (int b = 0; b < BUCKET_COUNT; b++) file << "," << histogram[row][b];
+        file << "," << (row < STAGE_COUNT ? averageStageMs[row] : averageChunkMs) << "\n";
+    }
+
+    file << "# busy_frames=" << busyFrames << " idle_frames=" << idleFrames
+        << " chunks=" << chunksIntegrated << "\n";
+
+    std::cout << "Integration profile written to: " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,383 @@
+#include "LightEngine.h"
+
+namespace {
+    // Index 3 is straight down (sunlight keeps its level going down)
+    const int DIR_X[6] = { 1, -1, 0, 0, 0, 0 };
+    const int DIR_Y[6] = { 0, 0, 1, -1, 0, 0 };
+    const int DIR_Z[6] = { 0, 0, 0, 0, 1, -1 };
+    const int DOWN = 3;
+
+    constexpr unsigned char MAX_SKY_LIGHT = 15;
+
+    inline int floorDiv(int value, int size) {
+        int result = value / size;
+        if (value < 0 && value % size != 0) result--;
+        return result;
+    }
+
+    // World voxel + light level packed into 64 bits:
+    // x (26 bits, signed) | z (26 bits, signed) | y (8 bits) | level (4 bits)
+    constexpr uint64_t COORD_MASK = 0x3FFFFFF;
+    constexpr int COORD_SIGN = 0x2000000;
+
+    inline uint64_t packNode(int x, int y, int z, unsigned char level) {
+        return ((static_cast<uint64_t>(x) & COORD_MASK) << 38) |
+            ((static_cast<uint64_t>(z) & COORD_MASK) << 12) |
+            (static_cast<uint64_t>(y) << 4) |
+            level;
+    }
+
+    inline void unpackNode(uint64_t packed, int& x, int& y, int& z, unsigned char& level) {
+        x = (static_cast<int>((packed >> 38) & COORD_MASK) ^ COORD_SIGN) - COORD_SIGN;
+        z = (static_cast<int>((packed >> 12) & COORD_MASK) ^ COORD_SIGN) - COORD_SIGN;
+        y = static_cast<int>((packed >> 4) & 0xFF);
+        level = static_cast<unsigned char>(packed & 0xF);
+    }
+}
+
+LightEngine::LightEngine(ChunkLookup lookup)
+    : lookup(std::move(lookup)) {
+}
+
+Block* LightEngine::blockAt(int worldX, int worldY, int worldZ) {
+    if (worldY < 0 || worldY >= CHUNK_SIZE_Y) return nullptr;
+
+    int chunkX = floorDiv(worldX, CHUNK_SIZE_X);
+    int chunkZ = floorDiv(worldZ, CHUNK_SIZE_Z);
+
+    if (!cachedChunk || chunkX != cachedChunkX || chunkZ != cachedChunkZ) {
+        Chunk* chunk = lookup(chunkX, chunkZ);
+        if (!chunk) return nullptr;
+        cachedChunk = chunk;
+        cachedChunkX = chunkX;
+        cachedChunkZ = chunkZ;
+    }
+
+    return &cachedChunk->blocks[worldX - chunkX * CHUNK_SIZE_X][worldY][worldZ - chunkZ * CHUNK_SIZE_Z];
+}
+
+// Faces on a chunk border sample light from the voxels across it (corner
+// vertices reach into the diagonal chunk), so a change there also dirties
+// the neighboring chunks' meshes
+void LightEngine::markDirty(int worldX, int worldZ, Chunk* chunk, std::unordered_set<Chunk*>& dirtyChunks) {
+    dirtyChunks.insert(chunk);
+
+    int localX = worldX - chunk->chunkX * CHUNK_SIZE_X;
+    int localZ = worldZ - chunk->chunkZ * CHUNK_SIZE_Z;
+
+    int dx = localX == 0 ? -1 : (localX == CHUNK_SIZE_X - 1 ? 1 : 0);
+    int dz = localZ == 0 ? -1 : (localZ == CHUNK_SIZE_Z - 1 ? 1 : 0);
+
+    if (dx != 0) if (Chunk* n = lookup(chunk->chunkX + dx, chunk->chunkZ)) dirtyChunks.insert(n);
+    if (dz != 0) if (Chunk* n = lookup(chunk->chunkX, chunk->chunkZ + dz)) dirtyChunks.insert(n);
+    if (dx != 0 && dz != 0) if (Chunk* n = lookup(chunk->chunkX + dx, chunk->chunkZ + dz)) dirtyChunks.insert(n);
+}
+
+// =============================
+// Block edit entry point
+// =============================
+void LightEngine::updateSkyLightAt(int worldX, int worldY, int worldZ, const Block& oldBlock,
+    std::unordered_set<Chunk*>& dirtyChunks) {
+    cachedChunk = nullptr;
+    removalQueue.clear();
+    additionQueue.clear();
+
+    Block* block = blockAt(worldX, worldY, worldZ);
+    if (!block) return;
+
+    bool wasTransparent = oldBlock.isTransparent();
+    bool isTransparent = block->isTransparent();
+    if (wasTransparent == isTransparent) {
+        // setBlock resets light; an edit that doesn't change opacity keeps the old value
+        block->skyLight = oldBlock.skyLight;
+        return;
+    }
+
+    markDirty(worldX, worldZ, cachedChunk, dirtyChunks);
+
+    if (!isTransparent) {
+        // Opaque block placed: darken everything that depended on this voxel
+        block->skyLight = 0;
+        if (oldBlock.skyLight > 0) {
+            removalQueue.push(packNode(worldX, worldY, worldZ, oldBlock.skyLight));
+            runRemoval(dirtyChunks);
+        }
+    }
+    else {
+        // Block removed: light flows in from the neighbors (or the sky)
+        block->skyLight = 0;
+        if (worldY == CHUNK_SIZE_Y - 1) {
+            block->skyLight = MAX_SKY_LIGHT;
+            additionQueue.push(packNode(worldX, worldY, worldZ, MAX_SKY_LIGHT));
+        }
+
+        for (int i = 0; i < 6; i++) {
+            int nx = worldX + DIR_X[i];
+            int ny = worldY + DIR_Y[i];
+            int nz = worldZ + DIR_Z[i];
+
+            Block* neighbor = blockAt(nx, ny, nz);
+            if (neighbor && neighbor->isTransparent() && neighbor->skyLight > 0) {
+                additionQueue.push(packNode(nx, ny, nz, neighbor->skyLight));
+            }
+        }
+    }
+
+    runAddition(dirtyChunks);
+}
+
+// =============================
+// Chunk border reconciliation
+// =============================
+// Every lit voxel on either side of a shared face that could brighten the
+// voxel across it seeds the addition BFS, which then runs through all
+// loaded chunks. Light only ever increases here, so the converged result
+// is the same whichever order chunks were loaded in.
+void LightEngine::propagateChunkBorders(Chunk* chunk, std::unordered_set<Chunk*>& dirtyChunks) {
+    static const int dx[4] = { 0, 0, 1, -1 };
+    static const int dz[4] = { 1, -1, 0, 0 };
+
+    cachedChunk = nullptr;
+    additionQueue.clear();
+    blockAdditionQueue.clear();
+
+    int baseX = chunk->chunkX * CHUNK_SIZE_X;
+    int baseZ = chunk->chunkZ * CHUNK_SIZE_Z;
+
+    for (int side = 0; side < 4; side++) {
+        if (!lookup(chunk->chunkX + dx[side], chunk->chunkZ + dz[side])) continue;
+
+        for (int i = 0; i < CHUNK_SIZE_X; i++) {
+            // Edge voxel inside this chunk, and the voxel across the face
+            int insideX, insideZ;
+            if (dx[side] != 0) {
+                insideX = baseX + (dx[side] > 0 ? CHUNK_SIZE_X - 1 : 0);
+                insideZ = baseZ + i;
+            }
+            else {
+                insideX = baseX + i;
+                insideZ = baseZ + (dz[side] > 0 ? CHUNK_SIZE_Z - 1 : 0);
+            }
+            int outsideX = insideX + dx[side];
+            int outsideZ = insideZ + dz[side];
+
+            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+                Block* inside = blockAt(insideX, y, insideZ);
+                Block* outside = blockAt(outsideX, y, outsideZ);
+
+                if (inside->isTransparent() && outside->isTransparent()) {
+                    if (inside->skyLight > outside->skyLight + 1) {
+                        additionQueue.push(packNode(insideX, y, insideZ, inside->skyLight));
+                    }
+                    else if (outside->skyLight > inside->skyLight + 1) {
+                        additionQueue.push(packNode(outsideX, y, outsideZ, outside->skyLight));
+                    }
+                }
+
+                // Block light also leaves emitters, which are solid
+                if (outside->isTransparent() && inside->blockLight != 0 &&
+                    maxBlockLight(outside->blockLight, decayBlockLight(inside->blockLight)) != outside->blockLight) {
+                    blockAdditionQueue.push(packNode(insideX, y, insideZ, 0));
+                }
+                if (inside->isTransparent() && outside->blockLight != 0 &&
+                    maxBlockLight(inside->blockLight, decayBlockLight(outside->blockLight)) != inside->blockLight) {
+                    blockAdditionQueue.push(packNode(outsideX, y, outsideZ, 0));
+                }
+            }
+        }
+    }
+
+    runAddition(dirtyChunks);
+    runBlockLightAddition(dirtyChunks);
+}
+
+// =============================
+// Block light edits
+// =============================
+void LightEngine::updateBlockLightAt(int worldX, int worldY, int worldZ, const Block& oldBlock,
+    std::unordered_set<Chunk*>& dirtyChunks) {
+    cachedChunk = nullptr;
+    removalQueue.clear();
+    blockAdditionQueue.clear();
+
+    Block* block = blockAt(worldX, worldY, worldZ);
+    if (!block) return;
+
+    if (block->type == oldBlock.type) {
+        // setBlock resets light; an edit to the same type keeps the old value
+        block->blockLight = oldBlock.blockLight;
+        return;
+    }
+
+    Chunk* editedChunk = cachedChunk;
+    block->blockLight = 0;
+
+    // Darken whatever the old voxel lit, one channel at a time
+    if (oldBlock.blockLight != 0) {
+        markDirty(worldX, worldZ, editedChunk, dirtyChunks);
+
+        for (int shift = 0; shift <= BLOCK_LIGHT_RED_SHIFT; shift += 4) {
+            unsigned char level = blockLightChannel(oldBlock.blockLight, shift);
+            if (level == 0) continue;
+
+            removalQueue.push(packNode(worldX, worldY, worldZ, level));
+            runBlockLightRemoval(shift, dirtyChunks);
+        }
+    }
+
+    unsigned short emission = getLightEmission(block->type);
+    if (emission != 0) {
+        block->blockLight = emission;
+        markDirty(worldX, worldZ, editedChunk, dirtyChunks);
+        blockAdditionQueue.push(packNode(worldX, worldY, worldZ, 0));
+    }
+
+    // Opening a voxel lets neighboring light back in
+    if (block->isTransparent()) {
+        for (int i = 0; i < 6; i++) {
+            int nx = worldX + DIR_X[i];
+            int ny = worldY + DIR_Y[i];
+            int nz = worldZ + DIR_Z[i];
+
+            Block* neighbor = blockAt(nx, ny, nz);
+            if (neighbor && neighbor->blockLight != 0) {
+                blockAdditionQueue.push(packNode(nx, ny, nz, 0));
+            }
+        }
+    }
+
+    runBlockLightAddition(dirtyChunks);
+}
+
+// Single channel; voxels lit independently of the removed light (and any
+// emitters met on the way) are queued to refill the darkened region
+void LightEngine::runBlockLightRemoval(int shift, std::unordered_set<Chunk*>& dirtyChunks) {
+    const unsigned short channelMask = static_cast<unsigned short>(0xF << shift);
+
+    while (!removalQueue.empty()) {
+        int x, y, z;
+        unsigned char nodeLevel;
+        unpackNode(removalQueue.pop(), x, y, z, nodeLevel);
+
+        for (int i = 0; i < 6; i++) {
+            int nx = x + DIR_X[i];
+            int ny = y + DIR_Y[i];
+            int nz = z + DIR_Z[i];
+
+            Block* neighbor = blockAt(nx, ny, nz);
+            if (!neighbor) continue;
+
+            unsigned char level = blockLightChannel(neighbor->blockLight, shift);
+            if (level == 0) continue;
+
+            if (neighbor->isTransparent() && level < nodeLevel) {
+                neighbor->blockLight &= static_cast<unsigned short>(~channelMask);
+                markDirty(nx, nz, cachedChunk, dirtyChunks);
+                removalQueue.push(packNode(nx, ny, nz, level));
+            }
+            else {
+                blockAdditionQueue.push(packNode(nx, ny, nz, 0));
+            }
+        }
+    }
+}
+
+// All three channels at once: a neighbor is updated (and re-queued) when
+// any of its channels is dimmer than this voxel's minus one
+void LightEngine::runBlockLightAddition(std::unordered_set<Chunk*>& dirtyChunks) {
+    while (!blockAdditionQueue.empty()) {
+        int x, y, z;
+        unsigned char unusedLevel;
+        unpackNode(blockAdditionQueue.pop(), x, y, z, unusedLevel);
+
+        Block* current = blockAt(x, y, z);
+        if (!current) continue;
+
+        unsigned short spread = decayBlockLight(current->blockLight);
+        if (spread == 0) continue;
+
+        for (int i = 0; i < 6; i++) {
+            int nx = x + DIR_X[i];
+            int ny = y + DIR_Y[i];
+            int nz = z + DIR_Z[i];
+
+            Block* neighbor = blockAt(nx, ny, nz);
+            if (!neighbor || !neighbor->isTransparent()) continue;
+
+            unsigned short merged = maxBlockLight(neighbor->blockLight, spread);
+            if (merged == neighbor->blockLight) continue;
+
+            neighbor->blockLight = merged;
+            markDirty(nx, nz, cachedChunk, dirtyChunks);
+            blockAdditionQueue.push(packNode(nx, ny, nz, 0));
+        }
+    }
+}
+
+// =============================
+// Removal BFS
+// =============================
+void LightEngine::runRemoval(std::unordered_set<Chunk*>& dirtyChunks) {
+    while (!removalQueue.empty()) {
+        int x, y, z;
+        unsigned char nodeLevel;
+        unpackNode(removalQueue.pop(), x, y, z, nodeLevel);
+
+        for (int i = 0; i < 6; i++) {
+            int nx = x + DIR_X[i];
+            int ny = y + DIR_Y[i];
+            int nz = z + DIR_Z[i];
+
+            Block* neighbor = blockAt(nx, ny, nz);
+            if (!neighbor || !neighbor->isTransparent() || neighbor->skyLight == 0) continue;
+
+            unsigned char level = neighbor->skyLight;
+            bool fedByNode = level < nodeLevel ||
+                (i == DOWN && nodeLevel == MAX_SKY_LIGHT && level == MAX_SKY_LIGHT);
+
+            if (fedByNode) {
+                neighbor->skyLight = 0;
+                markDirty(nx, nz, cachedChunk, dirtyChunks);
+                removalQueue.push(packNode(nx, ny, nz, level));
+            }
+            else {
+                // Lit independently: re-spread from here once removal is done
+                additionQueue.push(packNode(nx, ny, nz, level));
+            }
+        }
+    }
+}
+
+// =============================
+// Addition BFS
+// =============================
+// Runs to convergence: a voxel is queued again only when its light
+// strictly increases, so there is no visited set and no iteration cap.
+void LightEngine::runAddition(std::unordered_set<Chunk*>& dirtyChunks) {
+    while (!additionQueue.empty()) {
+        int x, y, z;
+        unsigned char unusedLevel;
+        unpackNode(additionQueue.pop(), x, y, z, unusedLevel);
+
+        // Re-sources queued during removal may have been darkened since
+        Block* current = blockAt(x, y, z);
+        if (!current || current->skyLight == 0) continue;
+        unsigned char level = current->skyLight;
+
+        for (int i = 0; i < 6; i++) {
+            int nx = x + DIR_X[i];
+            int ny = y + DIR_Y[i];
+            int nz = z + DIR_Z[i];
+
+            unsigned char spread = (i == DOWN && level == MAX_SKY_LIGHT) ? MAX_SKY_LIGHT : level - 1;
+            if (spread == 0) continue;
+
+            Block* neighbor = blockAt(nx, ny, nz);
+            if (!neighbor || !neighbor->isTransparent() || neighbor->skyLight >= spread) continue;
+
+            neighbor->skyLight = spread;
+            markDirty(nx, nz, cachedChunk, dirtyChunks);
+            additionQueue.push(packNode(nx, ny, nz, spread));
+        }
+    }
+}
@@ -1,38 +1,34 @@
 #include "Player/Player.h"
 #include "Player/Camera.h"
 #include "ChunkManager.h"
+#include "BoxCollision.h"
 #include <cmath>
 #include <algorithm>
-#include <iostream>
 
 Player::Player(float posX, float posY, float posZ)
     : x(posX), y(posY), z(posZ),
+    previousX(posX), previousY(posY), previousZ(posZ),
     velocityX(0.0f), velocityY(0.0f), velocityZ(0.0f),
     width(0.6f), height(1.8f), eyeHeight(1.0f),
-    walkSpeed(4.317f), sprintSpeed(5.612f), jumpStrength(10.0f),
+    walkSpeed(4.317f), sprintSpeed(5.612f), flySpeed(9.0f), jumpStrength(10.0f),
     isOnGround(false), gameMode(GameMode::SPECTATOR) {
 }
 
 void Player::setGameMode(GameMode mode) {
     gameMode = mode;
+    velocityX = velocityY = velocityZ = 0.0f;
     if (mode == GameMode::SPECTATOR) {
-        velocityX = velocityY = velocityZ = 0.0f;
         isOnGround = false;
     }
 }
 
 void Player::processInput(float deltaFront, float deltaRight, float deltaUp, bool jump, bool sprint, Camera& camera) {
     if (gameMode == GameMode::SPECTATOR) {
-        float speed = sprint ? camera.speed * 2.0f : camera.speed;
-
-        x += camera.frontX * deltaFront * speed;
-        y += camera.frontY * deltaFront * speed + deltaUp * speed;
-        z += camera.frontZ * deltaFront * speed;
-
-        x += camera.rightX * deltaRight * speed;
-        y += camera.rightY * deltaRight * speed;
-        z += camera.rightZ * deltaRight * speed;
+        float speed = sprint ? flySpeed * 2.0f : flySpeed;
 
+        velocityX = (camera.frontX * deltaFront + camera.rightX * deltaRight) * speed;
+        velocityY = (camera.frontY * deltaFront + camera.rightY * deltaRight + deltaUp) * speed;
+        velocityZ = (camera.frontZ * deltaFront + camera.rightZ * deltaRight) * speed;
     }
     else {
         float moveX = camera.frontX * deltaFront + camera.rightX * deltaRight;
@@ -55,17 +51,31 @@ void Player::processInput(float deltaFront, float deltaRight, float deltaUp, boo
     }
 }
 
-void Player::update(float deltaTime, ChunkManager* chunkManager, Camera& camera) {
+void Player::update(float tickSeconds, ChunkManager* chunkManager) {
+    previousX = x;
+    previousY = y;
+    previousZ = z;
+
     if (gameMode == GameMode::SURVIVAL) {
-        applyPhysics(deltaTime, chunkManager);
+        applyPhysics(tickSeconds, chunkManager);
     }
+    else {
+        // Spectators fly through blocks
+        x += velocityX * tickSeconds;
+        y += velocityY * tickSeconds;
+        z += velocityZ * tickSeconds;
+    }
+}
 
-    camera.x = x;
-    camera.y = y + eyeHeight;
-    camera.z = z;
+void Player::updateCamera(Camera& camera, float alpha) const {
+    camera.x = previousX + (x - previousX) * alpha;
+    camera.y = previousY + (y - previousY) * alpha + eyeHeight;
+    camera.z = previousZ + (z - previousZ) * alpha;
 }
 
 void Player::applyPhysics(float deltaTime, ChunkManager* chunkManager) {
+    if (!chunkManager) return;
+
     const float GRAVITY = -32.0f;
     const float MAX_FALL_SPEED = -78.4f;
     const float DRAG = 0.91f;
@@ -84,97 +94,24 @@ void Player::applyPhysics(float deltaTime, ChunkManager* chunkManager) {
     velocityX *= DRAG;
     velocityZ *= DRAG;
 
-    // Move each axis separately with collision detection
-    // X-axis movement
-    float moveX = velocityX * deltaTime;
-    if (moveX != 0.0f) {
-        if (!checkBlockCollision(x + moveX, y, z, chunkManager)) {
-            x += moveX;
-        }
-        else {
-            velocityX = 0.0f;
-        }
-    }
-
-    // Y-axis movement
-    float moveY = velocityY * deltaTime;
-    if (moveY != 0.0f) {
-        if (!checkBlockCollision(x, y + moveY, z, chunkManager)) {
-            y += moveY;
-            isOnGround = false;
-        }
-        else {
-            if (velocityY < 0.0f) {
-                isOnGround = true;
-            }
-            velocityY = 0.0f;
-        }
-    }
-
-    // Z-axis movement
-    float moveZ = velocityZ * deltaTime;
-    if (moveZ != 0.0f) {
-        if (!checkBlockCollision(x, y, z + moveZ, chunkManager)) {
-            z += moveZ;
-        }
-        else {
-            velocityZ = 0.0f;
-        }
-    }
-}
-
-bool Player::checkBlockCollision(float px, float py, float pz, ChunkManager* chunkManager) {
-    if (!chunkManager) return false;
-
+    // Swept collision: each axis stops exactly at contact, however far
+    // this frame's movement goes
     float halfWidth = width / 2.0f;
-
-    // Debug: Print player position once
-    static bool debugPrinted = false;
-    if (!debugPrinted && gameMode == GameMode::SURVIVAL) {
-        std::cout << "Player center at: (" << px << ", " << py << ", " << pz << ")" << std::endl;
-        std::cout << "Bounding box extends: " << halfWidth << " in each horizontal direction" << std::endl;
-        debugPrinted = true;
+    CollisionBox box = { x - halfWidth, y, z - halfWidth, x + halfWidth, y + height, z + halfWidth };
+    BoxSweepResult sweep = sweepBox(*chunkManager, box,
+        velocityX * deltaTime, velocityY * deltaTime, velocityZ * deltaTime);
+
+    x += sweep.moveX;
+    y += sweep.moveY;
+    z += sweep.moveZ;
+
+    if (sweep.blockedX) velocityX = 0.0f;
+    if (sweep.blockedZ) velocityZ = 0.0f;
+    if (sweep.blockedY) {
+        isOnGround = velocityY < 0.0f;
+        velocityY = 0.0f;
     }
-
-    // Check multiple heights
-    std::vector<float> checkHeights = { 0.01f, 0.5f, 1.0f, 1.5f, 1.79f };
-
-    for (float dy : checkHeights) {
-        // Check 8 points around the perimeter + center
-        std::vector<std::pair<float, float>> checkPoints = {
-            {-halfWidth, -halfWidth},
-            {halfWidth, -halfWidth},
-            {-halfWidth, halfWidth},
-            {halfWidth, halfWidth},
-            {0.0f, -halfWidth},
-            {0.0f, halfWidth},
-            {-halfWidth, 0.0f},
-            {halfWidth, 0.0f},
-            {0.0f, 0.0f}
-        };
-
-        for (auto [dx, dz] : checkPoints) {
-            float checkX = px + dx;
-            float checkY = py + dy;
-            float checkZ = pz + dz;
-
-            // FIXED: Blocks are rendered centered at integer coordinates
-            // A block at position (0, 0, 0) spans from (-0.5, -0.5, -0.5) to (0.5, 0.5, 0.5)
-            // So we need to round to nearest integer, not floor
-            int blockX = static_cast<int>(std::round(checkX));
-            int blockY = static_cast<int>(std::floor(checkY));  // Y uses floor (feet on ground)
-            int blockZ = static_cast<int>(std::round(-checkZ)); // Round, then negate for chunk system
-
-            Block* block = chunkManager->getBlockAt(blockX, blockY, blockZ);
-            if (block) {
-                bool isSolid = !block->isAir();
-                delete block;
-                if (isSolid) {
-                    return true;
-                }
-            }
-        }
+    else if (sweep.moveY != 0.0f) {
+        isOnGround = false;
     }
-
-    return false;
-}
\ No newline at end of file
+}
@@ -0,0 +1,167 @@
+#include "Rendering/ChunkMesh.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <numeric>
+
+ChunkMesh::~ChunkMesh() {
+    for (auto& pair : meshes) {
+        deleteMesh(pair.second);
+    }
+}
+
+void ChunkMesh::upload(const std::map<BlockType, ChunkMeshBuffers>& buffers) {
+    // Drop meshes for types that are no longer present
+    for (auto it = meshes.begin(); it != meshes.end();) {
+        if (buffers.count(it->first) == 0) {
+            deleteMesh(it->second);
+            it = meshes.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    translucentTypes = 0;
+    sorted = false;
+
+    for (auto& [type, buffer] : buffers) {
+        bool translucent = getBlockProperties(type).layer == RenderLayer::TRANSLUCENT;
+
+        TypeMesh& mesh = meshes[type];
+        mesh.indexCount = static_cast<unsigned int>(buffer.indices.size());
+        setupMesh(mesh, buffer, translucent);
+
+        mesh.triangles.clear();
+        mesh.centroids.clear();
+        if (!translucent) continue;
+
+        translucentTypes++;
+        mesh.triangles = buffer.indices;
+        mesh.centroids.reserve(buffer.indices.size());
+        for (size_t i = 0; i + 2 < buffer.indices.size(); i += 3) {
+            for (int axis = 0; axis < 3; axis++) {
+                float sum = 0.0f;
+                for (int corner = 0; corner < 3; corner++) {
+                    sum += buffer.vertices[buffer.indices[i + corner] * CHUNK_VERTEX_FLOATS + axis];
+                }
+                mesh.centroids.push_back(sum / 3.0f);
+            }
+        }
+    }
+}
+
+bool ChunkMesh::needsSort(float cameraX, float cameraY, float cameraZ, float threshold) const {
+    if (!hasTranslucent()) return false;
+    if (!sorted) return true;
+
+    float dx = cameraX - sortX;
+    float dy = cameraY - sortY;
+    float dz = cameraZ - sortZ;
+    return dx * dx + dy * dy + dz * dz > threshold * threshold;
+}
+
+void ChunkMesh::sortTranslucent(float cameraX, float cameraY, float cameraZ) {
+    static thread_local std::vector<float> distances;
+    static thread_local std::vector<unsigned int> order;
+    static thread_local std::vector<unsigned int> sortedIndices;
+
+    for (auto& [type, mesh] : meshes) {
+        if (mesh.triangles.empty()) continue;
+
+        size_t triangleCount = mesh.triangles.size() / 3;
+        distances.resize(triangleCount);
+        for (size_t i = 0; i < triangleCount; i++) {
+            float dx = mesh.centroids[i * 3] - cameraX;
+            float dy = mesh.centroids[i * 3 + 1] - cameraY;
+            float dz = mesh.centroids[i * 3 + 2] - cameraZ;
+            distances[i] = dx * dx + dy * dy + dz * dz;
+        }
+
+        // Farthest first
+        order.resize(triangleCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [](unsigned int a, unsigned int b) {
+            return distances[a] > distances[b];
+            });
+
+        sortedIndices.resize(mesh.triangles.size());
+        for (size_t i = 0; i < triangleCount; i++) {
+            const unsigned int* triangle = &mesh.triangles[order[i] * 3];
+            sortedIndices[i * 3] = triangle[0];
+            sortedIndices[i * 3 + 1] = triangle[1];
+            sortedIndices[i * 3 + 2] = triangle[2];
+        }
+
+        // Through the VAO, which owns the element buffer binding
+        glBindVertexArray(mesh.VAO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sortedIndices.size() * sizeof(unsigned int), sortedIndices.data());
+        glBindVertexArray(0);
+    }
+
+    sorted = true;
+    sortX = cameraX;
+    sortY = cameraY;
+    sortZ = cameraZ;
+}
+
+void ChunkMesh::setupMesh(TypeMesh& mesh, const ChunkMeshBuffers& buffers, bool dynamicIndices) {
+    if (mesh.VAO == 0) {
+        glGenVertexArrays(1, &mesh.VAO);
+        glGenBuffers(1, &mesh.VBO);
+        glGenBuffers(1, &mesh.EBO);
+    }
+
+    glBindVertexArray(mesh.VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, buffers.vertices.size() * sizeof(float), buffers.vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, buffers.indices.size() * sizeof(unsigned int), buffers.indices.data(),
+        dynamicIndices ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+
+    const GLsizei stride = CHUNK_VERTEX_FLOATS * sizeof(float);
+
+    // Position attribute
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Texture coordinate attribute
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // Normal attribute
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    // Sky light level attribute
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+
+    // Block light (RGB) attribute
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(9 * sizeof(float)));
+    glEnableVertexAttribArray(4);
+
+    // Ambient occlusion attribute
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, stride, (void*)(12 * sizeof(float)));
+    glEnableVertexAttribArray(5);
+
+    glBindVertexArray(0);
+}
+
+void ChunkMesh::deleteMesh(TypeMesh& mesh) {
+    if (mesh.VAO) glDeleteVertexArrays(1, &mesh.VAO);
+    if (mesh.VBO) glDeleteBuffers(1, &mesh.VBO);
+    if (mesh.EBO) glDeleteBuffers(1, &mesh.EBO);
+    mesh = TypeMesh();
+}
+
+void ChunkMesh::renderType(BlockType type) const {
+    auto it = meshes.find(type);
+    if (it == meshes.end() || it->second.indexCount == 0) return;
+
+    glBindVertexArray(it->second.VAO);
+    glDrawElements(GL_TRIANGLES, it->second.indexCount, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
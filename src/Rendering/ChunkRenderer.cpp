@@ -0,0 +1,69 @@
+#include "Rendering/ChunkRenderer.h"
+#include "BlockRegistry.h"
+#include <algorithm>
+
+long long ChunkRenderer::makeKey(int x, int z) const {
+    return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+}
+
+void ChunkRenderer::sync(ChunkManager& chunkManager) {
+    chunkManager.takeMeshUpdates(pendingUpdates);
+
+    for (ChunkMeshUpdate& update : pendingUpdates) {
+        long long key = makeKey(update.chunkX, update.chunkZ);
+
+        if (update.removed) {
+            meshes.erase(key);
+            continue;
+        }
+
+        std::unique_ptr<ChunkMesh>& mesh = meshes[key];
+        if (!mesh) mesh = std::make_unique<ChunkMesh>();
+        mesh->upload(update.buffers);
+    }
+    pendingUpdates.clear();
+}
+
+void ChunkRenderer::renderType(BlockType type) {
+    for (auto& [_, mesh] : meshes) {
+        mesh->renderType(type);
+    }
+}
+
+void ChunkRenderer::sortTranslucent(float cameraX, float cameraY, float cameraZ) {
+    translucentOrder.clear();
+    for (auto& [key, mesh] : meshes) {
+        if (!mesh->hasTranslucent()) continue;
+
+        int chunkX = static_cast<int>(key >> 32);
+        int chunkZ = static_cast<int>(static_cast<uint32_t>(key));
+        float dx = chunkX * CHUNK_SIZE_X + (CHUNK_SIZE_X - 1) * 0.5f - cameraX;
+        float dz = -(chunkZ * CHUNK_SIZE_Z + (CHUNK_SIZE_Z - 1) * 0.5f) - cameraZ;
+        translucentOrder.push_back({ dx * dx + dz * dz, mesh.get() });
+    }
+
+    std::sort(translucentOrder.begin(), translucentOrder.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Chunks past the budget keep their old order for a few more frames
+    int sorts = 0;
+    for (auto& [_, mesh] : translucentOrder) {
+        if (sorts == MAX_SORTS_PER_FRAME) break;
+        if (!mesh->needsSort(cameraX, cameraY, cameraZ, RESORT_DISTANCE)) continue;
+
+        mesh->sortTranslucent(cameraX, cameraY, cameraZ);
+        sorts++;
+    }
+}
+
+void ChunkRenderer::renderTranslucent() {
+    BlockRegistry& blockRegistry = BlockRegistry::getInstance();
+
+    for (auto it = translucentOrder.rbegin(); it != translucentOrder.rend(); ++it) {
+        for (int i = 0; i < BLOCK_TYPE_COUNT; i++) {
+            BlockType type = static_cast<BlockType>(i);
+            if (getBlockProperties(type).layer != RenderLayer::TRANSLUCENT) continue;
+            if (blockRegistry.bindTexture(type)) it->second->renderType(type);
+        }
+    }
+}
@@ -0,0 +1,266 @@
+// Stand-in client for load-testing minecraft_server on localhost.
+//
+// Usage: server_bot [--port N] [--bots N] [--render-distance N]
+//            [--speed BLOCKS_PER_S] [--duration S] [--edits-per-second N]
+//
+// Each bot connects, says Hello, then flies in a straight line (bots fan
+// out evenly) sending its position every tick. Every chunk received is
+// fully decoded and validated. Reports chunks received per second and
+// how long each bot waited for its first chunk.
+
+#include "Server/NetProtocol.h"
+#include "Server/Socket.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NetProtocol;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    struct BotOptions {
+        uint16_t port = DEFAULT_PORT;
+        int bots = 4;
+        int renderDistance = 8;
+        float speed = 20.0f;
+        float durationSeconds = 30.0f;
+        float editsPerSecond = 0.0f;  // Per bot
+    };
+
+    struct Bot {
+        Socket socket;
+        float x = 0.0f;
+        float z = 0.0f;
+        float directionX = 0.0f;
+        float directionZ = 0.0f;
+        bool welcomed = false;
+        bool disconnected = false;
+        float editCredit = 0.0f;
+
+        std::vector<uint8_t> inbox;
+        std::vector<uint8_t> outbox;
+
+        Clock::time_point connectedAt;
+        float firstChunkMs = -1.0f;
+        unsigned long long chunks = 0;
+        unsigned long long unloads = 0;
+        unsigned long long bytes = 0;
+        unsigned long long invalidChunks = 0;
+    };
+
+    bool parseArguments(int argc, char** argv, BotOptions& options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--port" && hasValue) options.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+            else if (arg == "--bots" && hasValue) options.bots = std::atoi(argv[++i]);
+            else if (arg == "--render-distance" && hasValue) options.renderDistance = std::atoi(argv[++i]);
+            else if (arg == "--speed" && hasValue) options.speed = static_cast<float>(std::atof(argv[++i]));
+            else if (arg == "--duration" && hasValue) options.durationSeconds = static_cast<float>(std::atof(argv[++i]));
+            else if (arg == "--edits-per-second" && hasValue) options.editsPerSecond = static_cast<float>(std::atof(argv[++i]));
+            else return false;
+        }
+        return options.bots >= 1 && options.renderDistance >= 2 && options.renderDistance <= 32;
+    }
+
+    void handleMessage(Bot& bot, const uint8_t* frame, size_t size, Chunk& scratch) {
+        Reader reader(frame, size);
+        MessageType type = static_cast<MessageType>(reader.u8());
+
+        switch (type) {
+        case MessageType::Welcome:
+            bot.welcomed = reader.u32() == VERSION && reader.ok();
+            if (!bot.welcomed) bot.disconnected = true;
+            break;
+        case MessageType::ChunkData: {
+            reader.i32();
+            reader.i32();
+            if (!readChunkRuns(reader, scratch)) {
+                bot.invalidChunks++;
+                break;
+            }
+            if (bot.chunks == 0) {
+                bot.firstChunkMs = std::chrono::duration<float, std::milli>(Clock::now() - bot.connectedAt).count();
+            }
+            bot.chunks++;
+            break;
+        }
+        case MessageType::ChunkUnload:
+            bot.unloads++;
+            break;
+        default:
+            bot.disconnected = true;
+            break;
+        }
+    }
+
+    void receive(Bot& bot, Chunk& scratch) {
+        uint8_t buffer[64 * 1024];
+        while (true) {
+            long long received = bot.socket.receive(buffer, sizeof(buffer));
+            if (received < 0) {
+                bot.disconnected = true;
+                return;
+            }
+            if (received == 0) break;
+            bot.inbox.insert(bot.inbox.end(), buffer, buffer + received);
+            bot.bytes += static_cast<unsigned long long>(received);
+        }
+
+        size_t consumed = 0;
+        while (!bot.disconnected) {
+            long long frameLength = completeFrameLength(bot.inbox.data() + consumed, bot.inbox.size() - consumed);
+            if (frameLength < 0) {
+                bot.disconnected = true;
+                break;
+            }
+            if (frameLength == 0) break;
+
+            handleMessage(bot, bot.inbox.data() + consumed + 4, static_cast<size_t>(frameLength - 4), scratch);
+            consumed += static_cast<size_t>(frameLength);
+        }
+        bot.inbox.erase(bot.inbox.begin(), bot.inbox.begin() + consumed);
+    }
+
+    // Bots only send a few small messages per tick, so a short blocking
+    // retry loop is enough
+    void flush(Bot& bot) {
+        size_t offset = 0;
+        while (offset < bot.outbox.size() && !bot.disconnected) {
+            long long written = bot.socket.send(bot.outbox.data() + offset, bot.outbox.size() - offset);
+            if (written < 0) bot.disconnected = true;
+            else if (written == 0) std::this_thread::yield();
+            else offset += static_cast<size_t>(written);
+        }
+        bot.outbox.clear();
+    }
+}
+
+int main(int argc, char** argv) {
+    BotOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: server_bot [--port N] [--bots N] [--render-distance N] [--speed BLOCKS_PER_S]\n"
+            "                  [--duration S] [--edits-per-second N]\n";
+        return 1;
+    }
+
+    if (!Socket::initializeNetworking()) {
+        std::cerr << "Failed to initialize networking\n";
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<Bot>> bots;
+    for (int i = 0; i < options.bots; i++) {
+        auto bot = std::make_unique<Bot>();
+        if (!bot->socket.connect("127.0.0.1", options.port)) {
+            std::cerr << "Bot " << i << " failed to connect to 127.0.0.1:" << options.port << "\n";
+            return 1;
+        }
+
+        float angle = 6.2831853f * i / options.bots;
+        bot->directionX = std::cos(angle);
+        bot->directionZ = std::sin(angle);
+        bot->connectedAt = Clock::now();
+
+        size_t start = beginMessage(bot->outbox, MessageType::Hello);
+        writeU32(bot->outbox, VERSION);
+        writeU8(bot->outbox, static_cast<uint8_t>(options.renderDistance));
+        endMessage(bot->outbox, start);
+        flush(*bot);
+
+        bots.push_back(std::move(bot));
+    }
+
+    Chunk scratch(0, 0);
+    std::mt19937 random(1234);
+    const float tickSeconds = 0.05f;
+    Clock::time_point started = Clock::now();
+    Clock::time_point lastReport = started;
+    unsigned long long reportedChunks = 0;
+
+    while (true) {
+        Clock::time_point now = Clock::now();
+        float elapsed = std::chrono::duration<float>(now - started).count();
+        if (elapsed >= options.durationSeconds) break;
+
+        for (auto& bot : bots) {
+            if (bot->disconnected) continue;
+
+            receive(*bot, scratch);
+            if (!bot->welcomed) continue;
+
+            bot->x += bot->directionX * options.speed * tickSeconds;
+            bot->z += bot->directionZ * options.speed * tickSeconds;
+
+            size_t start = beginMessage(bot->outbox, MessageType::Position);
+            writeF32(bot->outbox, bot->x);
+            writeF32(bot->outbox, bot->z);
+            endMessage(bot->outbox, start);
+
+            // Place or clear a block somewhere near the bot
+            bot->editCredit += options.editsPerSecond * tickSeconds;
+            while (bot->editCredit >= 1.0f) {
+                bot->editCredit -= 1.0f;
+                start = beginMessage(bot->outbox, MessageType::SetBlock);
+                writeI32(bot->outbox, static_cast<int32_t>(std::floor(bot->x)) + static_cast<int32_t>(random() % 17) - 8);
+                writeI32(bot->outbox, 60 + static_cast<int32_t>(random() % 80));
+                writeI32(bot->outbox, static_cast<int32_t>(std::floor(-bot->z)) + static_cast<int32_t>(random() % 17) - 8);
+                writeU8(bot->outbox, static_cast<uint8_t>(random() % 2 ? BlockType::STONE : BlockType::AIR));
+                endMessage(bot->outbox, start);
+            }
+            flush(*bot);
+        }
+
+        float sinceReport = std::chrono::duration<float>(now - lastReport).count();
+        if (sinceReport >= 5.0f) {
+            unsigned long long chunks = 0;
+            int connected = 0;
+            for (auto& bot : bots) {
+                chunks += bot->chunks;
+                if (!bot->disconnected) connected++;
+            }
+            std::cout << std::fixed << std::setprecision(1) << "[bots] " << connected << " connected, "
+                << (chunks - reportedChunks) / sinceReport << " chunks/s received\n";
+            reportedChunks = chunks;
+            lastReport = now;
+        }
+
+        std::this_thread::sleep_until(now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(tickSeconds)));
+    }
+
+    float totalSeconds = std::chrono::duration<float>(Clock::now() - started).count();
+    unsigned long long chunks = 0, bytes = 0, invalid = 0, unloads = 0;
+    float firstChunkTotal = 0.0f, firstChunkWorst = 0.0f;
+    int withChunks = 0, disconnected = 0;
+    for (auto& bot : bots) {
+        chunks += bot->chunks;
+        bytes += bot->bytes;
+        invalid += bot->invalidChunks;
+        unloads += bot->unloads;
+        if (bot->disconnected) disconnected++;
+        if (bot->firstChunkMs >= 0.0f) {
+            firstChunkTotal += bot->firstChunkMs;
+            firstChunkWorst = std::max(firstChunkWorst, bot->firstChunkMs);
+            withChunks++;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "Bot summary: " << options.bots << " bots, " << totalSeconds << " s, "
+        << chunks << " chunks (" << chunks / totalSeconds << " chunks/s, "
+        << bytes / totalSeconds / (1024.0f * 1024.0f) << " MB/s), "
+        << unloads << " unloads, " << invalid << " invalid, " << disconnected << " disconnected\n"
+        << "  first chunk after avg " << (withChunks ? firstChunkTotal / withChunks : 0.0f)
+        << " ms, worst " << firstChunkWorst << " ms\n";
+
+    return invalid == 0 && disconnected == 0 ? 0 : 1;
+}
@@ -0,0 +1,394 @@
+#include "Server/ChunkServer.h"
+#include "Server/NetProtocol.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace NetProtocol;
+
+namespace {
+    constexpr float SIMULATED_ORBIT_RADIUS = 400.0f;  // Blocks
+    constexpr int MIN_RENDER_DISTANCE = 2;
+    constexpr int MAX_RENDER_DISTANCE = 32;
+
+    float percentile(std::vector<float> values, float fraction) {
+        if (values.empty()) return 0.0f;
+        size_t index = static_cast<size_t>(fraction * (values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+// =============================
+// Utility
+// =============================
+long long ChunkServer::makeKey(int x, int z) const {
+    return (static_cast<long long>(x) << 32) ^ (static_cast<unsigned int>(z));
+}
+
+// Same mapping as ChunkManager::worldToChunkCoords (render space -Z is chunk +Z)
+int ChunkServer::playerChunkX(const ClientSession& client) const {
+    return static_cast<int>(std::floor(client.x / CHUNK_SIZE_X));
+}
+
+int ChunkServer::playerChunkZ(const ClientSession& client) const {
+    return static_cast<int>(std::floor(-client.z / CHUNK_SIZE_Z));
+}
+
+// =============================
+// Constructor / Destructor
+// =============================
+ChunkServer::ChunkServer(const ChunkServerConfig& config)
+    : config(config),
+    world(config.worldName, config.workerCount)
+{
+    for (int i = 0; i < config.simulatedPlayers; i++) {
+        auto player = std::make_unique<ClientSession>();
+        player->id = nextClientId++;
+        player->simulated = true;
+        player->greeted = true;
+        player->renderDistance = config.simulatedRenderDistance;
+        player->orbitAngle = 6.2831853f * i / config.simulatedPlayers;
+        player->x = std::cos(player->orbitAngle) * SIMULATED_ORBIT_RADIUS;
+        player->z = std::sin(player->orbitAngle) * SIMULATED_ORBIT_RADIUS;
+        clients.push_back(std::move(player));
+    }
+}
+
+ChunkServer::~ChunkServer() {
+    world.save();
+}
+
+bool ChunkServer::start() {
+    lastTick = std::chrono::steady_clock::now();
+    if (config.port == 0) return true;
+
+    if (!Socket::initializeNetworking() || !listener.listen(config.port)) {
+        std::cerr << "Failed to listen on 127.0.0.1:" << config.port << "\n";
+        return false;
+    }
+    std::cout << "Listening on 127.0.0.1:" << config.port << "\n";
+    return true;
+}
+
+// =============================
+// Main loop
+// =============================
+void ChunkServer::run(float durationSeconds, float reportSeconds) {
+    using Clock = std::chrono::steady_clock;
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / config.tickRate));
+    Clock::time_point started = Clock::now();
+    Clock::time_point nextTick = started;
+    Clock::time_point lastReport = started;
+
+    while (true) {
+        tick();
+
+        Clock::time_point now = Clock::now();
+        float elapsed = std::chrono::duration<float>(now - started).count();
+        float sinceReport = std::chrono::duration<float>(now - lastReport).count();
+        if (reportSeconds > 0.0f && sinceReport >= reportSeconds) {
+            report(sinceReport);
+            lastReport = now;
+        }
+        if (durationSeconds > 0.0f && elapsed >= durationSeconds) break;
+
+        // Fixed schedule; after an overrun, restart it instead of bursting
+        nextTick += interval;
+        if (nextTick < now) {
+            stats.overrunTicks++;
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    float totalSeconds = std::chrono::duration<float>(Clock::now() - started).count();
+    std::vector<float> allTicks = stats.tickMs;
+    float averageMs = 0.0f;
+    for (float ms : allTicks) averageMs += ms;
+    if (!allTicks.empty()) averageMs /= allTicks.size();
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "Server summary: " << totalSeconds << " s, " << stats.ticks << " ticks, "
+        << stats.chunksServed << " chunks served (" << stats.chunksServed / std::max(totalSeconds, 0.001f)
+        << " chunks/s, " << stats.bytesServed / (1024.0f * 1024.0f) << " MB), "
+        << stats.chunksResent << " resent\n"
+        << "  tick avg " << averageMs << " ms, p99 " << percentile(allTicks, 0.99f)
+        << " ms, max " << percentile(allTicks, 1.0f) << " ms, " << stats.overrunTicks << " overruns\n"
+        << "  world: " << world.getStats().generated << " generated, "
+        << world.getStats().restoredFromCache << " restored from cache, "
+        << world.getStats().unloaded << " unloaded, " << world.getStats().blockEdits << " block edits\n";
+}
+
+void ChunkServer::tick() {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start = Clock::now();
+    float dt = std::chrono::duration<float>(start - lastTick).count();
+    lastTick = start;
+
+    acceptClients();
+
+    for (auto& client : clients) {
+        if (client->simulated) moveSimulatedPlayer(*client, dt);
+        else readClient(*client);
+    }
+
+    clients.erase(std::remove_if(clients.begin(), clients.end(),
+        [](const std::unique_ptr<ClientSession>& client) {
+            if (client->disconnected) std::cout << "Client " << client->id << " disconnected\n";
+            return client->disconnected;
+        }), clients.end());
+
+    viewers.clear();
+    for (auto& client : clients) {
+        if (!client->greeted) continue;
+        viewers.push_back({ playerChunkX(*client), playerChunkZ(*client), client->renderDistance });
+    }
+
+    world.update(viewers, config.integrationBudgetMs);
+    world.takeChangedChunks(changedChunks);
+
+    for (auto& client : clients) {
+        if (!client->greeted) continue;
+        streamChunks(*client, changedChunks);
+        if (!client->simulated) flushClient(*client);
+    }
+
+    world.autoSaveCheck();
+
+    stats.ticks++;
+    stats.tickMs.push_back(std::chrono::duration<float, std::milli>(Clock::now() - start).count());
+    if (stats.tickMs.size() > MAX_TICK_HISTORY) {
+        size_t dropped = stats.tickMs.size() / 2;
+        stats.tickMs.erase(stats.tickMs.begin(), stats.tickMs.begin() + dropped);
+        reportedTicks = reportedTicks > dropped ? reportedTicks - dropped : 0;
+    }
+}
+
+// =============================
+// Connections
+// =============================
+void ChunkServer::acceptClients() {
+    if (!listener.isValid()) return;
+
+    while (true) {
+        Socket socket = listener.accept();
+        if (!socket.isValid()) return;
+
+        auto client = std::make_unique<ClientSession>();
+        client->id = nextClientId++;
+        client->socket = std::move(socket);
+        std::cout << "Client " << client->id << " connected\n";
+        clients.push_back(std::move(client));
+    }
+}
+
+void ChunkServer::readClient(ClientSession& client) {
+    uint8_t buffer[16 * 1024];
+    while (true) {
+        long long received = client.socket.receive(buffer, sizeof(buffer));
+        if (received < 0) {
+            client.disconnected = true;
+            return;
+        }
+        if (received == 0) break;
+        client.inbox.insert(client.inbox.end(), buffer, buffer + received);
+    }
+
+    size_t consumed = 0;
+    while (!client.disconnected) {
+        long long frameLength = completeFrameLength(client.inbox.data() + consumed, client.inbox.size() - consumed);
+        if (frameLength < 0) {
+            client.disconnected = true;
+            break;
+        }
+        if (frameLength == 0) break;
+
+        handleMessage(client, client.inbox.data() + consumed + 4, static_cast<size_t>(frameLength - 4));
+        consumed += static_cast<size_t>(frameLength);
+    }
+    client.inbox.erase(client.inbox.begin(), client.inbox.begin() + consumed);
+}
+
+void ChunkServer::handleMessage(ClientSession& client, const uint8_t* frame, size_t size) {
+    Reader reader(frame, size);
+    MessageType type = static_cast<MessageType>(reader.u8());
+
+    // Until Hello, the client hasn't shown it speaks this protocol version
+    if (!client.greeted && type != MessageType::Hello) {
+        client.disconnected = true;
+        return;
+    }
+
+    switch (type) {
+    case MessageType::Hello: {
+        uint32_t version = reader.u32();
+        int renderDistance = reader.u8();
+        if (!reader.ok() || version != VERSION) {
+            client.disconnected = true;
+            return;
+        }
+
+        client.renderDistance = std::max(MIN_RENDER_DISTANCE, std::min(renderDistance, MAX_RENDER_DISTANCE));
+        client.greeted = true;
+
+        size_t start = beginMessage(client.outbox, MessageType::Welcome);
+        writeU32(client.outbox, VERSION);
+        writeU32(client.outbox, client.id);
+        endMessage(client.outbox, start);
+        break;
+    }
+    case MessageType::Position: {
+        float x = reader.f32();
+        float z = reader.f32();
+        if (reader.ok() && std::isfinite(x) && std::isfinite(z)) {
+            client.x = x;
+            client.z = z;
+        }
+        break;
+    }
+    case MessageType::SetBlock: {
+        int x = reader.i32();
+        int y = reader.i32();
+        int z = reader.i32();
+        uint8_t blockType = reader.u8();
+        if (reader.ok() && blockType < BLOCK_TYPE_COUNT) {
+            world.setBlockAt(x, y, z, static_cast<BlockType>(blockType));
+        }
+        break;
+    }
+    default:
+        // Unknown message: the client speaks another protocol
+        client.disconnected = true;
+        break;
+    }
+}
+
+void ChunkServer::moveSimulatedPlayer(ClientSession& client, float dt) {
+    client.orbitAngle += config.simulatedSpeed / SIMULATED_ORBIT_RADIUS * dt;
+    client.x = std::cos(client.orbitAngle) * SIMULATED_ORBIT_RADIUS;
+    client.z = std::sin(client.orbitAngle) * SIMULATED_ORBIT_RADIUS;
+}
+
+// =============================
+// Chunk streaming
+// =============================
+void ChunkServer::streamChunks(ClientSession& client, const std::vector<const Chunk*>& changed) {
+    std::vector<uint8_t>& out = client.simulated ? simulatedOutbox : client.outbox;
+    if (client.simulated) out.clear();
+    size_t startBytes = out.size();
+
+    int pcx = playerChunkX(client);
+    int pcz = playerChunkZ(client);
+
+    // Forget chunks the client has left behind (same margin as unloading)
+    float dropDistance = client.renderDistance + 2.0f;
+    for (auto it = client.sentChunks.begin(); it != client.sentChunks.end();) {
+        int cx = static_cast<int>(*it >> 32);
+        int cz = static_cast<int>(*it & 0xffffffff);
+        int dx = cx - pcx;
+        int dz = cz - pcz;
+        if (dx * dx + dz * dz <= dropDistance * dropDistance) {
+            ++it;
+            continue;
+        }
+
+        size_t start = beginMessage(out, MessageType::ChunkUnload);
+        writeI32(out, cx);
+        writeI32(out, cz);
+        endMessage(out, start);
+        it = client.sentChunks.erase(it);
+    }
+
+    // Chunks the client has whose light or blocks changed
+    for (const Chunk* chunk : changed) {
+        if (!client.sentChunks.count(makeKey(chunk->chunkX, chunk->chunkZ))) continue;
+        writeChunkData(out, *chunk);
+        stats.chunksResent++;
+    }
+
+    // New chunks, closest first
+    if (client.renderDistance > spiralRadius) {
+        spiralRadius = client.renderDistance;
+        spiralOffsets.clear();
+        for (int dx = -spiralRadius; dx <= spiralRadius; dx++) {
+            for (int dz = -spiralRadius; dz <= spiralRadius; dz++) {
+                if (dx * dx + dz * dz <= spiralRadius * spiralRadius) spiralOffsets.push_back({ dx, dz });
+            }
+        }
+        std::sort(spiralOffsets.begin(), spiralOffsets.end(), [](const auto& a, const auto& b) {
+            return a.first * a.first + a.second * a.second < b.first * b.first + b.second * b.second;
+            });
+    }
+
+    int renderDistanceSquared = client.renderDistance * client.renderDistance;
+    int sent = 0;
+    for (const auto& [dx, dz] : spiralOffsets) {
+        if (dx * dx + dz * dz > renderDistanceSquared) break;
+        if (sent >= config.maxChunksPerTick) break;
+        if (out.size() - client.outboxOffset > config.maxQueuedBytes) break;  // Client is not keeping up
+
+        long long key = makeKey(pcx + dx, pcz + dz);
+        if (client.sentChunks.count(key)) continue;
+
+        const Chunk* chunk = world.getServableChunk(pcx + dx, pcz + dz);
+        if (!chunk) continue;
+
+        writeChunkData(out, *chunk);
+        client.sentChunks.insert(key);
+        stats.chunksServed++;
+        sent++;
+    }
+
+    stats.bytesServed += out.size() - startBytes;
+}
+
+void ChunkServer::flushClient(ClientSession& client) {
+    while (client.outboxOffset < client.outbox.size()) {
+        long long written = client.socket.send(client.outbox.data() + client.outboxOffset,
+            client.outbox.size() - client.outboxOffset);
+        if (written < 0) {
+            client.disconnected = true;
+            return;
+        }
+        if (written == 0) break;
+        client.outboxOffset += static_cast<size_t>(written);
+    }
+
+    if (client.outboxOffset == client.outbox.size()) {
+        client.outbox.clear();
+        client.outboxOffset = 0;
+    }
+    else if (client.outboxOffset > client.outbox.size() / 2) {
+        client.outbox.erase(client.outbox.begin(), client.outbox.begin() + client.outboxOffset);
+        client.outboxOffset = 0;
+    }
+}
+
+// =============================
+// Reporting
+// =============================
+void ChunkServer::report(float windowSeconds) {
+    std::vector<float> window(stats.tickMs.begin() + std::min(reportedTicks, stats.tickMs.size()), stats.tickMs.end());
+    float averageMs = 0.0f;
+    for (float ms : window) averageMs += ms;
+    if (!window.empty()) averageMs /= window.size();
+
+    unsigned long long served = stats.chunksServed - reportedServed;
+    unsigned long long bytes = stats.bytesServed - reportedBytes;
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "[server] " << clients.size() << " clients, " << world.getLoadedChunkCount() << " chunks loaded, "
+        << world.getPendingGenerationCount() << " pending | "
+        << served / windowSeconds << " chunks/s served (" << bytes / windowSeconds / (1024.0f * 1024.0f) << " MB/s) | "
+        << "tick avg " << averageMs << " ms, p99 " << percentile(window, 0.99f)
+        << " ms, max " << percentile(window, 1.0f) << " ms\n";
+
+    reportedTicks = stats.tickMs.size();
+    reportedServed = stats.chunksServed;
+    reportedBytes = stats.bytesServed;
+}
@@ -0,0 +1,57 @@
+// Dedicated headless server: world streaming, lighting and saving without
+// a window or GL context.
+//
+// Usage: minecraft_server [--port N | --no-listen] [--players N]
+//            [--render-distance N] [--tps N] [--duration S] [--report S]
+//            [--workers N] [--world NAME]
+//
+// --players adds in-process simulated players that fly in a circle; bots
+// (server_bot) connect over 127.0.0.1.
+
+#include "Server/ChunkServer.h"
+#include "Server/NetProtocol.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    ChunkServerConfig config;
+    config.port = NetProtocol::DEFAULT_PORT;
+    float durationSeconds = 0.0f;
+    float reportSeconds = 5.0f;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--port" && hasValue) config.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        else if (arg == "--no-listen") config.port = 0;
+        else if (arg == "--players" && hasValue) config.simulatedPlayers = std::atoi(argv[++i]);
+        else if (arg == "--render-distance" && hasValue) config.simulatedRenderDistance = std::atoi(argv[++i]);
+        else if (arg == "--tps" && hasValue) config.tickRate = std::atoi(argv[++i]);
+        else if (arg == "--duration" && hasValue) durationSeconds = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--report" && hasValue) reportSeconds = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--workers" && hasValue) config.workerCount = static_cast<unsigned int>(std::atoi(argv[++i]));
+        else if (arg == "--world" && hasValue) config.worldName = argv[++i];
+        else {
+            std::cerr << "Usage: minecraft_server [--port N | --no-listen] [--players N] [--render-distance N]\n"
+                "                        [--tps N] [--duration S] [--report S] [--workers N] [--world NAME]\n";
+            return 1;
+        }
+    }
+
+    if (config.tickRate < 1 || config.simulatedPlayers < 0 || config.simulatedRenderDistance < 1) {
+        std::cerr << "Invalid arguments\n";
+        return 1;
+    }
+    if (config.port == 0 && config.simulatedPlayers == 0) {
+        std::cerr << "Nothing to serve: pass --players or listen on a port\n";
+        return 1;
+    }
+
+    ChunkServer server(config);
+    if (!server.start()) return 1;
+
+    server.run(durationSeconds, reportSeconds);
+    return 0;
+}
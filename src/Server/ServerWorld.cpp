@@ -0,0 +1,155 @@
+#include "Server/ServerWorld.h"
+#include "TerrainGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// =============================
+// Constructor / Destructor
+// =============================
+ServerWorld::ServerWorld(const std::string& worldName, unsigned int workerCount)
+    : pipeline(worldName, CHUNK_CACHE_BYTES, workerCount) {
+}
+
+ServerWorld::~ServerWorld() = default;
+
+// =============================
+// Tick update
+// =============================
+void ServerWorld::update(const std::vector<ViewerInterest>& viewers, float budgetMs) {
+    using Clock = std::chrono::steady_clock;
+
+    // Squared distance to the nearest viewer that wants the chunk, or -1
+    auto wantedDistance = [&](int cx, int cz) {
+        int best = -1;
+        for (const ViewerInterest& viewer : viewers) {
+            int dx = cx - viewer.chunkX;
+            int dz = cz - viewer.chunkZ;
+            if (!ChunkPipeline::isInLoadRange(dx, dz, viewer.renderDistance)) continue;
+            int distanceSquared = dx * dx + dz * dz;
+            if (best < 0 || distanceSquared < best) best = distanceSquared;
+        }
+        return best;
+    };
+
+    // Kept until every viewer is more than renderDistance + 2 away
+    auto isRetained = [&](int cx, int cz) {
+        for (const ViewerInterest& viewer : viewers) {
+            int dx = cx - viewer.chunkX;
+            int dz = cz - viewer.chunkZ;
+            float limit = viewer.renderDistance + 2.0f;
+            if (dx * dx + dz * dz <= limit * limit) return true;
+        }
+        return false;
+    };
+
+    // Unload first so the cache can serve chunks requested below
+    std::vector<Chunk*> toUnload;
+    for (auto& [_, chunk] : pipeline.getChunks()) {
+        if (!isRetained(chunk->chunkX, chunk->chunkZ)) toUnload.push_back(chunk);
+    }
+    for (Chunk* chunk : toUnload) {
+        unloadChunk(chunk);
+    }
+
+    // Queue everything wanted that isn't loaded or already on its way
+    for (const ViewerInterest& viewer : viewers) {
+        int reach = viewer.renderDistance + 1;
+        for (int dx = -reach; dx <= reach; dx++) {
+            for (int dz = -reach; dz <= reach; dz++) {
+                if (!ChunkPipeline::isInLoadRange(dx, dz, viewer.renderDistance)) continue;
+                pipeline.request(viewer.chunkX + dx, viewer.chunkZ + dz);
+            }
+        }
+    }
+
+    // Closest to any viewer first; drop what nobody wants any more
+    pipeline.submitRequests([&](int cx, int cz) {
+        return static_cast<float>(wantedDistance(cx, cz));
+        });
+
+    // Integrate finished chunks within the tick budget (always at least one)
+    Clock::time_point start = Clock::now();
+    while (Chunk* chunk = pipeline.popReady()) {
+        if (!isRetained(chunk->chunkX, chunk->chunkZ)) {
+            pipeline.discard(chunk);
+            continue;
+        }
+
+        integrateChunk(chunk);
+
+        float elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        if (elapsedMs >= budgetMs) break;
+    }
+}
+
+// =============================
+// Integration (tick thread)
+// =============================
+// NeighborsReady is as far as the server goes: newly servable chunks are
+// picked up by the clients' next requests, relit ones are resent
+void ServerWorld::integrateChunk(Chunk* chunk) {
+    pipeline.insert(chunk);
+
+    relitChunks.clear();
+    readyChunks.clear();
+    pipeline.exchangeBorderLight(chunk, relitChunks, readyChunks);
+    collectChanged(relitChunks);
+}
+
+void ServerWorld::collectChanged(std::unordered_set<Chunk*>& dirty) {
+    for (Chunk* chunk : dirty) {
+        if (chunk->state == ChunkState::NeighborsReady) changedChunks.insert(chunk);
+    }
+    dirty.clear();
+}
+
+void ServerWorld::unloadChunk(Chunk* chunk) {
+    changedChunks.erase(chunk);
+    pipeline.unload(chunk);
+}
+
+// =============================
+// Queries and edits
+// =============================
+const Chunk* ServerWorld::getServableChunk(int chunkX, int chunkZ) const {
+    const Chunk* chunk = pipeline.findChunk(chunkX, chunkZ);
+    return chunk && chunk->state == ChunkState::NeighborsReady ? chunk : nullptr;
+}
+
+bool ServerWorld::setBlockAt(int worldX, int worldY, int worldZ, BlockType type) {
+    if (worldY < 0 || worldY >= CHUNK_SIZE_Y) return false;
+
+    std::optional<Block> current = pipeline.getBlock(worldX, worldY, worldZ);
+    if (!current || current->type == type) return false;
+
+    int chunkX = worldX / CHUNK_SIZE_X;
+    if (worldX < 0 && worldX % CHUNK_SIZE_X != 0) chunkX--;
+
+    int chunkZ = worldZ / CHUNK_SIZE_Z;
+    if (worldZ < 0 && worldZ % CHUNK_SIZE_Z != 0) chunkZ--;
+
+    relitChunks.clear();
+    relitChunks.insert(pipeline.findChunk(chunkX, chunkZ));
+    pipeline.setBlock(worldX, worldY, worldZ, type, FLUID_SOURCE, relitChunks);
+    collectChanged(relitChunks);
+
+    blockEdits++;
+    return true;
+}
+
+void ServerWorld::takeChangedChunks(std::vector<const Chunk*>& changed) {
+    changed.assign(changedChunks.begin(), changedChunks.end());
+    changedChunks.clear();
+}
+
+ServerWorldStats ServerWorld::getStats() const {
+    const GenerationStats& generation = pipeline.getStats();
+
+    ServerWorldStats stats;
+    stats.generated = generation.completed - generation.wasted;
+    stats.restoredFromCache = generation.restored;
+    stats.unloaded = generation.unloaded;
+    stats.blockEdits = blockEdits;
+    return stats;
+}
@@ -0,0 +1,174 @@
+#include "Server/Socket.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketHandle = SOCKET;
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketHandle = int;
+#endif
+
+namespace {
+    SocketHandle native(intptr_t handle) {
+        return static_cast<SocketHandle>(handle);
+    }
+
+    bool wouldBlock() {
+#ifdef _WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+    }
+
+    sockaddr_in loopbackAddress(const char* host, uint16_t port) {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, host, &address.sin_addr);
+        return address;
+    }
+}
+
+bool Socket::initializeNetworking() {
+#ifdef _WIN32
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+    return true;
+#endif
+}
+
+Socket::~Socket() {
+    close();
+}
+
+Socket::Socket(Socket&& other) noexcept
+    : handle(other.handle) {
+    other.handle = INVALID_HANDLE;
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle = other.handle;
+        other.handle = INVALID_HANDLE;
+    }
+    return *this;
+}
+
+void Socket::close() {
+    if (!isValid()) return;
+#ifdef _WIN32
+    closesocket(native(handle));
+#else
+    ::close(native(handle));
+#endif
+    handle = INVALID_HANDLE;
+}
+
+bool Socket::setNonBlocking() {
+#ifdef _WIN32
+    u_long mode = 1;
+    return ioctlsocket(native(handle), FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(native(handle), F_GETFL, 0);
+    return flags >= 0 && fcntl(native(handle), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+bool Socket::listen(uint16_t port) {
+    close();
+
+    SocketHandle listener = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    handle = static_cast<intptr_t>(listener);
+#ifdef _WIN32
+    if (listener == INVALID_SOCKET) handle = INVALID_HANDLE;
+#endif
+    if (!isValid()) return false;
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = loopbackAddress("127.0.0.1", port);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0 || !setNonBlocking()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+Socket Socket::accept() {
+    if (!isValid()) return Socket();
+
+    SocketHandle client = ::accept(native(handle), nullptr, nullptr);
+#ifdef _WIN32
+    if (client == INVALID_SOCKET) return Socket();
+#else
+    if (client < 0) return Socket();
+#endif
+
+    Socket accepted(static_cast<intptr_t>(client));
+    int noDelay = 1;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+    if (!accepted.setNonBlocking()) return Socket();
+    return accepted;
+}
+
+bool Socket::connect(const char* host, uint16_t port) {
+    close();
+
+    SocketHandle connection = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    handle = static_cast<intptr_t>(connection);
+#ifdef _WIN32
+    if (connection == INVALID_SOCKET) handle = INVALID_HANDLE;
+#endif
+    if (!isValid()) return false;
+
+    sockaddr_in address = loopbackAddress(host, port);
+    if (::connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close();
+        return false;
+    }
+
+    int noDelay = 1;
+    setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+    if (!setNonBlocking()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+long long Socket::send(const uint8_t* data, size_t size) {
+    if (!isValid()) return -1;
+
+#ifdef _WIN32
+    int sent = ::send(native(handle), reinterpret_cast<const char*>(data), static_cast<int>(size), 0);
+#else
+    ssize_t sent = ::send(native(handle), data, size, MSG_NOSIGNAL);
+#endif
+    if (sent < 0) return wouldBlock() ? 0 : -1;
+    return sent;
+}
+
+long long Socket::receive(uint8_t* data, size_t size) {
+    if (!isValid()) return -1;
+
+#ifdef _WIN32
+    int received = ::recv(native(handle), reinterpret_cast<char*>(data), static_cast<int>(size), 0);
+#else
+    ssize_t received = ::recv(native(handle), data, size, 0);
+#endif
+    if (received == 0) return -1;
+    if (received < 0) return wouldBlock() ? 0 : -1;
+    return received;
+}
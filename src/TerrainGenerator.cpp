@@ -5,7 +5,7 @@
 #include <cmath>
 #include <algorithm>
 
-static Noise noise(12345);
+static Noise noise(TerrainGenerator::SEED);
 
 // =====================================================
 // UTILITY FUNCTIONS
@@ -69,21 +69,13 @@ void TerrainGenerator::generateFlatTerrain(Chunk& chunk) {
     const int chunkWorldX = chunk.chunkX * CHUNK_SIZE_X;
     const int chunkWorldZ = chunk.chunkZ * CHUNK_SIZE_Z;
 
-    static float densityField[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
-    static bool isCaveExposed[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+    // Per-thread scratch: several generation workers run this concurrently
+    static thread_local float densityField[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
 
     int heightMap[CHUNK_SIZE_X][CHUNK_SIZE_Z];
     float biomeMap[CHUNK_SIZE_X][CHUNK_SIZE_Z];
     float steepnessMap[CHUNK_SIZE_X][CHUNK_SIZE_Z];
 
-    // -------------------------------------------------
-    // CLEAR CAVE EXPOSURE
-    // -------------------------------------------------
-    for (int x = 0; x < CHUNK_SIZE_X; x++)
-        for (int y = 0; y < CHUNK_SIZE_Y; y++)
-            for (int z = 0; z < CHUNK_SIZE_Z; z++)
-                isCaveExposed[x][y][z] = false;
-
     // -------------------------------------------------
     // PASS 1: BIOME + BASE HEIGHT
     // -------------------------------------------------
@@ -168,7 +160,6 @@ void TerrainGenerator::generateFlatTerrain(Chunk& chunk) {
 
                 if ((wormA * wormA + wormB * wormB) < 0.012f * caveMask) {
                     densityField[x][y][z] = -1.0f;
-                    if (depth < 15.0f) isCaveExposed[x][y][z] = true;
                     continue;
                 }
 
@@ -184,7 +175,6 @@ void TerrainGenerator::generateFlatTerrain(Chunk& chunk) {
                     float sB = noise.perlin3D(wx * 0.025f + 1000.0f, y * 0.03f, wz * 0.025f + 1000.0f);
                     if ((std::abs(sA) + std::abs(sB)) < 0.15f * caveMask) {
                         densityField[x][y][z] = -1.0f;
-                        if (depth < 15.0f) isCaveExposed[x][y][z] = true;
                     }
                 }
             }
@@ -238,6 +228,18 @@ void TerrainGenerator::generateFlatTerrain(Chunk& chunk) {
                     chunk.setBlock(x, y, z, BlockType::STONE);
                 }
             }
+
+            // Sparse tall grass, hashed from the world column so it doesn't
+            // depend on generation order
+            if (topSolidY > 0 && topSolidY + 1 < CHUNK_SIZE_Y &&
+                chunk.getBlock(x, topSolidY, z).type == BlockType::GRASS) {
+                uint32_t hash = static_cast<uint32_t>(chunkWorldX + x) * 73856093u ^
+                    static_cast<uint32_t>(chunkWorldZ + z) * 19349663u;
+                hash = (hash ^ (hash >> 13)) * 1274126177u;
+                if ((hash >> 24) % 12 == 0) {
+                    chunk.setBlock(x, topSolidY + 1, z, BlockType::TALL_GRASS);
+                }
+            }
         }
     }
 }
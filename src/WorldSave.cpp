@@ -1,4 +1,5 @@
 #include "WorldSave.h"
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 
@@ -23,19 +24,45 @@ long long WorldSave::makeBlockKey(int x, int y, int z) {
     return key;
 }
 
-void WorldSave::saveBlockChange(int x, int y, int z, BlockType type) {
+void WorldSave::unpackBlockKey(long long key, int& x, int& y, int& z) {
+    x = (int)((key >> 33) & 0x1FFFFF);
+    y = (int)((key >> 21) & 0xFFF);
+    z = (int)(key & 0x1FFFFF);
+
+    if (x & 0x100000) x |= 0xFFE00000;
+    if (z & 0x100000) z |= 0xFFE00000;
+}
+
+long long WorldSave::makeChunkKey(int chunkX, int chunkZ) {
+    return ((long long)chunkX << 32) ^ (unsigned int)chunkZ;
+}
+
+long long WorldSave::chunkKeyOf(int x, int z) {
+    int chunkX = x / 16;
+    if (x < 0 && x % 16 != 0) chunkX--;
+
+    int chunkZ = z / 16;
+    if (z < 0 && z % 16 != 0) chunkZ--;
+
+    return makeChunkKey(chunkX, chunkZ);
+}
+
+void WorldSave::saveBlockChange(int x, int y, int z, BlockType type, unsigned char fluidLevel) {
     std::lock_guard<std::mutex> lock(saveMutex);
-    long long key = makeBlockKey(x, y, z);
-    modifiedBlocks[key] = type;
+    storeBlockChange(x, y, z, { type, fluidLevel });
     isDirty = true;  // Mark as having unsaved changes
 }
 
+void WorldSave::storeBlockChange(int x, int y, int z, SavedBlock saved) {
+    auto [it, added] = modifiedChunks[chunkKeyOf(x, z)].insert_or_assign(makeBlockKey(x, y, z), saved);
+    if (added) modifiedCount++;
+}
+
 bool WorldSave::getBlockChange(int x, int y, int z, BlockType& outType) {
     std::lock_guard<std::mutex> lock(saveMutex);
-    long long key = makeBlockKey(x, y, z);
-    auto it = modifiedBlocks.find(key);
-    if (it != modifiedBlocks.end()) {
-        outType = it->second;
+    const SavedBlock* saved = findBlockChange(x, y, z);
+    if (saved) {
+        outType = saved->type;
         return true;
     }
     return false;
@@ -43,32 +70,36 @@ bool WorldSave::getBlockChange(int x, int y, int z, BlockType& outType) {
 
 bool WorldSave::hasBlockChange(int x, int y, int z) {
     std::lock_guard<std::mutex> lock(saveMutex);
-    long long key = makeBlockKey(x, y, z);
-    return modifiedBlocks.find(key) != modifiedBlocks.end();
+    return findBlockChange(x, y, z) != nullptr;
 }
 
-void WorldSave::loadChunkModifications(int chunkX, int chunkZ, std::vector<ModifiedBlock>& modifications) {
-    std::lock_guard<std::mutex> lock(saveMutex);
+const WorldSave::SavedBlock* WorldSave::findBlockChange(int x, int y, int z) const {
+    auto chunk = modifiedChunks.find(chunkKeyOf(x, z));
+    if (chunk == modifiedChunks.end()) return nullptr;
 
-    int minX = chunkX * 16;
-    int maxX = minX + 16;
-    int minZ = chunkZ * 16;
-    int maxZ = minZ + 16;
+    auto it = chunk->second.find(makeBlockKey(x, y, z));
+    return it != chunk->second.end() ? &it->second : nullptr;
+}
 
-    for (auto& [key, type] : modifiedBlocks) {
-        int x = (int)((key >> 33) & 0x1FFFFF);
-        int y = (int)((key >> 21) & 0xFFF);
-        int z = (int)(key & 0x1FFFFF);
+void WorldSave::loadChunkModifications(int chunkX, int chunkZ, std::vector<ModifiedBlock>& modifications) {
+    std::lock_guard<std::mutex> lock(saveMutex);
 
-        if (x & 0x100000) x |= 0xFFE00000;
-        if (z & 0x100000) z |= 0xFFE00000;
+    auto chunk = modifiedChunks.find(makeChunkKey(chunkX, chunkZ));
+    if (chunk == modifiedChunks.end()) return;
 
-        if (x >= minX && x < maxX && z >= minZ && z < maxZ) {
-            modifications.push_back({ x, y, z, type });
-        }
+    modifications.reserve(modifications.size() + chunk->second.size());
+    for (auto& [key, saved] : chunk->second) {
+        int x, y, z;
+        unpackBlockKey(key, x, y, z);
+        modifications.push_back({ x, y, z, saved.type, saved.fluidLevel });
     }
 }
 
+size_t WorldSave::getModificationCount() {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    return modifiedCount;
+}
+
 void WorldSave::loadFromDisk() {
     std::string filepath = getSaveFilePath();
     std::ifstream file(filepath, std::ios::binary);
@@ -78,27 +109,107 @@ void WorldSave::loadFromDisk() {
         return;
     }
 
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    if (std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        // Version 1: the first four bytes were the record count
+        int count;
+        std::memcpy(&count, magic, sizeof(int));
+        if (!loadLegacy(file, count)) return;
+
+        file.close();
+        std::string backupPath = "SavedData/" + worldName + "/world_blocks.v1.dat";
+        if (!backUpSaveFile(filepath, backupPath)) {
+            // Play on the loaded blocks, but leave the only copy of the original alone
+            std::cerr << "Not converting version 1 save; changes will not be saved this session" << std::endl;
+            saveLocked = true;
+            return;
+        }
+        isDirty = true;
+        saveToDisk();
+        if (isDirty) return;  // saveToDisk logged why
+        std::cout << "Converted " << count << " block modifications to save version " << FILE_VERSION
+            << " (original kept at " << backupPath << ")" << std::endl;
+        return;
+    }
+
+    int version;
     int count;
+    file.read((char*)&version, sizeof(int));
     file.read((char*)&count, sizeof(int));
+    if (!file || version < 2 || version > FILE_VERSION) {
+        std::cerr << "Unsupported save version " << version << " in: " << filepath
+            << "; changes will not be saved this session" << std::endl;
+        saveLocked = true;
+        return;
+    }
+
+    int loaded = 0;
+    for (; loaded < count; loaded++) {
+        int x, y, z;
+        uint8_t type;
+        uint8_t fluidLevel = FLUID_SOURCE;
+        file.read((char*)&x, sizeof(int));
+        file.read((char*)&y, sizeof(int));
+        file.read((char*)&z, sizeof(int));
+        file.read((char*)&type, sizeof(uint8_t));
+        if (version >= 3) file.read((char*)&fluidLevel, sizeof(uint8_t));
+        if (!file || type >= BLOCK_TYPE_COUNT || fluidLevel > 0xF) break;
+
+        storeBlockChange(x, y, z, { static_cast<BlockType>(type), fluidLevel });
+    }
+    file.close();
 
+    if (loaded < count) {
+        // The next save writes only the records read so far: keep the damaged
+        // file first, and if that fails don't save at all
+        std::string backupPath = "SavedData/" + worldName + "/world_blocks.corrupt.dat";
+        std::cerr << "Save file truncated or corrupt after " << loaded << " of " << count << " records: " << filepath << std::endl;
+        if (backUpSaveFile(filepath, backupPath)) {
+            std::cerr << "Damaged save kept at " << backupPath << std::endl;
+        }
+        else {
+            std::cerr << "Changes will not be saved this session" << std::endl;
+            saveLocked = true;
+        }
+    }
+
+    std::cout << "Loaded " << loaded << " block modifications from: " << filepath << std::endl;
+}
+
+bool WorldSave::loadLegacy(std::ifstream& file, int count) {
     for (int i = 0; i < count; i++) {
         int x, y, z;
-        BlockType type;
+        int32_t type;
         file.read((char*)&x, sizeof(int));
         file.read((char*)&y, sizeof(int));
         file.read((char*)&z, sizeof(int));
-        file.read((char*)&type, sizeof(BlockType));
+        file.read((char*)&type, sizeof(int32_t));
+        if (!file || type < 0 || type >= BLOCK_TYPE_COUNT) {
+            // Leave the file alone rather than overwrite it with a partial conversion
+            std::cerr << "Version 1 save truncated or corrupt after " << i << " records; not converting" << std::endl;
+            modifiedChunks.clear();
+            modifiedCount = 0;
+            return false;
+        }
 
-        long long key = makeBlockKey(x, y, z);
-        modifiedBlocks[key] = type;
+        storeBlockChange(x, y, z, { static_cast<BlockType>(type), FLUID_SOURCE });
     }
+    return true;
+}
 
-    file.close();
-    std::cout << "Loaded " << count << " block modifications from: " << filepath << std::endl;
+bool WorldSave::backUpSaveFile(const std::string& filepath, const std::string& backupPath) {
+    std::error_code error;
+    std::filesystem::copy_file(filepath, backupPath, std::filesystem::copy_options::overwrite_existing, error);
+    if (error) {
+        std::cerr << "Failed to back up " << filepath << " to " << backupPath << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
 }
 
 void WorldSave::saveToDisk() {
-    if (!isDirty) return;  // Don't save if nothing changed
+    if (!isDirty || saveLocked) return;  // Nothing changed, or the file on disk must be kept
 
     std::string filepath = getSaveFilePath();
     std::ofstream file(filepath, std::ios::binary);
@@ -107,21 +218,25 @@ void WorldSave::saveToDisk() {
         return;
     }
 
-    int count = modifiedBlocks.size();
+    int version = FILE_VERSION;
+    int count = static_cast<int>(modifiedCount);
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write((char*)&version, sizeof(int));
     file.write((char*)&count, sizeof(int));
 
-    for (auto& [key, type] : modifiedBlocks) {
-        int x = (int)((key >> 33) & 0x1FFFFF);
-        int y = (int)((key >> 21) & 0xFFF);
-        int z = (int)(key & 0x1FFFFF);
-
-        if (x & 0x100000) x |= 0xFFE00000;
-        if (z & 0x100000) z |= 0xFFE00000;
+    for (auto& [chunkKey, blocks] : modifiedChunks) {
+        for (auto& [key, saved] : blocks) {
+            int x, y, z;
+            unpackBlockKey(key, x, y, z);
 
-        file.write((char*)&x, sizeof(int));
-        file.write((char*)&y, sizeof(int));
-        file.write((char*)&z, sizeof(int));
-        file.write((char*)&type, sizeof(BlockType));
+            uint8_t typeId = static_cast<uint8_t>(saved.type);
+            uint8_t fluidLevel = saved.fluidLevel;
+            file.write((char*)&x, sizeof(int));
+            file.write((char*)&y, sizeof(int));
+            file.write((char*)&z, sizeof(int));
+            file.write((char*)&typeId, sizeof(uint8_t));
+            file.write((char*)&fluidLevel, sizeof(uint8_t));
+        }
     }
 
     file.close();
@@ -133,7 +248,7 @@ void WorldSave::autoSaveCheck() {
     auto now = std::chrono::steady_clock::now();
     float elapsed = std::chrono::duration<float>(now - lastSaveTime).count();
 
-    if (elapsed >= autoSaveInterval && isDirty) {
+    if (elapsed >= autoSaveInterval && isDirty && !saveLocked) {
         std::cout << "Auto-saving world..." << std::endl;
         saveToDisk();
         lastSaveTime = now;
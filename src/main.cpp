@@ -6,6 +6,7 @@
 #include <cmath>
 #include <chrono>
 #include <thread>
+#include <string>
 
 #define STB_IMAGE_IMPLEMENTATION
 #ifdef _MSC_VER
@@ -21,10 +22,11 @@
 #include "Player/Player.h"
 #include "Player/BlockInteraction.h"
 #include "Rendering/Renderer.h"
-#include "Rendering/Texture.h"
+#include "BlockRegistry.h"
 #include "Rendering/Shader.h"
 #include "Rendering/Skybox.h"
 #include "Rendering/Lighting.h"
+#include "Rendering/ChunkRenderer.h"
 #include "Window.h"
 #include "GUI/PauseMenu.h"
 #include "GUI/DebugOverlay.h"
@@ -34,6 +36,8 @@
 #include "Chunk.h"
 #include "TerrainGenerator.h"
 #include "ChunkManager.h"
+#include "FluidSimulation.h"
+#include "FixedTimestep.h"
 
 // GPU-OPTIMIZED: Shader receives global light level and scales in real-time
 const char* vertexShaderSource = R"(
@@ -42,10 +46,14 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 layout (location = 2) in vec3 aNormal;
 layout (location = 3) in float aLightLevel;  // This is the MAX light (0-1), calculated once
+layout (location = 4) in vec3 aBlockLight;   // RGB block light (0-1), independent of time of day
+layout (location = 5) in float aAO;          // Ambient occlusion baked per vertex by the mesher
 
 out vec2 texCoord;
 out vec3 normal;
 out float lightLevel;
+out vec3 blockLight;
+out float ao;
 
 uniform mat4 model;
 uniform mat4 view;
@@ -56,6 +64,8 @@ void main()
     texCoord = aTexCoord;
     normal = aNormal;
     lightLevel = aLightLevel;  // Pass max light to fragment shader
+    blockLight = aBlockLight;
+    ao = aAO;
     gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
 )";
@@ -68,6 +78,8 @@ out vec4 FragColor;
 in vec2 texCoord;
 in vec3 normal;
 in float lightLevel;  // Max light level (0-1) from vertex
+in vec3 blockLight;   // RGB block light (0-1) from vertex
+in float ao;          // Interpolated vertex ambient occlusion
 
 uniform sampler2D ourTexture;
 uniform float globalSkyLightLevel;  // Current sky light (0-15)
@@ -75,6 +87,10 @@ uniform float globalSkyLightLevel;  // Current sky light (0-15)
 void main()
 {
     vec4 texColor = texture(ourTexture, texCoord);
+#ifdef ALPHA_TEST
+    // Cutout blocks: clear texels are holes, not blended
+    if (texColor.a < 0.5) discard;
+#endif
     vec3 norm = normalize(normal);
     
     // GPU MAGIC: Scale the max light by current global level
@@ -84,19 +100,30 @@ void main()
     // Minecraft-style brightness curve
     float brightness = pow(actualLight, 2.2) * 0.95 + 0.05;
     
-    // Ambient occlusion
-    float ao = 1.0;
-    if (norm.y > 0.9) ao = 1.0;
-    else if (norm.y < -0.9) ao = 0.5;
-    else ao = 0.8;
+    // Block light is not scaled by time of day; the brighter source wins per channel
+    vec3 blockBrightness = pow(blockLight, vec3(2.2)) * 0.95;
+    
+    // Directional face shading (top brightest, bottom darkest)
+    float faceShade = 1.0;
+    if (norm.y > 0.9) faceShade = 1.0;
+    else if (norm.y < -0.9) faceShade = 0.5;
+    else faceShade = 0.8;
     
-    vec3 lighting = vec3(brightness * ao);
+    vec3 lighting = max(vec3(brightness), blockBrightness) * faceShade * ao;
     vec3 result = lighting * texColor.rgb;
     
     FragColor = vec4(result, texColor.a);
 }
 )";
 
+// Shader source with "#define <define>" inserted after its #version line
+std::string withShaderDefine(const char* source, const char* define) {
+    std::string result(source);
+    size_t lineEnd = result.find('\n', result.find("#version"));
+    result.insert(lineEnd + 1, std::string("#define ") + define + "\n");
+    return result;
+}
+
 void identityMatrix(float* mat) {
     for (int i = 0; i < 16; i++) mat[i] = 0.0f;
     mat[0] = mat[5] = mat[10] = mat[15] = 1.0f;
@@ -141,7 +168,33 @@ void lookAtMatrix(float* mat, float eyeX, float eyeY, float eyeZ,
     mat[14] = (fX * eyeX + fY * eyeY + fZ * eyeZ);
 }
 
+// Simulation (player movement, day/night) runs at a fixed rate; frames
+// interpolate between ticks. After a hitch at most MAX_TICKS_PER_FRAME
+// ticks are run to catch up.
+constexpr int SIMULATION_TICK_RATE = 60;
+constexpr int MAX_TICKS_PER_FRAME = 5;
+
+// Remeshing chunks changed by fluid ticks gets at most this much of a
+// frame; what doesn't fit carries over to the next one
+constexpr float MESH_REBUILD_BUDGET_MS = 4.0f;
+
+// Scripted fly-through benchmark (--flythrough): flies a fixed path in
+// spectator mode, turning 90 degrees every 10 seconds, then reports how
+// long the visible chunks took to fill in after each move/turn
+struct FlyThroughBenchmark {
+    bool active = false;
+    float elapsed = 0.0f;
+    const float duration = 60.0f;
+    const float speed = 40.0f;       // Blocks per second, about sprint-flying
+    const float turnRate = 90.0f;    // Degrees per second during a turn
+};
+
 int main(int argc, char* argv[]) {
+    FlyThroughBenchmark flyThrough;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--flythrough") flyThrough.active = true;
+    }
+
     Window window("Minecraft Clone", 800, 600);
     if (!window.initialize()) {
         return -1;
@@ -170,33 +223,31 @@ int main(int argc, char* argv[]) {
     SDL_SetWindowRelativeMouseMode(window.getSDLWindow(), true);
 
     Shader shader(vertexShaderSource, fragmentShaderSource);
-    Texture grassBlockTexture("assets/textures/blocks/GrassBlock.png");
-    Texture dirtBlockTexture("assets/textures/blocks/DirtBlock.png");
-    Texture stoneBlockTexture("assets/textures/blocks/StoneBlock.png");
-    Texture sandBlockTexture("assets/textures/blocks/SandBlock.png");
-	Texture blockOfPureWhiteLightTexture("assets/textures/blocks/BlockOfPureWhiteLight.png");
-	Texture blockOfPureRedLightTexture("assets/textures/blocks/BlockOfPureRedLight.png");
-	Texture blockOfPureGreenLightTexture("assets/textures/blocks/BlockOfPureGreenLight.png");
-	Texture blockOfPureBlueLightTexture("assets/textures/blocks/BlockOfPureBlueLight.png");
+    // Alpha-tested variant for the cutout layer; discard is kept out of the
+    // opaque pass so it keeps early depth testing
+    std::string cutoutFragmentSource = withShaderDefine(fragmentShaderSource, "ALPHA_TEST");
+    Shader cutoutShader(vertexShaderSource, cutoutFragmentSource.c_str());
+    BlockRegistry& blockRegistry = BlockRegistry::getInstance();
+    blockRegistry.loadTextures();
 
     float spawnX = 0.0f;
     float spawnZ = 0.0f;
     float spawnY = 120.0f;
 
     ChunkManager chunkManager(12, "world1");
+    ChunkRenderer chunkRenderer;
+    FluidSimulation fluidSimulation;
 
     int blockX = static_cast<int>(std::round(spawnX));
     int blockZ = static_cast<int>(std::round(-spawnZ));
 
     int highestSolidY = -1;
 
+    BlockRegion spawnColumn;
+    chunkManager.getBlocksInRegion(blockX, 120, blockZ, blockX, 199, blockZ, spawnColumn);
     for (int checkY = 120; checkY < 200; ++checkY) {
-        Block* block = chunkManager.getBlockAt(blockX, checkY, blockZ);
-        if (block) {
-            if (!block->isAir()) {
-                highestSolidY = checkY;
-            }
-            delete block;
+        if (spawnColumn.at(blockX, checkY, blockZ).isSolid()) {
+            highestSolidY = checkY;
         }
     }
 
@@ -209,7 +260,7 @@ int main(int argc, char* argv[]) {
 
     Player player(spawnX, spawnY, spawnZ);
     Camera camera(spawnX, spawnY, spawnZ);
-    player.setGameMode(GameMode::SURVIVAL);
+    player.setGameMode(flyThrough.active ? GameMode::SPECTATOR : GameMode::SURVIVAL);
 
     BlockInteraction blockInteraction;
     BlockType selectedBlock = BlockType::STONE;
@@ -225,18 +276,13 @@ int main(int argc, char* argv[]) {
     int fpsFrameCount = 0;
     float fps = 0.0f;
 
+    FixedTimestep simulationClock(SIMULATION_TICK_RATE, MAX_TICKS_PER_FRAME);
+
     while (running) {
         auto currentFrameTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentFrameTime - lastFrameTime).count();
         lastFrameTime = currentFrameTime;
 
-        // Update day/night cycle - NO MORE CHUNK RECALCULATION!
-        lighting.update(deltaTime, 1.0f / 3600.0f);
-
-        // Update ChunkManager's tracked light level (for debug/queries)
-        // Note: This doesn't recalculate chunks anymore, just tracks the value!
-        chunkManager.setGlobalSkyLightLevel(lighting.getSkyLightLevel());
-
         fpsFrameCount++;
         auto currentTime = std::chrono::high_resolution_clock::now();
         float fpsTime = std::chrono::duration<float>(currentTime - lastTime).count();
@@ -296,7 +342,7 @@ int main(int argc, char* argv[]) {
 
             if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN && !window.isPaused()) {
                 if (event.button.button == SDL_BUTTON_LEFT) {
-                    blockInteraction.breakBlock(camera, &chunkManager);
+                    blockInteraction.breakBlock(&chunkManager);
                 }
                 else if (event.button.button == SDL_BUTTON_RIGHT) {
                     if (hud.hasBlockInSlot()) {
@@ -326,43 +372,91 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        if (!window.isPaused()) {
-            const bool* keyState = SDL_GetKeyboardState(nullptr);
-            float deltaFront = 0.0f, deltaRight = 0.0f, deltaUp = 0.0f;
-            bool jump = false;
-            bool sprint = false;
+        const float fov = 70.0f * 3.14159f / 180.0f;
+        float aspect = (float)window.getWidth() / (float)window.getHeight();
+        chunkManager.setViewFrustum(std::atan(std::tan(fov / 2.0f) * aspect));
+
+        // Input is sampled once per frame and applied to every tick in it
+        const bool* keyState = SDL_GetKeyboardState(nullptr);
+        float deltaFront = 0.0f, deltaRight = 0.0f, deltaUp = 0.0f;
+        bool jump = false;
+        bool sprint = keyState[SDL_SCANCODE_LSHIFT] || keyState[SDL_SCANCODE_RSHIFT];
 
-            sprint = keyState[SDL_SCANCODE_LSHIFT] || keyState[SDL_SCANCODE_RSHIFT];
+        if (keyState[SDL_SCANCODE_W]) deltaFront += 1.0f;
+        if (keyState[SDL_SCANCODE_S]) deltaFront -= 1.0f;
+        if (keyState[SDL_SCANCODE_D]) deltaRight += 1.0f;
+        if (keyState[SDL_SCANCODE_A]) deltaRight -= 1.0f;
 
-            if (keyState[SDL_SCANCODE_W]) deltaFront += 1.0f;
-            if (keyState[SDL_SCANCODE_S]) deltaFront -= 1.0f;
-            if (keyState[SDL_SCANCODE_D]) deltaRight += 1.0f;
-            if (keyState[SDL_SCANCODE_A]) deltaRight -= 1.0f;
+        if (player.getGameMode() == GameMode::SPECTATOR) {
+            if (keyState[SDL_SCANCODE_SPACE]) deltaUp += 1.0f;
+            if (keyState[SDL_SCANCODE_LCTRL] || keyState[SDL_SCANCODE_RCTRL]) deltaUp -= 1.0f;
+        }
+        else {
+            if (keyState[SDL_SCANCODE_SPACE]) jump = true;
+        }
 
-            if (player.getGameMode() == GameMode::SPECTATOR) {
-                if (keyState[SDL_SCANCODE_SPACE]) deltaUp += 1.0f;
-                if (keyState[SDL_SCANCODE_LCTRL] || keyState[SDL_SCANCODE_RCTRL]) deltaUp -= 1.0f;
+        bool simulatePlayer = flyThrough.active || !window.isPaused();
+        int ticks = simulationClock.advance(deltaTime);
+        float tickSeconds = simulationClock.getTickSeconds();
+
+        for (int tick = 0; tick < ticks; tick++) {
+            // Update day/night cycle - NO MORE CHUNK RECALCULATION!
+            lighting.update(tickSeconds, 1.0f / 3600.0f);
+
+            if (flyThrough.active) {
+                flyThrough.elapsed += tickSeconds;
+                if (std::fmod(flyThrough.elapsed, 10.0f) < 1.0f) {
+                    camera.processMouseMovement(-flyThrough.turnRate * tickSeconds / camera.sensitivity, 0.0f);
+                }
+
+                player.velocityX = camera.frontX * flyThrough.speed;
+                player.velocityY = 0.0f;
+                player.velocityZ = camera.frontZ * flyThrough.speed;
+                player.update(tickSeconds, &chunkManager);
             }
-            else {
-                if (keyState[SDL_SCANCODE_SPACE]) jump = true;
+            else if (simulatePlayer) {
+                player.processInput(deltaFront, deltaRight, deltaUp, jump, sprint, camera);
+                player.update(tickSeconds, &chunkManager);
             }
 
-            player.processInput(deltaFront, deltaRight, deltaUp, jump, sprint, camera);
-            player.update(deltaTime, &chunkManager, camera);
-            chunkManager.update(player.x, player.z);
+            if (simulatePlayer) {
+                fluidSimulation.update(chunkManager);
+            }
+        }
+
+        // Blocks changed by this frame's fluid ticks, remeshed once
+        chunkManager.flushMeshRebuilds(MESH_REBUILD_BUDGET_MS);
+
+        // Update ChunkManager's tracked light level (for debug/queries)
+        // Note: This doesn't recalculate chunks anymore, just tracks the value!
+        chunkManager.setGlobalSkyLightLevel(lighting.getSkyLightLevel());
+
+        // Draw between the last two ticks; while paused the player is
+        // not simulated, so hold the latest position
+        player.updateCamera(camera, simulatePlayer ? simulationClock.getAlpha() : 1.0f);
+
+        if (simulatePlayer) {
+            chunkManager.update(player.x, player.z, camera.frontX, camera.frontZ);
+        }
+
+        if (flyThrough.active && flyThrough.elapsed >= flyThrough.duration) {
+            const ViewCompletionStats& stats = chunkManager.getViewCompletionStats();
+            std::cout << "Fly-through: " << stats.completions << " view completions, avg "
+                << stats.averageMs() << " ms, worst " << stats.worstMs << " ms, "
+                << stats.missingVisible << " visible chunks still missing" << std::endl;
+            running = false;
+        }
+
+        // Crosshair target: drawn by the outline below and used by clicks
+        // in the next frame's event loop, so the ray is cast once per frame
+        if (!window.isPaused()) {
+            blockInteraction.updateTarget(camera, &chunkManager);
         }
 
         glm::vec3 sky = lighting.getSkyColor();
         glClearColor(sky.r, sky.g, sky.b, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        shader.use();
-
-        // GPU OPTIMIZATION: Pass global sky light level to shader!
-        // This one uniform updates ALL chunks simultaneously on the GPU
-        float globalSkyLight = static_cast<float>(lighting.getSkyLightLevel());
-        glUniform1f(glGetUniformLocation(shader.getID(), "globalSkyLightLevel"), globalSkyLight);
-
         float model[16], view[16], projection[16];
         identityMatrix(model);
 
@@ -371,46 +465,55 @@ int main(int argc, char* argv[]) {
             camera.x + camera.frontX, camera.y + camera.frontY, camera.z + camera.frontZ,
             0.0f, 1.0f, 0.0f);
 
-        perspectiveMatrix(projection, 70.0f * 3.14159f / 180.0f,
-            (float)window.getWidth() / (float)window.getHeight(), 0.1f, 3000.0f);
-
-        unsigned int modelLoc = glGetUniformLocation(shader.getID(), "model");
-        unsigned int viewLoc = glGetUniformLocation(shader.getID(), "view");
-        unsigned int projLoc = glGetUniformLocation(shader.getID(), "projection");
-
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, view);
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, projection);
-
-        grassBlockTexture.bind();
-        chunkManager.renderType(BlockType::GRASS);
-
-        dirtBlockTexture.bind();
-        chunkManager.renderType(BlockType::DIRT);
-
-        stoneBlockTexture.bind();
-        chunkManager.renderType(BlockType::STONE);
-
-        sandBlockTexture.bind();
-        chunkManager.renderType(BlockType::SAND);
+        perspectiveMatrix(projection, fov, aspect, 0.1f, 3000.0f);
 
-		blockOfPureWhiteLightTexture.bind();
-		chunkManager.renderType(BlockType::BLOCKOFPUREWHITELIGHT);
+        // GPU OPTIMIZATION: Pass global sky light level to shader!
+        // This one uniform updates ALL chunks simultaneously on the GPU
+        float globalSkyLight = static_cast<float>(lighting.getSkyLightLevel());
 
-		blockOfPureRedLightTexture.bind();
-		chunkManager.renderType(BlockType::BLOCKOFPUREREDLIGHT);
+        auto useChunkShader = [&](Shader& chunkShader) {
+            chunkShader.use();
+            glUniform1f(glGetUniformLocation(chunkShader.getID(), "globalSkyLightLevel"), globalSkyLight);
+            glUniformMatrix4fv(glGetUniformLocation(chunkShader.getID(), "model"), 1, GL_FALSE, model);
+            glUniformMatrix4fv(glGetUniformLocation(chunkShader.getID(), "view"), 1, GL_FALSE, view);
+            glUniformMatrix4fv(glGetUniformLocation(chunkShader.getID(), "projection"), 1, GL_FALSE, projection);
+        };
+
+        auto renderLayer = [&](RenderLayer layer) {
+            for (int i = 0; i < BLOCK_TYPE_COUNT; i++) {
+                BlockType type = static_cast<BlockType>(i);
+                if (getBlockProperties(type).layer != layer) continue;
+                if (blockRegistry.bindTexture(type)) chunkRenderer.renderType(type);
+            }
+        };
 
-		blockOfPureGreenLightTexture.bind();
-		chunkManager.renderType(BlockType::BLOCKOFPUREGREENLIGHT);
+        // Upload meshes built since last frame
+        chunkRenderer.sync(chunkManager);
+        chunkRenderer.sortTranslucent(camera.x, camera.y, camera.z);
 
-		blockOfPureBlueLightTexture.bind();
-		chunkManager.renderType(BlockType::BLOCKOFPUREBLUELIGHT);
+        useChunkShader(shader);
+        renderLayer(RenderLayer::OPAQUE);
 
+        useChunkShader(cutoutShader);
+        renderLayer(RenderLayer::CUTOUT);
 
         skybox.render(view, projection, lighting.getTimeOfDay());
 
+        // Translucent last, blended back to front over everything else. No
+        // depth writes, and both sides drawn so a water surface still shows
+        // from below.
+        useChunkShader(shader);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDepthMask(GL_FALSE);
+        glDisable(GL_CULL_FACE);
+        chunkRenderer.renderTranslucent();
+        glEnable(GL_CULL_FACE);
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+
         if (!window.isPaused()) {
-            blockOutline.render(camera, &chunkManager, view, projection);
+            blockOutline.render(camera, &chunkManager, blockInteraction.getTarget(), view, projection);
         }
 
         if (!window.isPaused()) {
@@ -423,7 +526,7 @@ int main(int argc, char* argv[]) {
 
         debugOverlay.render(window.getWidth(), window.getHeight(),
             camera.x, camera.y, camera.z,
-            camera.yaw, fps, lighting.getTimeOfDay(), &chunkManager);
+            camera.yaw, fps, lighting.getTimeOfDay(), &chunkManager, blockInteraction.getTarget());
 
         if (window.isPaused()) {
             pauseMenu.render(window.getWidth(), window.getHeight());
@@ -432,6 +535,8 @@ int main(int argc, char* argv[]) {
         window.swapBuffers();
     }
 
+    chunkManager.exportIntegrationProfile("SavedData/integration_profile.csv");
+
     SDL_Quit();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include "BlockRaycast.h"
+#include <cmath>
+
+namespace {
+    constexpr int BASE_Y = 200;
+
+    // Stone at (5, BASE_Y, 5) under three blocks of water, in a cleared sky
+    struct PondWorld {
+        TestClientWorld world{ "test_block_raycast", 2 };
+
+        PondWorld() {
+            REQUIRE(world.isLoaded());
+            world.clearAbove(0, BASE_Y - 4, 0, CHUNK_SIZE_X - 1, CHUNK_SIZE_Z - 1);
+            world.setBlock(5, BASE_Y, 5, BlockType::STONE);
+            for (int y = BASE_Y + 1; y <= BASE_Y + 3; y++) {
+                world.setBlock(5, y, 5, BlockType::WATER);
+            }
+        }
+    };
+}
+
+// Rays look through fluids to the block behind them, as they do through air
+TEST_CASE(BlockRaycast, PassesThroughWater) {
+    PondWorld pond;
+    BlockRaycastHit hit;
+
+    REQUIRE(raycastBlocks(pond.world.chunkManager(), 5.0f, BASE_Y + 6.0f, -5.0f, 0.0f, -1.0f, 0.0f, 10.0f, hit));
+    CHECK_EQ(hit.blockY, BASE_Y);
+    CHECK_EQ(hit.faceY, 1);
+    CHECK(std::fabs(hit.distance - 5.5f) < 1e-4f);
+
+    // Starting under water doesn't select the water the camera is in
+    REQUIRE(raycastBlocks(pond.world.chunkManager(), 5.0f, BASE_Y + 2.0f, -5.0f, 0.0f, -1.0f, 0.0f, 10.0f, hit));
+    CHECK_EQ(hit.blockY, BASE_Y);
+    CHECK(std::fabs(hit.distance - 1.5f) < 1e-4f);
+
+    // Out of reach: nothing but water and air
+    CHECK(!raycastBlocks(pond.world.chunkManager(), 5.0f, BASE_Y + 6.0f, -5.0f, 0.0f, -1.0f, 0.0f, 4.0f, hit));
+}
+
+TEST_CASE(BlockRaycast, StopsOnPlantsAndGlass) {
+    PondWorld pond;
+    pond.world.setBlock(5, BASE_Y + 5, 5, BlockType::TALL_GRASS);
+    pond.world.setBlock(8, BASE_Y + 1, 5, BlockType::GLASS);
+
+    BlockRaycastHit hit;
+    REQUIRE(raycastBlocks(pond.world.chunkManager(), 5.0f, BASE_Y + 8.0f, -5.0f, 0.0f, -1.0f, 0.0f, 10.0f, hit));
+    CHECK_EQ(hit.blockY, BASE_Y + 5);
+
+    REQUIRE(raycastBlocks(pond.world.chunkManager(), 2.0f, BASE_Y + 1.0f, -5.0f, 1.0f, 0.0f, 0.0f, 10.0f, hit));
+    CHECK_EQ(hit.blockX, 8);
+    CHECK_EQ(hit.faceX, -1);
+}
@@ -0,0 +1,216 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include "BoxCollision.h"
+#include "Player/Camera.h"
+#include "Player/Player.h"
+#include <cmath>
+
+namespace {
+    // Everything is built in the sky over chunk (0, 0)
+    constexpr int BASE_Y = 200;
+
+    bool near(float a, float b) {
+        return std::fabs(a - b) < 1e-4f;
+    }
+
+    // A player-sized box with its feet centered at (x, y, z), render space
+    // (block (bx, by, bz) is centered on x = bx, z = -bz)
+    CollisionBox feetAt(float x, float y, float z) {
+        const float halfWidth = 0.3f;
+        return { x - halfWidth, y, z - halfWidth, x + halfWidth, y + 1.8f, z + halfWidth };
+    }
+
+    // Fresh world with the sky over chunk (0, 0) cleared
+    struct CollisionWorld {
+        TestClientWorld world{ "test_box_collision", 2 };
+
+        CollisionWorld() {
+            REQUIRE(world.isLoaded());
+            world.clearAbove(0, BASE_Y - 4, 0, CHUNK_SIZE_X - 1, CHUNK_SIZE_Z - 1);
+        }
+
+        ChunkManager& chunks() { return world.chunkManager(); }
+    };
+}
+
+TEST_CASE(BoxCollision, LongFallStopsOnTheFloorWithoutTunneling) {
+    CollisionWorld fixture;
+    fixture.world.setBlock(5, BASE_Y, 5, BlockType::STONE);
+
+    // Terminal velocity for a whole second, far more than the one block
+    BoxSweepResult sweep = sweepBox(fixture.chunks(), feetAt(5.0f, BASE_Y + 30.0f, -5.0f), 0.0f, -78.4f, 0.0f);
+    CHECK(near(sweep.moveY, -29.0f));
+    CHECK(sweep.blockedY);
+    CHECK(!sweep.blockedX && !sweep.blockedZ);
+}
+
+// Overlapping a block's corner by a sliver is enough to stand on it;
+// merely touching its edge is not
+TEST_CASE(BoxCollision, CornerOverlapLandsAndEdgeContactFalls) {
+    CollisionWorld fixture;
+    fixture.world.setBlock(5, BASE_Y, 5, BlockType::STONE);
+
+    BoxSweepResult corner = sweepBox(fixture.chunks(), feetAt(5.75f, BASE_Y + 2.0f, -5.75f), 0.0f, -3.0f, 0.0f);
+    CHECK(near(corner.moveY, -1.0f));
+    CHECK(corner.blockedY);
+
+    BoxSweepResult edge = sweepBox(fixture.chunks(), feetAt(5.8f, BASE_Y + 2.0f, -5.0f), 0.0f, -3.0f, 0.0f);
+    CHECK(near(edge.moveY, -3.0f));
+    CHECK(!edge.blockedY);
+
+    BoxSweepResult diagonal = sweepBox(fixture.chunks(), feetAt(5.8f, BASE_Y + 2.0f, -5.8f), 0.0f, -3.0f, 0.0f);
+    CHECK(!diagonal.blockedY);
+}
+
+// A box resting exactly on a row of blocks slides across the seams
+// between them, and the small downward push every grounded tick applies
+// is absorbed without moving it
+TEST_CASE(BoxCollision, RestingBoxSlidesAcrossFloorSeams) {
+    CollisionWorld fixture;
+    for (int x = 3; x <= 9; x++) {
+        fixture.world.setBlock(x, BASE_Y, 5, BlockType::STONE);
+    }
+
+    BoxSweepResult sweep = sweepBox(fixture.chunks(), feetAt(4.0f, BASE_Y + 1.0f, -5.0f), 4.0f, -0.08f / 60.0f, 0.0f);
+    CHECK(near(sweep.moveX, 4.0f));
+    CHECK(!sweep.blockedX);
+    CHECK_EQ(sweep.moveY, 0.0f);
+    CHECK(sweep.blockedY);
+}
+
+TEST_CASE(BoxCollision, WallStopsAtExactContact) {
+    CollisionWorld fixture;
+    fixture.world.setBlock(9, BASE_Y + 1, 5, BlockType::STONE);
+    fixture.world.setBlock(9, BASE_Y + 2, 5, BlockType::STONE);
+
+    BoxSweepResult sweep = sweepBox(fixture.chunks(), feetAt(7.0f, BASE_Y + 1.0f, -5.0f), 5.0f, 0.0f, 0.0f);
+    CHECK(near(sweep.moveX, 8.5f - 7.3f));
+    CHECK(sweep.blockedX);
+
+    // Already touching: no further movement, and moving away is free
+    BoxSweepResult again = sweepBox(fixture.chunks(), feetAt(8.2f, BASE_Y + 1.0f, -5.0f), 1.0f, 0.0f, 0.0f);
+    CHECK_EQ(again.moveX, 0.0f);
+    CHECK(again.blockedX);
+
+    BoxSweepResult away = sweepBox(fixture.chunks(), feetAt(8.2f, BASE_Y + 1.0f, -5.0f), -1.0f, 0.0f, 0.0f);
+    CHECK(near(away.moveX, -1.0f));
+    CHECK(!away.blockedX);
+}
+
+// Moving diagonally past an outside corner: X goes first and clears the
+// pillar, then Z runs into its side
+TEST_CASE(BoxCollision, OutsideCornerResolvesXThenZ) {
+    CollisionWorld fixture;
+    fixture.world.setBlock(10, BASE_Y + 1, 10, BlockType::STONE);
+    fixture.world.setBlock(10, BASE_Y + 2, 10, BlockType::STONE);
+
+    BoxSweepResult sweep = sweepBox(fixture.chunks(), feetAt(9.0f, BASE_Y + 1.0f, -9.0f), 1.0f, 0.0f, -1.0f);
+    CHECK(near(sweep.moveX, 1.0f));
+    CHECK(!sweep.blockedX);
+    CHECK(near(sweep.moveZ, -0.2f));
+    CHECK(sweep.blockedZ);
+}
+
+TEST_CASE(BoxCollision, InsideCornerBlocksBothAxes) {
+    CollisionWorld fixture;
+    for (int i = 10; i <= 13; i++) {
+        fixture.world.setBlock(13, BASE_Y + 1, i, BlockType::STONE);
+        fixture.world.setBlock(i, BASE_Y + 1, 13, BlockType::STONE);
+    }
+
+    BoxSweepResult sweep = sweepBox(fixture.chunks(), feetAt(12.0f, BASE_Y + 1.0f, -12.0f), 1.0f, 0.0f, -1.0f);
+    CHECK(near(sweep.moveX, 0.2f));
+    CHECK(near(sweep.moveZ, -0.2f));
+    CHECK(sweep.blockedX && sweep.blockedZ);
+}
+
+// Blocks the box already overlaps are ignored, so it can leave them
+TEST_CASE(BoxCollision, OverlappedBlocksDoNotTrapTheBox) {
+    CollisionWorld fixture;
+    fixture.world.setBlock(5, BASE_Y + 1, 5, BlockType::STONE);
+
+    BoxSweepResult sweep = sweepBox(fixture.chunks(), feetAt(5.0f, BASE_Y + 1.5f, -5.0f), 2.0f, 1.0f, 0.0f);
+    CHECK(near(sweep.moveX, 2.0f));
+    CHECK(near(sweep.moveY, 1.0f));
+    CHECK(!sweep.blockedX && !sweep.blockedY);
+}
+
+// Unloaded chunks read as air, but the sweep says so
+TEST_CASE(BoxCollision, SweepIntoUnloadedChunkIsReported) {
+    CollisionWorld fixture;
+    int edgeChunk = 0;
+    while (fixture.chunks().isChunkLoaded(edgeChunk + 1, 0)) edgeChunk++;
+    float edgeX = static_cast<float>((edgeChunk + 1) * CHUNK_SIZE_X - 1);  // Last loaded block column
+
+    BoxSweepResult inside = sweepBox(fixture.chunks(), feetAt(edgeX, BASE_Y + 10.0f, -8.0f), -2.0f, -5.0f, 0.0f);
+    CHECK(!inside.touchedUnloaded);
+
+    BoxSweepResult across = sweepBox(fixture.chunks(), feetAt(edgeX, BASE_Y + 10.0f, -8.0f), 2.0f, 0.0f, 0.0f);
+    CHECK(across.touchedUnloaded);
+    CHECK(near(across.moveX, 2.0f));
+    CHECK(!across.blockedX);
+}
+
+// =============================
+// Step-ups
+// =============================
+// There is no automatic step-up: a one-block step is a wall for a box on
+// the floor below it, and a floor for one level with its top
+TEST_CASE(BoxCollision, OneBlockStepIsAWallUntilLevelWithItsTop) {
+    CollisionWorld fixture;
+    for (int x = 2; x <= 9; x++) {
+        fixture.world.setBlock(x, BASE_Y, 8, BlockType::STONE);
+    }
+    fixture.world.setBlock(6, BASE_Y + 1, 8, BlockType::STONE);
+
+    BoxSweepResult below = sweepBox(fixture.chunks(), feetAt(4.0f, BASE_Y + 1.0f, -8.0f), 3.0f, 0.0f, 0.0f);
+    CHECK(near(below.moveX, 5.5f - 4.3f));
+    CHECK(below.blockedX);
+
+    BoxSweepResult sliver = sweepBox(fixture.chunks(), feetAt(4.0f, BASE_Y + 1.999f, -8.0f), 3.0f, 0.0f, 0.0f);
+    CHECK(sliver.blockedX);
+
+    BoxSweepResult level = sweepBox(fixture.chunks(), feetAt(4.0f, BASE_Y + 2.0f, -8.0f), 3.0f, 0.0f, 0.0f);
+    CHECK(near(level.moveX, 3.0f));
+    CHECK(!level.blockedX);
+}
+
+// A walking player stops at the step, and gets onto it by jumping
+TEST_CASE(BoxCollision, PlayerJumpsOntoAStep) {
+    CollisionWorld fixture;
+    for (int x = 1; x <= 12; x++) {
+        fixture.world.setBlock(x, BASE_Y, 8, BlockType::STONE);
+    }
+    for (int x = 6; x <= 12; x++) {
+        fixture.world.setBlock(x, BASE_Y + 1, 8, BlockType::STONE);
+    }
+
+    Camera camera(0.0f, 0.0f, 0.0f);
+    camera.frontX = 1.0f;
+    camera.frontY = 0.0f;
+    camera.frontZ = 0.0f;
+    camera.rightX = 0.0f;
+    camera.rightY = 0.0f;
+    camera.rightZ = 1.0f;
+
+    Player player(3.0f, BASE_Y + 1.0f, -8.0f);
+    player.setGameMode(GameMode::SURVIVAL);
+
+    const float TICK = 1.0f / 60.0f;
+    for (int tick = 0; tick < 60; tick++) {
+        player.processInput(1.0f, 0.0f, 0.0f, false, false, camera);
+        player.update(TICK, &fixture.chunks());
+    }
+    CHECK(near(player.x, 5.5f - player.width / 2.0f));
+    CHECK(near(player.y, BASE_Y + 1.0f));
+    CHECK(player.isOnGround);
+
+    // One jump, then keep walking until well after landing
+    for (int tick = 0; tick < 60; tick++) {
+        player.processInput(1.0f, 0.0f, 0.0f, tick == 0, false, camera);
+        player.update(TICK, &fixture.chunks());
+    }
+    CHECK(near(player.y, BASE_Y + 2.0f));
+    CHECK(player.x > 6.0f);
+    CHECK(player.isOnGround);
+}
@@ -0,0 +1,112 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include <iterator>
+#include <map>
+#include <optional>
+
+namespace {
+    constexpr int WORLD_RADIUS = 3;
+
+    // Saved edits replayed by the workers before a chunk is lit, so border
+    // light has something to carry: a stone roof over the corner of four
+    // chunks (its shadow and the sky light creeping under it cross every
+    // border) and colored emitters right next to chunk borders
+    void seedEdits(TestWorld& world) {
+        WorldSave& save = world.pipeline().getWorldSave();
+        for (int x = 6; x < 26; x++) {
+            for (int z = 6; z < 26; z++) {
+                save.saveBlockChange(x, 180, z, BlockType::STONE);
+            }
+        }
+
+        save.saveBlockChange(15, 175, 16, BlockType::BLOCKOFPUREREDLIGHT);
+        save.saveBlockChange(16, 170, 15, BlockType::BLOCKOFPUREBLUELIGHT);
+        save.saveBlockChange(-1, 200, 0, BlockType::BLOCKOFPUREGREENLIGHT);
+        save.saveBlockChange(-16, 160, -17, BlockType::BLOCKOFPUREWHITELIGHT);
+        save.saveBlockChange(31, 150, -1, BlockType::BLOCKOFPUREREDLIGHT);
+    }
+
+    bool sameMesh(const Chunk& a, const Chunk& b) {
+        std::map<BlockType, ChunkMeshBuffers> meshA;
+        std::map<BlockType, ChunkMeshBuffers> meshB;
+        a.buildMeshData(meshA);
+        b.buildMeshData(meshB);
+
+        if (meshA.size() != meshB.size()) return false;
+        for (auto itA = meshA.begin(), itB = meshB.begin(); itA != meshA.end(); ++itA, ++itB) {
+            if (itA->first != itB->first || itA->second.vertices != itB->second.vertices ||
+                itA->second.indices != itB->second.indices) return false;
+        }
+        return true;
+    }
+
+    // Same chunks in the same states, with the same blocks and light, and
+    // the same mesh built from every NeighborsReady chunk's neighborhood
+    void checkSameWorld(TestWorld& world, TestWorld& reference) {
+        const auto& chunks = world.pipeline().getChunks();
+        CHECK_EQ(chunks.size(), reference.pipeline().getChunks().size());
+
+        size_t stateMismatches = 0;
+        size_t meshMismatches = 0;
+        for (const auto& [_, chunk] : chunks) {
+            const Chunk* expected = reference.pipeline().findChunk(chunk->chunkX, chunk->chunkZ);
+            REQUIRE(expected != nullptr);
+
+            if (chunk->state != expected->state) stateMismatches++;
+            else if (chunk->state == ChunkState::NeighborsReady && !sameMesh(*chunk, *expected)) meshMismatches++;
+        }
+
+        TestWorld::ChunkMap expectedLight = reference.copy();
+        CHECK_EQ(stateMismatches, 0u);
+        CHECK_EQ(world.countSkyLightMismatches(expectedLight), 0u);
+        CHECK_EQ(world.countBlockLightMismatches(expectedLight), 0u);
+        CHECK_EQ(meshMismatches, 0u);
+    }
+}
+
+// Border light only ever adds and runs once per chunk when its 3x3
+// neighborhood completes, so the order chunks finish in must not matter
+TEST_CASE(ChunkPipeline, ShuffledLoadOrdersAgree) {
+    TestWorld reference("test_pipeline_reference");
+    seedEdits(reference);
+    reference.load(WORLD_RADIUS);
+
+    // The reference itself is what an ordinary load looks like
+    std::optional<Block> emitter = reference.pipeline().getBlock(15, 175, 16);
+    REQUIRE(emitter.has_value());
+    CHECK(emitter->type == BlockType::BLOCKOFPUREREDLIGHT);
+    size_t ready = 0;
+    for (const auto& [_, chunk] : reference.pipeline().getChunks()) {
+        if (chunk->state == ChunkState::NeighborsReady) ready++;
+    }
+    CHECK_EQ(ready, static_cast<size_t>((2 * WORLD_RADIUS - 1) * (2 * WORLD_RADIUS - 1)));
+    CHECK_EQ(reference.countSkyLightMismatches(reference.relitCopy()), 0u);
+
+    for (unsigned int seed = 1; seed <= 4; seed++) {
+        TestWorld world("test_pipeline_shuffled");
+        seedEdits(world);
+        world.load(WORLD_RADIUS, seed);
+        checkSameWorld(world, reference);
+    }
+}
+
+// Unloading chunks and bringing them back from the cache (relit by the
+// workers, in a random order) ends up where loading them once did
+TEST_CASE(ChunkPipeline, CacheRestoreAgreesWithFreshLoad) {
+    TestWorld reference("test_pipeline_reference");
+    seedEdits(reference);
+    reference.load(WORLD_RADIUS);
+
+    TestWorld world("test_pipeline_restored");
+    seedEdits(world);
+    world.load(WORLD_RADIUS, 7);
+
+    const int unloaded[][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { -2, 1 }, { 3, 3 }, { -3, 0 } };
+    for (const auto& chunk : unloaded) {
+        world.unload(chunk[0], chunk[1]);
+    }
+    world.load(WORLD_RADIUS, 11);
+
+    CHECK_EQ(world.pipeline().getStats().restored, std::size(unloaded));
+    checkSameWorld(world, reference);
+}
@@ -0,0 +1,134 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include "Entity/EntityStorage.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    constexpr const char* WORLD_NAME = "test_entity_storage";
+
+    struct Snapshot {
+        Transform transform;
+        bool hasVelocity = false;
+        Velocity velocity;
+        bool hasBody = false;
+        PhysicsBody body;
+    };
+
+    std::vector<Snapshot> snapshot(const EntityWorld& world) {
+        std::vector<Snapshot> entities;
+        for (size_t i = 0; i < world.transforms.size(); i++) {
+            uint32_t index = world.transforms.entityAt(i);
+            Snapshot entity;
+            entity.transform = world.transforms.at(i);
+            if (const Velocity* velocity = world.velocities.get(index)) {
+                entity.hasVelocity = true;
+                entity.velocity = *velocity;
+            }
+            if (const PhysicsBody* body = world.bodies.get(index)) {
+                entity.hasBody = true;
+                entity.body = *body;
+            }
+            entities.push_back(entity);
+        }
+        std::sort(entities.begin(), entities.end(),
+            [](const Snapshot& a, const Snapshot& b) { return a.transform.x < b.transform.x; });
+        return entities;
+    }
+}
+
+// Entities in a chunk that unloads are stored, written out and, from a
+// fresh EntityStorage, recreated with the same components once it reloads
+TEST_CASE(EntityStorage, UnloadedChunkRoundTripsThroughDisk) {
+    TestClientWorld world(WORLD_NAME, 2);
+    REQUIRE(world.isLoaded());
+    ChunkManager& chunks = world.chunkManager();
+
+    // Chunk (0, 0) spans render-space x in [-0.5, 15.5), z in (-15.5, 0.5]
+    EntityWorld entities;
+    std::vector<EntityHandle> handles;
+    for (int i = 0; i < 12; i++) {
+        EntityHandle entity = entities.create();
+        Transform transform;
+        transform.x = 1.0f + i;
+        transform.y = 200.0f + i * 0.25f;
+        transform.z = -2.0f - i;
+        transform.previousX = transform.x - 0.1f;
+        entities.transforms.add(entity.index, transform);
+        if (i % 2 == 0) entities.velocities.add(entity.index, { 0.5f * i, -1.0f, 2.0f });
+        if (i % 3 != 2) {
+            PhysicsBody body;
+            body.halfWidth = 0.25f + i * 0.01f;
+            body.height = 1.0f + i * 0.1f;
+            body.onGround = i % 4 == 0;
+            entities.bodies.add(entity.index, body);
+        }
+        entities.spatial.update(entity.index, transform.x, transform.y, transform.z);
+        handles.push_back(entity);
+    }
+    std::vector<Snapshot> before = snapshot(entities);
+
+    {
+        EntityStorage storage(WORLD_NAME);
+        storage.update(entities, chunks);
+        CHECK_EQ(storage.getStoredEntityCount(), 0u);
+
+        REQUIRE(world.moveTo(16.0f * 12, 0.0f, [&] { return !chunks.isChunkLoaded(0, 0); }));
+        storage.update(entities, chunks);
+
+        CHECK_EQ(storage.getStoredChunkCount(), 1u);
+        CHECK_EQ(storage.getStoredEntityCount(), handles.size());
+        CHECK_EQ(storage.getTotalStored(), handles.size());
+        CHECK_EQ(entities.getAliveCount(), 0u);
+        CHECK_EQ(entities.spatial.size(), 0u);
+        for (const EntityHandle& handle : handles) CHECK(!entities.isAlive(handle));
+
+        storage.flush();
+    }
+
+    EntityWorld restored;
+    EntityStorage storage(WORLD_NAME);
+    CHECK_EQ(storage.getStoredEntityCount(), handles.size());
+
+    // Still unloaded: nothing comes back yet
+    storage.update(restored, chunks);
+    CHECK_EQ(restored.getAliveCount(), 0u);
+
+    REQUIRE(world.moveTo(0.0f, 0.0f, [&] { return chunks.isChunkLoaded(0, 0); }));
+    storage.update(restored, chunks);
+    CHECK_EQ(storage.getStoredEntityCount(), 0u);
+    CHECK_EQ(storage.getTotalRestored(), handles.size());
+    REQUIRE(restored.getAliveCount() == handles.size());
+
+    std::vector<Snapshot> after = snapshot(restored);
+    REQUIRE(after.size() == before.size());
+    for (size_t i = 0; i < after.size(); i++) {
+        const Snapshot& expected = before[i];
+        const Snapshot& actual = after[i];
+        CHECK_EQ(actual.transform.x, expected.transform.x);
+        CHECK_EQ(actual.transform.y, expected.transform.y);
+        CHECK_EQ(actual.transform.z, expected.transform.z);
+        CHECK_EQ(actual.transform.previousX, expected.transform.x);
+        CHECK_EQ(actual.transform.previousY, expected.transform.y);
+        CHECK_EQ(actual.transform.previousZ, expected.transform.z);
+
+        REQUIRE(actual.hasVelocity == expected.hasVelocity);
+        if (expected.hasVelocity) {
+            CHECK_EQ(actual.velocity.x, expected.velocity.x);
+            CHECK_EQ(actual.velocity.y, expected.velocity.y);
+            CHECK_EQ(actual.velocity.z, expected.velocity.z);
+        }
+
+        REQUIRE(actual.hasBody == expected.hasBody);
+        if (expected.hasBody) {
+            CHECK_EQ(actual.body.halfWidth, expected.body.halfWidth);
+            CHECK_EQ(actual.body.height, expected.body.height);
+            CHECK_EQ(actual.body.onGround, expected.body.onGround);
+        }
+    }
+
+    // Restored entities are indexed for the next unload
+    std::vector<uint32_t> inChunk;
+    restored.spatial.queryChunk(0, 0, inChunk);
+    CHECK_EQ(inChunk.size(), handles.size());
+}
@@ -0,0 +1,182 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include "FixedTimestep.h"
+#include "Player/Camera.h"
+#include "Player/Player.h"
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr int TICK_RATE = 60;
+    constexpr int MAX_TICKS_PER_FRAME = 5;
+
+    // Everything the simulation carries from one tick to the next
+    struct ReplayState {
+        float x, y, z;
+        float velocityX, velocityY, velocityZ;
+        bool isOnGround;
+        float yaw, pitch;
+
+        bool operator==(const ReplayState& other) const {
+            return x == other.x && y == other.y && z == other.z &&
+                velocityX == other.velocityX && velocityY == other.velocityY && velocityZ == other.velocityZ &&
+                isOnGround == other.isOnGround && yaw == other.yaw && pitch == other.pitch;
+        }
+    };
+
+    ReplayState captureState(const Player& player, const Camera& camera) {
+        return { player.x, player.y, player.z, player.velocityX, player.velocityY, player.velocityZ,
+            player.isOnGround, camera.yaw, camera.pitch };
+    }
+
+    // One simulation tick: the input is a function of the tick index only
+    using TickScript = std::function<void(unsigned long long tick, float tickSeconds, Player&, Camera&)>;
+
+    // Drives the script the way main.cpp does: frames of the given
+    // lengths (repeated) feed FixedTimestep, which decides how many ticks
+    // each one runs. Stops after exactly tickCount ticks.
+    ReplayState replay(const std::vector<float>& frameSeconds, unsigned long long tickCount, Player player,
+        const TickScript& script) {
+        Camera camera(player.x, player.y, player.z);
+        FixedTimestep clock(TICK_RATE, MAX_TICKS_PER_FRAME);
+
+        unsigned long long tick = 0;
+        for (size_t frame = 0; tick < tickCount; frame++) {
+            int ticks = clock.advance(frameSeconds[frame % frameSeconds.size()]);
+            for (int i = 0; i < ticks && tick < tickCount; i++, tick++) {
+                script(tick, clock.getTickSeconds(), player, camera);
+            }
+        }
+        return captureState(player, camera);
+    }
+
+    // 60 Hz and 144 Hz displays, and an uneven frame rate with hitches
+    // long enough to hit the catch-up limit
+    std::vector<std::vector<float>> frameSequences() {
+        std::vector<float> jittery;
+        std::mt19937 random(44);
+        std::uniform_real_distribution<float> frame(1.0f / 240.0f, 1.0f / 20.0f);
+        for (int i = 0; i < 500; i++) {
+            jittery.push_back(i % 97 == 0 ? 0.25f : frame(random));
+        }
+        return { { 1.0f / 60.0f }, { 1.0f / 144.0f }, jittery };
+    }
+}
+
+// =============================
+// Clock
+// =============================
+TEST_CASE(FixedTimestep, TicksFollowAccumulatedTime) {
+    FixedTimestep clock(TICK_RATE, MAX_TICKS_PER_FRAME);
+
+    // Short frames carry over until they add up to a tick
+    CHECK_EQ(clock.advance(0.01f), 0);
+    CHECK_EQ(clock.advance(0.01f), 1);
+    CHECK(clock.getAlpha() >= 0.0f && clock.getAlpha() < 1.0f);
+
+    int ticks = 0;
+    for (int i = 0; i < 144; i++) {
+        ticks += clock.advance(1.0f / 144.0f);
+    }
+    CHECK(ticks == 59 || ticks == 60);
+
+    // Negative frame times (clock adjustments) are ignored
+    unsigned long long before = clock.getTickCount();
+    CHECK_EQ(clock.advance(-1.0f), 0);
+    CHECK_EQ(clock.getTickCount(), before);
+}
+
+TEST_CASE(FixedTimestep, LongFrameIsCappedAndTheRestDropped) {
+    FixedTimestep clock(TICK_RATE, MAX_TICKS_PER_FRAME);
+
+    CHECK_EQ(clock.advance(1.0f), MAX_TICKS_PER_FRAME);
+    CHECK(std::fabs(clock.getDroppedSeconds() - (1.0f - MAX_TICKS_PER_FRAME / 60.0f)) < 1e-4f);
+
+    // Nothing left over to catch up on
+    CHECK_EQ(clock.advance(0.0f), 0);
+    CHECK(clock.getAlpha() < 1e-4f);
+}
+
+// =============================
+// Replays
+// =============================
+// The scripted fly-through (as in main.cpp's --flythrough): spectator
+// flight with a 90 degree turn every 10 seconds
+TEST_CASE(FixedTimestep, FlyThroughReplayIsIndependentOfFrameRate) {
+    TickScript flyThrough = [](unsigned long long tick, float tickSeconds, Player& player, Camera& camera) {
+        float elapsed = (tick + 1) * tickSeconds;
+        if (std::fmod(elapsed, 10.0f) < 1.0f) {
+            camera.processMouseMovement(-90.0f * tickSeconds / camera.sensitivity, 0.0f);
+        }
+        player.velocityX = camera.frontX * 40.0f;
+        player.velocityY = 0.0f;
+        player.velocityZ = camera.frontZ * 40.0f;
+        player.update(tickSeconds, nullptr);
+    };
+
+    Player start(0.0f, 120.0f, 0.0f);
+    const unsigned long long TICKS = 60 * TICK_RATE;
+
+    ReplayState first = replay({ 1.0f / 60.0f }, TICKS, start, flyThrough);
+    CHECK(replay({ 1.0f / 60.0f }, TICKS, start, flyThrough) == first);
+    for (const std::vector<float>& frames : frameSequences()) {
+        CHECK(replay(frames, TICKS, start, flyThrough) == first);
+    }
+
+    // And it really went somewhere
+    CHECK(std::fabs(first.x) + std::fabs(first.z) > 100.0f);
+}
+
+// Walking, sprinting, jumping and turning around a walled pen with steps,
+// so collisions, step-ups and landings all feed back into the state; the
+// same input must end in the same place bit for bit
+TEST_CASE(FixedTimestep, SurvivalReplayIsDeterministic) {
+    const int BASE_Y = 200;
+    TestClientWorld world("test_replay", 2);
+    REQUIRE(world.isLoaded());
+
+    world.clearAbove(0, BASE_Y - 4, 0, CHUNK_SIZE_X - 1, CHUNK_SIZE_Z - 1);
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            world.setBlock(x, BASE_Y, z, BlockType::STONE);
+
+            bool edge = x == 0 || z == 0 || x == CHUNK_SIZE_X - 1 || z == CHUNK_SIZE_Z - 1;
+            if (edge) {
+                world.setBlock(x, BASE_Y + 1, z, BlockType::STONE);
+                world.setBlock(x, BASE_Y + 2, z, BlockType::STONE);
+            }
+            else if ((x * 7 + z * 3) % 11 == 0) {
+                world.setBlock(x, BASE_Y + 1, z, BlockType::STONE);
+            }
+        }
+    }
+
+    TickScript walk = [&world](unsigned long long tick, float tickSeconds, Player& player, Camera& camera) {
+        if (tick % 200 < 20) camera.processMouseMovement(30.0f, 0.0f);
+
+        float front = (tick / 90) % 3 == 2 ? -1.0f : 1.0f;
+        float right = (tick / 45) % 2 ? 0.5f : 0.0f;
+        bool jump = tick % 70 == 0;
+        bool sprint = (tick / 120) % 2 == 1;
+        player.processInput(front, right, 0.0f, jump, sprint, camera);
+        player.update(tickSeconds, &world.chunkManager());
+    };
+
+    Player start(8.0f, BASE_Y + 1.0f, -8.0f);
+    start.setGameMode(GameMode::SURVIVAL);
+    const unsigned long long TICKS = 20 * TICK_RATE;
+
+    ReplayState first = replay({ 1.0f / 60.0f }, TICKS, start, walk);
+    CHECK(replay({ 1.0f / 60.0f }, TICKS, start, walk) == first);
+    for (const std::vector<float>& frames : frameSequences()) {
+        CHECK(replay(frames, TICKS, start, walk) == first);
+    }
+
+    // Still inside the pen, on the floor or a step, and not where it started
+    CHECK(first.y >= BASE_Y + 1.0f);
+    CHECK(first.x > 0.0f && first.x < CHUNK_SIZE_X - 1.0f);
+    CHECK(-first.z > 0.0f && -first.z < CHUNK_SIZE_Z - 1.0f);
+    CHECK(std::fabs(first.x - 8.0f) + std::fabs(first.z + 8.0f) > 1.0f);
+}
@@ -0,0 +1,69 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include "FluidSimulation.h"
+
+namespace {
+    constexpr int BASE_Y = 200;
+
+    bool isWater(ChunkManager& chunkManager, int x, int y, int z) {
+        std::optional<Block> block = chunkManager.getBlockAt(x, y, z);
+        return block && block->type == BlockType::WATER;
+    }
+}
+
+// A source placed just before its chunk unloads has its ticks dropped
+// with the chunk; once the chunk is back it must still flow
+TEST_CASE(FluidTicks, FluidUnloadedMidFlowResumesWhenReloaded) {
+    TestClientWorld world("test_fluid_ticks", 2);
+    REQUIRE(world.isLoaded());
+    ChunkManager& chunks = world.chunkManager();
+
+    world.clearAbove(0, BASE_Y - 4, 0, CHUNK_SIZE_X - 1, CHUNK_SIZE_Z - 1);
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            world.setBlock(x, BASE_Y, z, BlockType::STONE);
+        }
+    }
+    world.setBlock(8, BASE_Y + 1, 8, BlockType::WATER);
+    CHECK(chunks.getBlockTicks().getPendingCount() > 0);
+
+    // Far enough that chunk (0, 0) unloads, then back
+    REQUIRE(world.moveTo(16.0f * 12, 0.0f, [&] { return !chunks.isChunkLoaded(0, 0); }));
+    CHECK_EQ(chunks.getBlockTicks().getPendingCount(), 0u);
+    REQUIRE(world.moveTo(0.0f, 0.0f, [&] { return chunks.isChunkLoaded(0, 0); }));
+
+    CHECK(isWater(chunks, 8, BASE_Y + 1, 8));
+    CHECK(!isWater(chunks, 9, BASE_Y + 1, 8));
+    CHECK(chunks.getBlockTicks().getPendingCount() > 0);
+
+    FluidSimulation simulation(1);
+    for (int tick = 0; tick < 200 && chunks.getBlockTicks().getPendingCount() > 0; tick++) {
+        simulation.update(chunks);
+    }
+
+    CHECK(isWater(chunks, 9, BASE_Y + 1, 8));
+    CHECK(isWater(chunks, 8, BASE_Y + 1, 4));
+    CHECK_EQ(chunks.getBlockTicks().getPendingCount(), 0u);
+}
+
+// Settled fluid is left alone: a source boxed in by stone gets no tick
+TEST_CASE(FluidTicks, SettledSourceIsNotRescheduled) {
+    TestClientWorld world("test_fluid_ticks", 2);
+    REQUIRE(world.isLoaded());
+    ChunkManager& chunks = world.chunkManager();
+
+    world.clearAbove(0, BASE_Y - 4, 0, CHUNK_SIZE_X - 1, CHUNK_SIZE_Z - 1);
+    for (int x = 7; x <= 9; x++) {
+        for (int z = 7; z <= 9; z++) {
+            world.setBlock(x, BASE_Y, z, BlockType::STONE);
+            if (x != 8 || z != 8) world.setBlock(x, BASE_Y + 1, z, BlockType::STONE);
+        }
+    }
+    world.setBlock(8, BASE_Y + 1, 8, BlockType::WATER);
+
+    REQUIRE(world.moveTo(16.0f * 12, 0.0f, [&] { return !chunks.isChunkLoaded(0, 0); }));
+    REQUIRE(world.moveTo(0.0f, 0.0f, [&] { return chunks.isChunkLoaded(0, 0); }));
+
+    CHECK(isWater(chunks, 8, BASE_Y + 1, 8));
+    CHECK_EQ(chunks.getBlockTicks().getPendingCount(), 0u);
+}
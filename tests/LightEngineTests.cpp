@@ -0,0 +1,83 @@
+#include "TestHarness.h"
+#include "TestWorld.h"
+#include <random>
+
+namespace {
+    // Edits stay inside chunks 0..1 on both axes: light changes reach at
+    // most 15 blocks from an edit, so with radius 3 they never get near
+    // the outer ring, whose shared faces the pipeline never exchanges
+    constexpr int WORLD_RADIUS = 3;
+    constexpr int EDIT_MIN = 0;
+    constexpr int EDIT_MAX = 2 * CHUNK_SIZE_X - 1;
+
+    struct EditMix {
+        BlockType types[4];
+        int count;
+    };
+
+    // Applies edits through the pipeline (incremental relighting) and
+    // compares everything with a full recompute every checkEvery edits
+    void runRandomEdits(TestWorld& world, unsigned int seed, int editCount, int checkEvery, const EditMix& mix,
+        bool compareBlockLight) {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> coordinate(EDIT_MIN, EDIT_MAX);
+        std::uniform_int_distribution<int> height(-6, 8);
+        std::uniform_int_distribution<int> pick(0, mix.count - 1);
+
+        std::unordered_set<Chunk*> relit;
+        for (int edit = 1; edit <= editCount; edit++) {
+            int x = coordinate(random);
+            int z = coordinate(random);
+            int y = world.surfaceHeight(x, z) + height(random);
+            BlockType type = mix.types[pick(random)];
+
+            relit.clear();
+            world.pipeline().setBlock(x, y, z, type, FLUID_SOURCE, relit);
+
+            if (edit % checkEvery != 0 && edit != editCount) continue;
+
+            TestWorld::ChunkMap reference = world.relitCopy();
+            size_t skyMismatches = world.countSkyLightMismatches(reference);
+            size_t blockMismatches = compareBlockLight ? world.countBlockLightMismatches(reference) : 0;
+            CHECK_EQ(skyMismatches, 0u);
+            CHECK_EQ(blockMismatches, 0u);
+
+            // Later edits would only pile onto the first divergence
+            if (skyMismatches != 0 || blockMismatches != 0) return;
+        }
+    }
+}
+
+TEST_CASE(LightEngine, LoadedWorldMatchesFullRecompute) {
+    TestWorld world("test_light_loaded");
+    world.load(WORLD_RADIUS);
+
+    TestWorld::ChunkMap reference = world.relitCopy();
+    CHECK_EQ(world.countSkyLightMismatches(reference), 0u);
+    CHECK_EQ(world.countBlockLightMismatches(reference), 0u);
+}
+
+// Stone and glass placed around the surface build overhangs, shafts and
+// pockets; breaking blocks opens caves to the sky and closes them again
+TEST_CASE(LightEngine, IncrementalSkyLightMatchesFullRecompute) {
+    TestWorld world("test_light_sky");
+    world.load(WORLD_RADIUS);
+
+    EditMix mix = { { BlockType::STONE, BlockType::STONE, BlockType::AIR, BlockType::GLASS }, 4 };
+    runRandomEdits(world, 31, 400, 25, mix, false);
+}
+
+// Colored emitters placed, overlapped, walled in and broken again; every
+// channel has to darken and refill on its own
+TEST_CASE(LightEngine, IncrementalBlockLightMatchesFullRecompute) {
+    TestWorld world("test_light_block");
+    world.load(WORLD_RADIUS);
+
+    EditMix mix = { { BlockType::BLOCKOFPUREREDLIGHT, BlockType::BLOCKOFPUREGREENLIGHT,
+        BlockType::BLOCKOFPUREBLUELIGHT, BlockType::BLOCKOFPUREWHITELIGHT }, 4 };
+    runRandomEdits(world, 33, 150, 25, mix, true);
+
+    // Then mostly take them away again, with stone shutting light in
+    EditMix removal = { { BlockType::AIR, BlockType::AIR, BlockType::STONE, BlockType::BLOCKOFPUREREDLIGHT }, 4 };
+    runRandomEdits(world, 34, 300, 25, removal, true);
+}
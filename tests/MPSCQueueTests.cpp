@@ -0,0 +1,99 @@
+#include "TestHarness.h"
+#include "MPSCQueue.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST_CASE(MPSCQueue, RoundsCapacityUpAndRejectsWhenFull) {
+    MPSCQueue<int> queue(5);
+    CHECK_EQ(queue.capacity(), 8u);
+    CHECK(queue.empty());
+
+    for (int i = 0; i < 8; i++) {
+        CHECK(queue.push(i));
+    }
+    CHECK(!queue.push(8));
+
+    int value = -1;
+    REQUIRE(queue.pop(value));
+    CHECK_EQ(value, 0);
+    CHECK(queue.push(8));  // The freed cell is reused on the next lap
+}
+
+TEST_CASE(MPSCQueue, SingleThreadFifoAcrossManyLaps) {
+    MPSCQueue<int> queue(4);
+    int next = 0;
+    int expected = 0;
+
+    // Uneven batches so the positions drift relative to the ring size
+    for (int round = 0; round < 1000; round++) {
+        int batch = 1 + round % 4;
+        for (int i = 0; i < batch; i++) {
+            REQUIRE(queue.push(next++));
+        }
+        int value = -1;
+        for (int i = 0; i < batch; i++) {
+            REQUIRE(queue.pop(value));
+            CHECK_EQ(value, expected++);
+        }
+        CHECK(queue.empty());
+    }
+
+    int value = -1;
+    CHECK(!queue.pop(value));
+}
+
+// Producers outnumber the cells by far, so pushes keep failing on a full
+// ring and retrying while the consumer drains it. Every value must arrive
+// exactly once, and each producer's values in the order it pushed them.
+// Build with MINECRAFT_SANITIZE_THREAD to check the memory ordering too.
+TEST_CASE(MPSCQueue, MultiProducerStress) {
+    constexpr int PRODUCERS = 4;
+    constexpr uint32_t PER_PRODUCER = 100000;
+
+    MPSCQueue<uint64_t> queue(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&queue, p] {
+            for (uint32_t i = 0; i < PER_PRODUCER; i++) {
+                uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                while (!queue.push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> nextExpected(PRODUCERS, 0);
+    uint64_t received = 0;
+    bool ordered = true;
+    while (received < static_cast<uint64_t>(PRODUCERS) * PER_PRODUCER) {
+        uint64_t value = 0;
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Keep draining after a mismatch so the producers can finish
+        size_t producer = static_cast<size_t>(value >> 32);
+        uint32_t sequence = static_cast<uint32_t>(value);
+        if (producer < nextExpected.size()) {
+            if (sequence != nextExpected[producer]) ordered = false;
+            nextExpected[producer] = sequence + 1;
+        }
+        else {
+            ordered = false;
+        }
+        received++;
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    CHECK(ordered);
+    for (int p = 0; p < PRODUCERS; p++) {
+        CHECK_EQ(nextExpected[p], PER_PRODUCER);
+    }
+    CHECK(queue.empty());
+}
@@ -0,0 +1,198 @@
+#include "TestHarness.h"
+#include "MeshLighting.h"
+#include "Chunk.h"
+#include <cmath>
+#include <map>
+#include <memory>
+
+namespace {
+    Block air(unsigned char skyLight, unsigned short blockLight = 0) {
+        Block block(BlockType::AIR);
+        block.skyLight = skyLight;
+        block.blockLight = blockLight;
+        return block;
+    }
+
+    const Block STONE(BlockType::STONE);
+
+    bool near(float a, float b) {
+        return std::fabs(a - b) < 1e-5f;
+    }
+
+    VertexLight uniform(float level, float ao) {
+        return { level, 0.0f, 0.0f, 0.0f, ao };
+    }
+
+    // Empty chunks -1..1 on both axes, linked like the pipeline links them
+    struct ChunkGrid {
+        std::unique_ptr<Chunk> chunks[3][3];
+
+        ChunkGrid() {
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    chunks[i][j] = std::make_unique<Chunk>(i - 1, j - 1);
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    for (int n = 0; n < NEIGHBOR_COUNT; n++) {
+                        int ni = i + NEIGHBOR_DX[n];
+                        int nj = j + NEIGHBOR_DZ[n];
+                        if (ni >= 0 && ni < 3 && nj >= 0 && nj < 3) chunks[i][j]->setNeighbor(n, chunks[ni][nj].get());
+                    }
+                }
+            }
+        }
+
+        void setBlock(int worldX, int worldY, int worldZ, BlockType type) {
+            int cx = worldX < 0 ? -1 : worldX / CHUNK_SIZE_X;
+            int cz = worldZ < 0 ? -1 : worldZ / CHUNK_SIZE_Z;
+            chunks[cx + 1][cz + 1]->setBlock(worldX - cx * CHUNK_SIZE_X, worldY, worldZ - cz * CHUNK_SIZE_Z, type);
+        }
+
+        Chunk& center() { return *chunks[1][1]; }
+    };
+
+    // AO of the first up-facing vertex at mesh position (x, y, z); -1 if none
+    float upVertexAO(const ChunkMeshBuffers& mesh, float x, float y, float z) {
+        for (size_t v = 0; v + CHUNK_VERTEX_FLOATS <= mesh.vertices.size(); v += CHUNK_VERTEX_FLOATS) {
+            const float* vertex = &mesh.vertices[v];
+            if (vertex[0] == x && vertex[1] == y && vertex[2] == z && vertex[6] == 1.0f) return vertex[12];
+        }
+        return -1.0f;
+    }
+}
+
+// =============================
+// Ambient occlusion
+// =============================
+TEST_CASE(MeshLighting, AOLevels) {
+    CHECK_EQ(vertexAO(false, false, false), 3);
+    CHECK_EQ(vertexAO(false, false, true), 2);
+    CHECK_EQ(vertexAO(true, false, false), 2);
+    CHECK_EQ(vertexAO(false, true, false), 2);
+    CHECK_EQ(vertexAO(true, false, true), 1);
+    CHECK_EQ(vertexAO(false, true, true), 1);
+
+    // Both sides: fully occluded whatever the corner is
+    CHECK_EQ(vertexAO(true, true, false), 0);
+    CHECK_EQ(vertexAO(true, true, true), 0);
+}
+
+// =============================
+// Smooth light
+// =============================
+TEST_CASE(MeshLighting, OpenVertexAveragesAllFourSamples) {
+    VertexLight light = computeVertexLight(air(15), air(14), air(13), air(12));
+    CHECK(near(light.sky, 54.0f / 60.0f));
+    CHECK(near(light.ao, AO_CURVE[3]));
+}
+
+// An opaque corner darkens the vertex (AO) but is left out of the average
+// instead of pulling it towards 0
+TEST_CASE(MeshLighting, OpaqueCornerIsNotAveraged) {
+    VertexLight light = computeVertexLight(air(15), air(12), air(9), STONE);
+    CHECK(near(light.sky, 36.0f / 45.0f));
+    CHECK(near(light.ao, AO_CURVE[2]));
+}
+
+TEST_CASE(MeshLighting, OneOpaqueSide) {
+    VertexLight light = computeVertexLight(air(10), STONE, air(8), air(6));
+    CHECK(near(light.sky, 24.0f / 45.0f));
+    CHECK(near(light.ao, AO_CURVE[2]));
+
+    light = computeVertexLight(air(10), air(8), STONE, STONE);
+    CHECK(near(light.sky, 18.0f / 30.0f));
+    CHECK(near(light.ao, AO_CURVE[1]));
+}
+
+// Inside corner: the diagonal voxel can't be seen past two opaque sides,
+// so even a bright one must not leak into the vertex
+TEST_CASE(MeshLighting, BothSidesOpaqueUseFrontOnly) {
+    VertexLight light = computeVertexLight(air(4, packBlockLight(2, 0, 0)), STONE, STONE,
+        air(15, packBlockLight(15, 15, 15)));
+    CHECK(near(light.sky, 4.0f / 15.0f));
+    CHECK(near(light.red, 2.0f / 15.0f));
+    CHECK(near(light.green, 0.0f));
+    CHECK(near(light.blue, 0.0f));
+    CHECK(near(light.ao, AO_CURVE[0]));
+}
+
+// Emitters are opaque: their own emission is not a sample, only the light
+// they put into the transparent voxels around them
+TEST_CASE(MeshLighting, EmitterSamplesAreOpaque) {
+    Block emitter(BlockType::BLOCKOFPUREREDLIGHT);
+    emitter.blockLight = getLightEmission(BlockType::BLOCKOFPUREREDLIGHT);
+
+    VertexLight light = computeVertexLight(air(0, packBlockLight(14, 0, 0)), emitter, air(0), air(0));
+    CHECK(near(light.red, 14.0f / 45.0f));
+    CHECK(near(light.ao, AO_CURVE[2]));
+}
+
+TEST_CASE(MeshLighting, ChannelsAverageIndependently) {
+    VertexLight light = computeVertexLight(air(0, packBlockLight(15, 0, 0)), air(0, packBlockLight(0, 15, 0)),
+        air(0, packBlockLight(0, 0, 15)), air(0, packBlockLight(3, 6, 9)));
+    CHECK(near(light.red, 18.0f / 60.0f));
+    CHECK(near(light.green, 21.0f / 60.0f));
+    CHECK(near(light.blue, 24.0f / 60.0f));
+    CHECK(near(light.sky, 0.0f));
+
+    // Brightness takes the strongest of sky and the three channels
+    CHECK(near(vertexBrightness(light), 24.0f / 60.0f));
+}
+
+// =============================
+// Quad diagonal
+// =============================
+TEST_CASE(MeshLighting, QuadSplitsAlongBrighterDiagonal) {
+    VertexLight open = uniform(1.0f, AO_CURVE[3]);
+    VertexLight dark = uniform(1.0f, AO_CURVE[0]);
+
+    VertexLight even[4] = { open, open, open, open };
+    CHECK(!flipQuadDiagonal(even));
+
+    // A single occluded vertex on the default 0-2 diagonal flips it...
+    VertexLight darkFirst[4] = { dark, open, open, open };
+    CHECK(flipQuadDiagonal(darkFirst));
+    VertexLight darkThird[4] = { open, open, dark, open };
+    CHECK(flipQuadDiagonal(darkThird));
+
+    // ...one on the other diagonal keeps it
+    VertexLight darkSecond[4] = { open, dark, open, open };
+    CHECK(!flipQuadDiagonal(darkSecond));
+    VertexLight darkFourth[4] = { open, open, open, dark };
+    CHECK(!flipQuadDiagonal(darkFourth));
+}
+
+// =============================
+// Mesh corners
+// =============================
+// The top face of the block in the chunk's +x/+z corner has a vertex whose
+// side samples lie in the east and north chunks and whose corner sample
+// lies in the diagonal one (mesh positions are block centers, z negated)
+TEST_CASE(MeshLighting, CornerVertexSamplesNeighborChunks) {
+    const int Y = 100;
+
+    ChunkGrid diagonal;
+    diagonal.setBlock(15, Y, 15, BlockType::STONE);
+    diagonal.setBlock(16, Y + 1, 16, BlockType::STONE);
+
+    std::map<BlockType, ChunkMeshBuffers> buffers;
+    diagonal.center().buildMeshData(buffers);
+    const ChunkMeshBuffers& mesh = buffers[BlockType::STONE];
+    CHECK(near(upVertexAO(mesh, 15.5f, Y + 0.5f, -15.5f), AO_CURVE[2]));
+    CHECK(near(upVertexAO(mesh, 14.5f, Y + 0.5f, -14.5f), AO_CURVE[3]));
+    CHECK(near(upVertexAO(mesh, 15.5f, Y + 0.5f, -14.5f), AO_CURVE[3]));
+    CHECK(near(upVertexAO(mesh, 14.5f, Y + 0.5f, -15.5f), AO_CURVE[3]));
+
+    ChunkGrid sides;
+    sides.setBlock(15, Y, 15, BlockType::STONE);
+    sides.setBlock(16, Y + 1, 15, BlockType::STONE);
+    sides.setBlock(15, Y + 1, 16, BlockType::STONE);
+
+    buffers.clear();
+    sides.center().buildMeshData(buffers);
+    const ChunkMeshBuffers& occluded = buffers[BlockType::STONE];
+    CHECK(near(upVertexAO(occluded, 15.5f, Y + 0.5f, -15.5f), AO_CURVE[0]));
+    CHECK(near(upVertexAO(occluded, 14.5f, Y + 0.5f, -14.5f), AO_CURVE[3]));
+}
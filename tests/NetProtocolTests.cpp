@@ -0,0 +1,212 @@
+#include "TestHarness.h"
+#include "Server/ChunkServer.h"
+#include "Server/NetProtocol.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace NetProtocol;
+
+namespace {
+    // A chunk with fluids at every level, sky light and colored block light
+    std::unique_ptr<Chunk> makeChunk() {
+        auto chunk = std::make_unique<Chunk>(3, -2);
+        for (int y = 0; y < 60; y++) {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                    chunk->blocks[x][y][z] = Block(BlockType::STONE);
+                }
+            }
+        }
+        for (int x = 0; x < CHUNK_SIZE_X; x++) {
+            Block water(BlockType::WATER);
+            water.fluidLevel = static_cast<unsigned char>(x);  // Sources, flows and falling
+            water.skyLight = static_cast<unsigned char>(15 - x % 16);
+            water.blockLight = packBlockLight(15, static_cast<unsigned char>(x), 3);
+            chunk->blocks[x][60][4] = water;
+        }
+        for (int y = 61; y < CHUNK_SIZE_Y; y++) {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                    chunk->blocks[x][y][z].skyLight = 15;
+                }
+            }
+        }
+        return chunk;
+    }
+
+    // The ChunkData frame for chunk; runsOffset is where the runs start
+    std::vector<uint8_t> encode(const Chunk& chunk, size_t& runsOffset) {
+        std::vector<uint8_t> frame;
+        writeChunkData(frame, chunk);
+        runsOffset = FRAME_HEADER_BYTES + 4 + 4 + 4;
+        return frame;
+    }
+
+    bool decode(const std::vector<uint8_t>& frame, Chunk& out) {
+        Reader reader(frame.data() + FRAME_HEADER_BYTES, frame.size() - FRAME_HEADER_BYTES);
+        reader.i32();
+        reader.i32();
+        return readChunkRuns(reader, out);
+    }
+
+    // A ChunkServer on some free localhost port, or nullptr
+    std::unique_ptr<ChunkServer> startServer(const char* worldName, uint16_t& port) {
+        std::mt19937 random(std::random_device{}());
+        std::uniform_int_distribution<int> ports(40000, 59999);
+        for (int attempt = 0; attempt < 10; attempt++) {
+            ChunkServerConfig config;
+            config.port = static_cast<uint16_t>(ports(random));
+            config.workerCount = 1;
+            config.worldName = worldName;
+            auto server = std::make_unique<ChunkServer>(config);
+            if (server->start()) {
+                port = config.port;
+                return server;
+            }
+        }
+        return nullptr;
+    }
+
+    bool sendAll(Socket& socket, const std::vector<uint8_t>& data) {
+        size_t offset = 0;
+        while (offset < data.size()) {
+            long long sent = socket.send(data.data() + offset, data.size() - offset);
+            if (sent < 0) return false;
+            offset += static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    // Drains what the server sent; false once it has closed the connection
+    bool receiveAll(Socket& socket, std::vector<uint8_t>& inbox) {
+        uint8_t buffer[16 * 1024];
+        while (true) {
+            long long received = socket.receive(buffer, sizeof(buffer));
+            if (received < 0) return false;
+            if (received == 0) return true;
+            inbox.insert(inbox.end(), buffer, buffer + received);
+        }
+    }
+}
+
+TEST_CASE(NetProtocol, ChunkRoundTripKeepsFluidLevelsAndLight) {
+    std::unique_ptr<Chunk> chunk = makeChunk();
+    size_t runsOffset = 0;
+    std::vector<uint8_t> frame = encode(*chunk, runsOffset);
+    CHECK_EQ(completeFrameLength(frame.data(), frame.size()), static_cast<long long>(frame.size()));
+
+    auto decoded = std::make_unique<Chunk>(3, -2);
+    REQUIRE(decode(frame, *decoded));
+
+    int mismatches = 0;
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                const Block& a = chunk->blocks[x][y][z];
+                const Block& b = decoded->blocks[x][y][z];
+                if (a.type != b.type || a.fluidLevel != b.fluidLevel || a.skyLight != b.skyLight ||
+                    a.blockLight != b.blockLight) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+// Each run is type, fluid level, sky light, block light (u16), length (u16)
+TEST_CASE(NetProtocol, RejectsValuesThatDontFitABlock) {
+    std::unique_ptr<Chunk> chunk = makeChunk();
+    size_t runsOffset = 0;
+    const std::vector<uint8_t> frame = encode(*chunk, runsOffset);
+    auto decoded = std::make_unique<Chunk>(3, -2);
+
+    auto corrupt = [&](size_t field, uint8_t value) {
+        std::vector<uint8_t> copy = frame;
+        copy[runsOffset + field] = value;
+        return decode(copy, *decoded);
+    };
+
+    CHECK(corrupt(0, BLOCK_TYPE_COUNT) == false);
+    CHECK(corrupt(1, 16) == false);            // Fluid level
+    CHECK(corrupt(2, 16) == false);            // Sky light
+    CHECK(corrupt(2, 15) == true);
+    CHECK(corrupt(4, 0x10) == false);          // Block light high byte: top nibble set
+    CHECK(corrupt(4, 0x0F) == true);
+
+    // Truncated: fewer runs than the count promises
+    std::vector<uint8_t> truncated(frame.begin(), frame.end() - CHUNK_RUN_BYTES);
+    CHECK(!decode(truncated, *decoded));
+}
+
+// Position and SetBlock before Hello drop the connection; the server
+// keeps serving the client that did say Hello
+TEST_CASE(NetProtocol, ServerDropsClientsThatSkipHello) {
+    const char* worldName = "test_net_protocol";
+    std::filesystem::remove_all(std::string("SavedData/") + worldName);
+    REQUIRE(Socket::initializeNetworking());
+
+    {
+        uint16_t port = 0;
+        std::unique_ptr<ChunkServer> server = startServer(worldName, port);
+        REQUIRE(server != nullptr);
+
+        Socket moves, edits, greets;
+        REQUIRE(moves.connect("127.0.0.1", port));
+        REQUIRE(edits.connect("127.0.0.1", port));
+        REQUIRE(greets.connect("127.0.0.1", port));
+
+        std::vector<uint8_t> message;
+        size_t start = beginMessage(message, MessageType::Position);
+        writeF32(message, 8.0f);
+        writeF32(message, -8.0f);
+        endMessage(message, start);
+        REQUIRE(sendAll(moves, message));
+
+        message.clear();
+        start = beginMessage(message, MessageType::SetBlock);
+        writeI32(message, 0);
+        writeI32(message, 100);
+        writeI32(message, 0);
+        writeU8(message, static_cast<uint8_t>(BlockType::STONE));
+        endMessage(message, start);
+        REQUIRE(sendAll(edits, message));
+
+        message.clear();
+        start = beginMessage(message, MessageType::Hello);
+        writeU32(message, VERSION);
+        writeU8(message, 2);
+        endMessage(message, start);
+        REQUIRE(sendAll(greets, message));
+
+        std::vector<uint8_t> movesInbox, editsInbox, greetsInbox;
+        bool movesOpen = true, editsOpen = true, greetsOpen = true;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline && (movesOpen || editsOpen || greetsInbox.empty())) {
+            server->tick();
+            movesOpen = movesOpen && receiveAll(moves, movesInbox);
+            editsOpen = editsOpen && receiveAll(edits, editsInbox);
+            greetsOpen = greetsOpen && receiveAll(greets, greetsInbox);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        CHECK(!movesOpen);
+        CHECK(!editsOpen);
+        CHECK(movesInbox.empty());
+        CHECK(editsInbox.empty());
+        CHECK(greetsOpen);
+        CHECK_EQ(server->getClientCount(), 1u);
+
+        // The greeted client's first message is its Welcome
+        REQUIRE(completeFrameLength(greetsInbox.data(), greetsInbox.size()) > 0);
+        Reader reader(greetsInbox.data() + 4, greetsInbox.size() - 4);
+        CHECK(static_cast<MessageType>(reader.u8()) == MessageType::Welcome);
+        CHECK_EQ(reader.u32(), VERSION);
+    }
+
+    std::filesystem::remove_all(std::string("SavedData/") + worldName);
+}
@@ -0,0 +1,242 @@
+#include "TestHarness.h"
+#include "Entity/SpatialHash.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    // Render space: chunk (0, 0) spans x in [-0.5, 15.5) and z in (-15.5, 0.5];
+    // cells split it every 4 blocks from there
+
+    std::vector<uint32_t> sorted(std::vector<uint32_t> entities) {
+        std::sort(entities.begin(), entities.end());
+        return entities;
+    }
+
+    std::vector<uint32_t> scanRadius(const std::vector<Position>& positions, const Position& center, float radius) {
+        std::vector<uint32_t> out;
+        for (size_t i = 0; i < positions.size(); i++) {
+            float dx = positions[i].x - center.x;
+            float dy = positions[i].y - center.y;
+            float dz = positions[i].z - center.z;
+            if (dx * dx + dy * dy + dz * dz <= radius * radius) out.push_back(static_cast<uint32_t>(i));
+        }
+        return out;
+    }
+
+    std::vector<uint32_t> scanBox(const std::vector<Position>& positions, const CollisionBox& box) {
+        std::vector<uint32_t> out;
+        for (size_t i = 0; i < positions.size(); i++) {
+            const Position& p = positions[i];
+            if (p.x >= box.minX && p.x <= box.maxX && p.y >= box.minY && p.y <= box.maxY
+                && p.z >= box.minZ && p.z <= box.maxZ) {
+                out.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        return out;
+    }
+
+    std::vector<std::pair<int, int>> occupiedChunks(const SpatialHash& hash) {
+        std::vector<std::pair<int, int>> chunks;
+        hash.getOccupiedChunks(chunks);
+        std::sort(chunks.begin(), chunks.end());
+        return chunks;
+    }
+
+    // Both query kinds against a scan over every position
+    bool matchesScan(const SpatialHash& hash, const std::vector<Position>& positions, const Position& center) {
+        std::vector<uint32_t> found;
+        for (float radius : { 0.5f, 3.0f, 8.0f, 20.0f }) {
+            hash.queryRadius(center.x, center.y, center.z, radius, found);
+            if (sorted(found) != scanRadius(positions, center, radius)) return false;
+        }
+
+        CollisionBox player = { center.x - 0.3f, center.y, center.z - 0.3f, center.x + 0.3f, center.y + 1.8f, center.z + 0.3f };
+        CollisionBox wide = { center.x - 9.0f, center.y - 4.0f, center.z - 5.0f, center.x + 5.0f, center.y + 4.0f, center.z + 9.0f };
+        for (const CollisionBox& box : { player, wide }) {
+            hash.queryBox(box, found);
+            if (sorted(found) != scanBox(positions, box)) return false;
+        }
+        return true;
+    }
+}
+
+// Random points around the origin, so queries straddle cells and chunks on
+// both sides of zero, before and after everything moves
+TEST_CASE(SpatialHash, QueriesMatchLinearScan) {
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<float> horizontal(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> height(60.0f, 70.0f);
+    std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+
+    std::vector<Position> positions(2000);
+    SpatialHash hash;
+    for (size_t i = 0; i < positions.size(); i++) {
+        positions[i] = { horizontal(random), height(random), horizontal(random) };
+        hash.update(static_cast<uint32_t>(i), positions[i].x, positions[i].y, positions[i].z);
+    }
+    CHECK_EQ(hash.size(), positions.size());
+
+    std::uniform_int_distribution<size_t> pick(0, positions.size() - 1);
+    for (int round = 0; round < 2; round++) {
+        size_t mismatches = 0;
+        for (int i = 0; i < 300; i++) {
+            if (!matchesScan(hash, positions, positions[pick(random)])) mismatches++;
+            if (!matchesScan(hash, positions, { horizontal(random), height(random), horizontal(random) })) mismatches++;
+        }
+        CHECK_EQ(mismatches, 0u);
+
+        for (size_t i = 0; i < positions.size(); i++) {
+            positions[i].x += step(random);
+            positions[i].z += step(random);
+            hash.update(static_cast<uint32_t>(i), positions[i].x, positions[i].y, positions[i].z);
+        }
+    }
+    CHECK_EQ(hash.size(), positions.size());
+}
+
+// Points a hair either side of cell and chunk borders, at positive and
+// negative coordinates, are all found by a query spanning the border
+TEST_CASE(SpatialHash, QueriesAcrossBorders) {
+    const float e = 0.01f;
+    // x = 3.5 is a cell border, x = 15.5 and -0.5 chunk borders; likewise
+    // z = -3.5 (cell), z = 0.5 and -15.5 (chunk)
+    const float borders[] = { 3.5f, 15.5f, -0.5f, -16.5f };
+
+    for (float border : borders) {
+        std::vector<Position> positions = {
+            { border - e, 64.0f, -8.0f }, { border + e, 64.0f, -8.0f },  // Across x
+            { 8.0f, 64.0f, -border - e }, { 8.0f, 64.0f, -border + e },  // Across z
+            { border - e, 64.0f, -border - e }, { border + e, 64.0f, -border + e },  // Diagonal
+        };
+        SpatialHash hash;
+        for (size_t i = 0; i < positions.size(); i++) {
+            hash.update(static_cast<uint32_t>(i), positions[i].x, positions[i].y, positions[i].z);
+        }
+
+        std::vector<uint32_t> found;
+        hash.queryRadius(border, 64.0f, -8.0f, 2.0f * e, found);
+        CHECK(sorted(found) == std::vector<uint32_t>({ 0, 1 }));
+        hash.queryRadius(8.0f, 64.0f, -border, 2.0f * e, found);
+        CHECK(sorted(found) == std::vector<uint32_t>({ 2, 3 }));
+        hash.queryRadius(border, 64.0f, -border, 2.0f * e, found);
+        CHECK(sorted(found) == std::vector<uint32_t>({ 4, 5 }));
+
+        // Inclusive: a box whose faces sit exactly on the points
+        hash.queryBox({ border - e, 64.0f, -8.0f, border + e, 64.0f, -8.0f }, found);
+        CHECK(sorted(found) == std::vector<uint32_t>({ 0, 1 }));
+        hash.queryBox({ border - e, 64.0f, -border - e, border + e, 64.0f, -border + e }, found);
+        CHECK(sorted(found) == std::vector<uint32_t>({ 4, 5 }));
+
+        // Just short of the far side only finds the near one
+        hash.queryBox({ border - 2.0f * e, 63.0f, -8.5f, border, 65.0f, -7.5f }, found);
+        CHECK(sorted(found) == std::vector<uint32_t>({ 0 }));
+
+        for (const Position& center : positions) CHECK(matchesScan(hash, positions, center));
+    }
+}
+
+TEST_CASE(SpatialHash, ChunksOfNegativeCoordinates) {
+    SpatialHash hash;
+    hash.update(0, 0.0f, 64.0f, 0.0f);       // Chunk (0, 0)
+    hash.update(1, -0.51f, 64.0f, 0.0f);     // Chunk (-1, 0)
+    hash.update(2, 0.0f, 64.0f, 0.51f);      // Chunk (0, -1)
+    hash.update(3, -16.51f, 64.0f, 16.51f);  // Chunk (-2, -2)
+    hash.update(4, 15.49f, 64.0f, -15.49f);  // Chunk (0, 0), far corner
+
+    std::vector<uint32_t> found;
+    hash.queryChunk(0, 0, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 0, 4 }));
+    hash.queryChunk(-1, 0, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 1 }));
+    hash.queryChunk(0, -1, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 2 }));
+    hash.queryChunk(-2, -2, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 3 }));
+    hash.queryChunk(-1, -1, found);
+    CHECK(found.empty());
+
+    std::vector<std::pair<int, int>> expected = { { -2, -2 }, { -1, 0 }, { 0, -1 }, { 0, 0 } };
+    CHECK(occupiedChunks(hash) == expected);
+}
+
+// Moving an entity to another chunk takes it out of the old one; the old
+// chunk stops being reported once nothing is left in it
+TEST_CASE(SpatialHash, UpdateMovesBetweenChunks) {
+    SpatialHash hash;
+    hash.update(0, 2.0f, 64.0f, -2.0f);
+    hash.update(1, 5.0f, 64.0f, -2.0f);
+    size_t cells = hash.getCellCount();
+
+    // Within the cell: no change in structure
+    hash.update(0, 2.5f, 65.0f, -2.5f);
+    CHECK_EQ(hash.getCellCount(), cells);
+
+    std::vector<uint32_t> found;
+    hash.update(0, 18.0f, 64.0f, -2.0f);
+    CHECK_EQ(hash.size(), 2u);
+    hash.queryChunk(0, 0, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 1 }));
+    hash.queryChunk(1, 0, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 0 }));
+    hash.queryRadius(2.5f, 65.0f, -2.5f, 1.0f, found);
+    CHECK(found.empty());
+    hash.queryRadius(18.0f, 64.0f, -2.0f, 0.0f, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 0 }));
+
+    hash.update(1, -3.0f, 64.0f, 20.0f);
+    hash.queryChunk(0, 0, found);
+    CHECK(found.empty());
+    hash.queryChunk(-1, -2, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 1 }));
+
+    std::vector<std::pair<int, int>> expected = { { -1, -2 }, { 1, 0 } };
+    CHECK(occupiedChunks(hash) == expected);
+    CHECK_EQ(hash.getCellCount(), 2u);
+}
+
+TEST_CASE(SpatialHash, RemoveEmptiesCellsAndChunks) {
+    SpatialHash hash;
+    hash.update(0, 1.0f, 64.0f, -1.0f);
+    hash.update(1, 1.5f, 64.0f, -1.5f);  // Same cell
+    hash.update(2, 9.0f, 64.0f, -9.0f);  // Same chunk, other cell
+    hash.update(7, -20.0f, 64.0f, 0.0f);
+
+    hash.remove(1);
+    CHECK(!hash.contains(1));
+    CHECK(hash.contains(0));
+    CHECK_EQ(hash.size(), 3u);
+
+    // The swap into the removed slot keeps the moved point findable
+    std::vector<uint32_t> found;
+    hash.queryRadius(1.0f, 64.0f, -1.0f, 0.1f, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 0 }));
+    hash.update(0, 1.2f, 64.0f, -1.2f);
+    hash.queryChunk(0, 0, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 0, 2 }));
+
+    hash.remove(0);
+    hash.remove(2);
+    hash.remove(2);  // Already gone
+    hash.remove(99);  // Never registered
+    CHECK_EQ(hash.size(), 1u);
+    hash.queryChunk(0, 0, found);
+    CHECK(found.empty());
+    hash.queryBox({ -1.0f, 0.0f, -16.0f, 16.0f, 256.0f, 1.0f }, found);
+    CHECK(found.empty());
+
+    std::vector<std::pair<int, int>> expected = { { -2, 0 } };
+    CHECK(occupiedChunks(hash) == expected);
+    CHECK_EQ(hash.getCellCount(), 1u);
+
+    // Re-registering after removal counts it again
+    hash.update(2, 9.0f, 64.0f, -9.0f);
+    CHECK_EQ(hash.size(), 2u);
+    hash.queryChunk(0, 0, found);
+    CHECK(sorted(found) == std::vector<uint32_t>({ 2 }));
+}
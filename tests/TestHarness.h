@@ -0,0 +1,67 @@
+#ifndef TEST_HARNESS_H
+#define TEST_HARNESS_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal self-registering tests for world_tests.
+//
+//     TEST_CASE(Suite, Name) { CHECK(...); CHECK_EQ(a, b); REQUIRE(...); }
+//
+// CHECK records a failure and carries on; REQUIRE also ends the test.
+// world_tests [Suite...] runs the given suites (all of them without
+// arguments); CMake registers one ctest entry per suite.
+namespace TestHarness {
+    using TestFunction = void (*)();
+
+    struct TestCase {
+        const char* suite;
+        const char* name;
+        TestFunction function;
+    };
+
+    std::vector<TestCase>& registry();
+
+    struct Registrar {
+        Registrar(const char* suite, const char* name, TestFunction function) {
+            registry().push_back({ suite, name, function });
+        }
+    };
+
+    // Thrown by REQUIRE; caught by the runner
+    struct RequireFailed {};
+
+    void reportFailure(const char* file, int line, const std::string& message);
+
+    template <typename A, typename B>
+    void checkEqual(const char* file, int line, const char* expressionA, const char* expressionB, const A& a, const B& b) {
+        if (a == b) return;
+
+        std::ostringstream out;
+        out << expressionA << " == " << expressionB << " (" << a << " vs " << b << ")";
+        reportFailure(file, line, out.str());
+    }
+}
+
+#define TEST_CASE(suite, name) \
+    static void suite##_##name(); \
+    static TestHarness::Registrar suite##_##name##_registrar(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) TestHarness::reportFailure(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define CHECK_EQ(a, b) TestHarness::checkEqual(__FILE__, __LINE__, #a, #b, (a), (b))
+
+#define REQUIRE(condition) \
+    do { \
+        if (!(condition)) { \
+            TestHarness::reportFailure(__FILE__, __LINE__, #condition); \
+            throw TestHarness::RequireFailed{}; \
+        } \
+    } while (0)
+
+#endif
@@ -0,0 +1,63 @@
+// Runner for world_tests: headless checks of the world simulation.
+//
+// Usage: world_tests [Suite...]
+
+#include "TestHarness.h"
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <set>
+#include <string>
+
+namespace {
+    int currentFailures = 0;
+}
+
+std::vector<TestHarness::TestCase>& TestHarness::registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+void TestHarness::reportFailure(const char* file, int line, const std::string& message) {
+    std::cout << "    " << file << ":" << line << ": " << message << "\n";
+    currentFailures++;
+}
+
+int main(int argc, char** argv) {
+    std::set<std::string> suites(argv + 1, argv + argc);
+
+    int run = 0;
+    int failed = 0;
+    for (const TestHarness::TestCase& test : TestHarness::registry()) {
+        if (!suites.empty() && !suites.count(test.suite)) continue;
+
+        std::cout << "[ RUN  ] " << test.suite << "." << test.name << std::endl;
+        currentFailures = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        try {
+            test.function();
+        }
+        catch (const TestHarness::RequireFailed&) {
+            // Already reported
+        }
+        catch (const std::exception& e) {
+            TestHarness::reportFailure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (currentFailures ? "[ FAIL ] " : "[  OK  ] ") << test.suite << "." << test.name
+            << " (" << static_cast<long long>(ms) << " ms)" << std::endl;
+
+        run++;
+        if (currentFailures) failed++;
+    }
+
+    if (run == 0) {
+        std::cout << "No tests matched\n";
+        return 1;
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed\n";
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+#include "TestWorld.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace {
+    // Light of one voxel, as selected by the count* functions
+    using LightField = unsigned int (*)(const Block& block);
+
+    unsigned int skyLightOf(const Block& block) { return block.skyLight; }
+    unsigned int blockLightOf(const Block& block) { return block.blockLight; }
+
+    size_t countMismatches(const std::unordered_map<long long, Chunk*>& chunks,
+        const TestWorld::ChunkMap& reference, LightField field, const char* label) {
+        size_t mismatches = 0;
+        for (const auto& [key, chunk] : chunks) {
+            auto it = reference.find(key);
+            if (it == reference.end()) continue;
+            const Chunk& expected = *it->second;
+
+            for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+                    for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                        unsigned int actual = field(chunk->blocks[x][y][z]);
+                        unsigned int wanted = field(expected.blocks[x][y][z]);
+                        if (actual == wanted) continue;
+
+                        if (mismatches < 5) {
+                            std::cout << "    " << label << " at (" << chunk->chunkX * CHUNK_SIZE_X + x << ", " << y
+                                << ", " << chunk->chunkZ * CHUNK_SIZE_Z + z << "): " << actual
+                                << ", recomputed " << wanted << "\n";
+                        }
+                        mismatches++;
+                    }
+                }
+            }
+        }
+        return mismatches;
+    }
+}
+
+TestWorld::TestWorld(const std::string& name, unsigned int workerCount)
+    : name(name) {
+    std::filesystem::remove_all("SavedData/" + name);
+    chunkPipeline = std::make_unique<ChunkPipeline>(name, 64 * 1024 * 1024, workerCount);
+}
+
+TestWorld::~TestWorld() {
+    chunkPipeline.reset();  // Writes the save on the way out
+    std::filesystem::remove_all("SavedData/" + name);
+}
+
+void TestWorld::load(int radius, unsigned int shuffleSeed) {
+    for (int cx = -radius; cx <= radius; cx++) {
+        for (int cz = -radius; cz <= radius; cz++) {
+            chunkPipeline->request(cx, cz);
+        }
+    }
+    chunkPipeline->submitRequests([](int cx, int cz) { return static_cast<float>(cx * cx + cz * cz); });
+
+    std::unordered_set<Chunk*> relit;
+    std::vector<Chunk*> ready;
+    std::vector<Chunk*> arrived;
+    while (chunkPipeline->getQueuedCount() > 0) {
+        Chunk* chunk = chunkPipeline->popReady();
+        if (!chunk) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        if (shuffleSeed != 0) {
+            arrived.push_back(chunk);
+            continue;
+        }
+        chunkPipeline->insert(chunk);
+        chunkPipeline->exchangeBorderLight(chunk, relit, ready);
+    }
+
+    std::shuffle(arrived.begin(), arrived.end(), std::mt19937(shuffleSeed));
+    for (Chunk* chunk : arrived) {
+        chunkPipeline->insert(chunk);
+        chunkPipeline->exchangeBorderLight(chunk, relit, ready);
+    }
+}
+
+void TestWorld::unload(int chunkX, int chunkZ) {
+    if (Chunk* chunk = chunkPipeline->findChunk(chunkX, chunkZ)) chunkPipeline->unload(chunk);
+}
+
+int TestWorld::surfaceHeight(int worldX, int worldZ) const {
+    for (int y = CHUNK_SIZE_Y - 1; y > 0; y--) {
+        std::optional<Block> block = chunkPipeline->getBlock(worldX, y, worldZ);
+        if (block && !block->isAir()) return y;
+    }
+    return 0;
+}
+
+TestWorld::ChunkMap TestWorld::copy() const {
+    ChunkMap copies;
+    for (const auto& [key, chunk] : chunkPipeline->getChunks()) {
+        auto copy = std::make_unique<Chunk>(chunk->chunkX, chunk->chunkZ);
+        std::memcpy(copy->blocks, chunk->blocks, sizeof(copy->blocks));
+        copy->recalculateHeightMap();
+        copy->state = chunk->state;
+        copies[key] = std::move(copy);
+    }
+    return copies;
+}
+
+TestWorld::ChunkMap TestWorld::relitCopy() const {
+    ChunkMap copies = copy();
+    for (auto& [_, chunk] : copies) {
+        chunk->calculateSkyLight(15);
+        chunk->calculateBlockLight();
+    }
+
+    LightEngine lightEngine([&copies](int cx, int cz) -> Chunk* {
+        auto it = copies.find(ChunkPipeline::makeKey(cx, cz));
+        return it != copies.end() ? it->second.get() : nullptr;
+        });
+
+    std::unordered_set<Chunk*> relit;
+    for (const auto& [key, chunk] : chunkPipeline->getChunks()) {
+        if (chunk->state == ChunkState::NeighborsReady) {
+            lightEngine.propagateChunkBorders(copies[key].get(), relit);
+        }
+    }
+    return copies;
+}
+
+size_t TestWorld::countSkyLightMismatches(const ChunkMap& reference) const {
+    return countMismatches(chunkPipeline->getChunks(), reference, skyLightOf, "sky light");
+}
+
+size_t TestWorld::countBlockLightMismatches(const ChunkMap& reference) const {
+    return countMismatches(chunkPipeline->getChunks(), reference, blockLightOf, "block light");
+}
+
+// =============================
+// TestClientWorld
+// =============================
+TestClientWorld::TestClientWorld(const std::string& name, int renderDistance)
+    : name(name) {
+    std::filesystem::remove_all("SavedData/" + name);
+    manager = std::make_unique<ChunkManager>(renderDistance, name);
+
+    // Settled once nothing is left in flight and the count stops changing
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    size_t lastLoaded = 0;
+    int stableFrames = 0;
+    while (!loaded && std::chrono::steady_clock::now() < deadline) {
+        manager->update(0.0f, 0.0f);
+        std::vector<ChunkMeshUpdate> discarded;
+        manager->takeMeshUpdates(discarded);
+
+        const GenerationStats& stats = manager->getGenerationStats();
+        size_t count = manager->getLoadedChunks().size();
+        bool settled = count > 0 && count == lastLoaded && stats.completed + stats.cancelled >= stats.requested;
+        stableFrames = settled ? stableFrames + 1 : 0;
+        loaded = stableFrames >= 10;
+
+        lastLoaded = count;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+TestClientWorld::~TestClientWorld() {
+    manager.reset();
+    std::filesystem::remove_all("SavedData/" + name);
+}
+
+void TestClientWorld::setBlock(int worldX, int worldY, int worldZ, BlockType type) {
+    manager->setBlockAt(worldX, worldY, worldZ, type);
+}
+
+void TestClientWorld::clearAbove(int minX, int minY, int minZ, int maxX, int maxZ) {
+    for (int x = minX; x <= maxX; x++) {
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int y = minY; y < CHUNK_SIZE_Y; y++) {
+                std::optional<Block> block = manager->getBlockAt(x, y, z);
+                if (block && !block->isAir()) manager->setBlockAt(x, y, z, BlockType::AIR);
+            }
+        }
+    }
+}
+
+bool TestClientWorld::moveTo(float x, float z, const std::function<bool()>& done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (std::chrono::steady_clock::now() < deadline) {
+        manager->update(x, z);
+        std::vector<ChunkMeshUpdate> discarded;
+        manager->takeMeshUpdates(discarded);
+        if (done()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return false;
+}
@@ -0,0 +1,87 @@
+#ifndef TEST_WORLD_H
+#define TEST_WORLD_H
+
+#include "ChunkManager.h"
+#include "ChunkPipeline.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Real terrain for tests: a ChunkPipeline over a world whose save
+// directory is removed before and after, so edits never leak between runs.
+// load() brings in a square of chunks around the origin, linked and, where
+// a chunk's whole 3x3 neighborhood is in, NeighborsReady.
+class TestWorld {
+public:
+    using ChunkMap = std::unordered_map<long long, std::unique_ptr<Chunk>>;
+
+    explicit TestWorld(const std::string& name, unsigned int workerCount = 2);
+    ~TestWorld();
+
+    TestWorld(const TestWorld&) = delete;
+    TestWorld& operator=(const TestWorld&) = delete;
+
+    ChunkPipeline& pipeline() { return *chunkPipeline; }
+
+    // Requests every chunk in the square (already loaded ones are
+    // skipped) and integrates them as they arrive, in whatever order the
+    // workers finish. With a nonzero shuffleSeed it waits for all of them
+    // and integrates them in a random order instead.
+    void load(int radius, unsigned int shuffleSeed = 0);
+
+    // Unloads a loaded chunk (into the pipeline's cache)
+    void unload(int chunkX, int chunkZ);
+
+    // y of the highest non-air block in the column (0 when there is none)
+    int surfaceHeight(int worldX, int worldZ) const;
+
+    // Copies of every loaded chunk as they are
+    ChunkMap copy() const;
+
+    // Copies of every loaded chunk relit from scratch: their own sky and
+    // block light recomputed, then border light exchanged for the chunks
+    // that are NeighborsReady in the live world, as the pipeline does
+    ChunkMap relitCopy() const;
+
+    // Number of voxels whose sky (or block) light differs from the copy;
+    // the first few are printed
+    size_t countSkyLightMismatches(const ChunkMap& reference) const;
+    size_t countBlockLightMismatches(const ChunkMap& reference) const;
+
+private:
+    std::string name;
+    std::unique_ptr<ChunkPipeline> chunkPipeline;
+};
+
+// The client side of the same: a ChunkManager standing at the origin with
+// everything within its render distance loaded, for code that queries it
+// (collision, player physics). Test fixtures are built high in the sky,
+// above any terrain, with clearAbove.
+class TestClientWorld {
+public:
+    TestClientWorld(const std::string& name, int renderDistance);
+    ~TestClientWorld();
+
+    TestClientWorld(const TestClientWorld&) = delete;
+    TestClientWorld& operator=(const TestClientWorld&) = delete;
+
+    ChunkManager& chunkManager() { return *manager; }
+    bool isLoaded() const { return loaded; }
+
+    void setBlock(int worldX, int worldY, int worldZ, BlockType type);
+
+    // Air in [minX, maxX] x [minY, top of the world) x [minZ, maxZ]
+    void clearAbove(int minX, int minY, int minZ, int maxX, int maxZ);
+
+    // Walks the viewer to render-space (x, z), running update() until
+    // done() holds (false after 30 s), e.g. until a chunk unloads
+    bool moveTo(float x, float z, const std::function<bool()>& done);
+
+private:
+    std::string name;
+    std::unique_ptr<ChunkManager> manager;
+    bool loaded = false;
+};
+
+#endif